@@ -24,6 +24,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -41,6 +42,55 @@
 
 #if defined(CONFIG_BUILD_KERNEL) && defined(CONFIG_ARCH_VMA_MAPPING)
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* With the 4KB granule, 16 last level entries that map 64KB of physically
+ * contiguous and aligned memory may set the contiguous hint, and the TLB
+ * then caches them as one entry.
+ */
+
+#define SHM_CONT_NPAGES 16
+#define SHM_CONT_MASK   (SHM_CONT_NPAGES * MM_PGSIZE - 1)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_PGALLOC_LARGEPAGE
+/****************************************************************************
+ * Name: shm_contiguous
+ *
+ * Description:
+ *   Return true if the next SHM_CONT_NPAGES pages may be mapped with the
+ *   contiguous hint at vaddr.
+ *
+ ****************************************************************************/
+
+static bool shm_contiguous(uintptr_t *pages, unsigned int npages,
+                           uintptr_t vaddr)
+{
+  unsigned int i;
+
+  if (npages < SHM_CONT_NPAGES || (vaddr & SHM_CONT_MASK) != 0 ||
+      (pages[0] & SHM_CONT_MASK) != 0)
+    {
+      return false;
+    }
+
+  for (i = 1; i < SHM_CONT_NPAGES; i++)
+    {
+      if (pages[i] != pages[0] + i * MM_PGSIZE)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -76,9 +126,38 @@ int up_shmat(uintptr_t *pages, unsigned int npages, uintptr_t vaddr)
   DEBUGASSERT(vaddr >= CONFIG_ARCH_SHM_VBASE && vaddr < ARCH_SHM_VEND);
   DEBUGASSERT(MM_ISALIGNED(vaddr));
 
+#ifdef CONFIG_MM_PGALLOC_LARGEPAGE
+  /* Map the contiguous runs of pages with the contiguous hint */
+
+  while (npages > 0)
+    {
+      unsigned int nmap = 1;
+      uint64_t prot = MMU_UDATA_FLAGS;
+      int ret;
+
+      if (shm_contiguous(pages, npages, vaddr))
+        {
+          nmap = SHM_CONT_NPAGES;
+          prot |= PTE_BLOCK_DESC_CONT;
+        }
+
+      ret = arm64_map_pages(addrenv, pages, nmap, vaddr, prot);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      pages  += nmap;
+      npages -= nmap;
+      vaddr  += nmap * MM_PGSIZE;
+    }
+
+  return OK;
+#else
   /* Let arm64_map_pages do the work */
 
   return arm64_map_pages(addrenv, pages, npages, vaddr, MMU_UDATA_FLAGS);
+#endif
 }
 
 /****************************************************************************
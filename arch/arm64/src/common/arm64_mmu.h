@@ -115,6 +115,7 @@
 #define PTE_BLOCK_DESC_AF           (1ULL << 10) /* A-flag */
 #define PTE_BLOCK_DESC_NG           (1ULL << 11) /* Non-global */
 #define PTE_BLOCK_DESC_DIRTY        (1ULL << 51) /* D-flag */
+#define PTE_BLOCK_DESC_CONT         (1ULL << 52) /* Contiguous hint */
 #define PTE_BLOCK_DESC_PXN          (1ULL << 53) /* Kernel execute never */
 #define PTE_BLOCK_DESC_UXN          (1ULL << 54) /* User execute never */
 
@@ -610,6 +610,32 @@ void mm_memdump(struct mm_heap_s *heap, const struct mm_memdump_s *dump)
 {
 }
 
+/****************************************************************************
+ * Name: mm_fraginfo
+ *
+ * Description:
+ *   The host heap can't be walked, so the report is empty.
+ *
+ ****************************************************************************/
+
+void mm_fraginfo(struct mm_heap_s *heap, struct mm_fraginfo_s *info)
+{
+  memset(info->nfree, 0, sizeof(info->nfree));
+  memset(info->free, 0, sizeof(info->free));
+  memset(info->nused, 0, sizeof(info->nused));
+  memset(info->used, 0, sizeof(info->used));
+  memset(info->mxfree, 0, sizeof(info->mxfree));
+  info->nregions = 0;
+#if CONFIG_MM_BACKTRACE > 0
+  if (info->nsites > 0)
+    {
+      memset(info->sites, 0, info->nsites * sizeof(struct mm_fragsite_s));
+    }
+
+  info->nlost = 0;
+#endif
+}
+
 #ifdef CONFIG_DEBUG_MM
 
 /****************************************************************************
@@ -37,6 +37,7 @@
 #include <assert.h>
 #include <debug.h>
 
+#include <nuttx/fs/aio.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/drivers/drivers.h>
@@ -65,6 +66,10 @@ static int     bch_poll(FAR struct file *filep, FAR struct pollfd *fds,
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
 static int     bch_unlink(FAR struct inode *inode);
 #endif
+#ifdef CONFIG_FS_AIO
+static int     bch_aio(FAR struct file *filep,
+                       FAR struct aio_request_s *req);
+#endif
 
 /****************************************************************************
  * Public Data
@@ -84,6 +89,9 @@ const struct file_operations g_bch_fops =
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   , bch_unlink /* unlink */
 #endif
+#ifdef CONFIG_FS_AIO
+  , bch_aio    /* aio */
+#endif
 };
 
 /****************************************************************************
@@ -463,6 +471,70 @@ static int bch_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
   return ret;
 }
 
+/****************************************************************************
+ * Name: bch_aio
+ *
+ * Description:
+ *   Asynchronous transfers are completed inline when the block driver is
+ *   memory mapped (a RAM disk), there is nothing to wait for.  Other
+ *   drivers are left to the asynchronous I/O worker.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_AIO
+static int bch_aio(FAR struct file *filep, FAR struct aio_request_s *req)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct bchlib_s *bch;
+  FAR struct inode *bchinode;
+  FAR void *xipbase;
+  ssize_t nbytes;
+
+  DEBUGASSERT(inode->i_private);
+  bch      = inode->i_private;
+  bchinode = bch->inode;
+
+  if (bchinode->u.i_bops->ioctl == NULL ||
+      bchinode->u.i_bops->ioctl(bchinode, BIOC_XIPBASE,
+                                (unsigned long)(uintptr_t)&xipbase) < 0)
+    {
+      return -ENOTTY;
+    }
+
+  DEBUGASSERT(req->offset >= 0);
+
+  if (req->offset < 0)
+    {
+      nbytes = -EINVAL;
+    }
+  else if (req->opcode == AIO_OP_WRITE && bch->readonly)
+    {
+      nbytes = -EACCES;
+    }
+  else
+    {
+      nbytes = nxmutex_lock(&bch->lock);
+      if (nbytes >= 0)
+        {
+          if (req->opcode == AIO_OP_READ)
+            {
+              nbytes = bchlib_read(bch, req->buf, req->offset, req->nbytes);
+            }
+          else
+            {
+              nbytes = bchlib_write(bch, req->buf, req->offset,
+                                    req->nbytes);
+            }
+
+          nxmutex_unlock(&bch->lock);
+        }
+    }
+
+  aio_done(req, nbytes);
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: bch_unlink
  *
@@ -0,0 +1,761 @@
+/****************************************************************************
+ * drivers/misc/zram.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/ioctl.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+#include <lzf.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/lib/math32.h>
+#include <nuttx/mutex.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/mm/mempool.h>
+#include <nuttx/drivers/zram.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Room left in front of the compression buffers for the LZF header */
+
+#define ZRAM_HDRSIZE           ALIGN_UP(LZF_MAX_HDR_SIZE, sizeof(uintptr_t))
+
+/* Values for zs_flags */
+
+#define ZRAM_SLOT_SAME         (1 << 0) /* Bit 0: 1=zs_data is the fill word */
+#define ZRAM_SLOT_HUGE         (1 << 1) /* Bit 1: 1=Stored uncompressed */
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct zram_slot_s
+{
+  FAR void *zs_data;            /* Stored sector, or the fill word */
+  uint16_t zs_len;              /* Length of the stored sector */
+  uint8_t zs_flags;             /* See ZRAM_SLOT_* definitions */
+};
+
+struct zram_struct_s
+{
+  uint32_t zd_nsectors;         /* Number of sectors on device */
+  uint16_t zd_sectsize;         /* The size of one sector */
+  uint16_t zd_maxclen;          /* Largest length stored compressed */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  uint8_t zd_crefs;             /* Open reference count */
+  bool zd_unlinked;             /* The driver has been unlinked */
+#endif
+  mutex_t zd_lock;              /* Protects the table and the buffers */
+  char zd_name[8];              /* Name of the store, zramN */
+  FAR struct zram_slot_s *zd_table;       /* One entry per sector */
+  FAR struct mempool_multiple_s *zd_pool; /* Store of the sectors */
+  FAR uint8_t *zd_in;           /* Sector being compressed */
+  FAR uint8_t *zd_out;          /* Compressed sector */
+  lzf_state_t zd_state;         /* LZF hash table */
+
+  /* Statistics */
+
+  uint32_t zd_ncompressed;      /* Sectors stored compressed */
+  uint32_t zd_nhuge;            /* Sectors stored uncompressed */
+  uint32_t zd_nsame;            /* Same-filled sectors */
+  size_t zd_compsize;           /* Bytes of data in the store */
+  uint32_t zd_nreads;           /* Sectors read */
+  uint32_t zd_nwrites;          /* Sectors written */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void    zram_destroy(FAR struct zram_struct_s *dev);
+
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+static int     zram_open(FAR struct inode *inode);
+static int     zram_close(FAR struct inode *inode);
+#endif
+
+static ssize_t zram_read(FAR struct inode *inode, FAR unsigned char *buffer,
+                         blkcnt_t start_sector, unsigned int nsectors);
+static ssize_t zram_write(FAR struct inode *inode,
+                          FAR const unsigned char *buffer,
+                          blkcnt_t start_sector, unsigned int nsectors);
+static int     zram_geometry(FAR struct inode *inode,
+                             FAR struct geometry *geometry);
+static int     zram_ioctl(FAR struct inode *inode, int cmd,
+                          unsigned long arg);
+
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+static int     zram_unlink(FAR struct inode *inode);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct block_operations g_zram_bops =
+{
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  zram_open,     /* open     */
+  zram_close,    /* close    */
+#else
+  NULL,          /* open     */
+  NULL,          /* close    */
+#endif
+  zram_read,     /* read     */
+  zram_write,    /* write    */
+  zram_geometry, /* geometry */
+  zram_ioctl     /* ioctl    */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , zram_unlink  /* unlink   */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static FAR void *zram_pool_alloc(FAR void *arg, size_t alignment,
+                                 size_t size)
+{
+  return kmm_memalign(alignment, size);
+}
+
+static size_t zram_pool_alloc_size(FAR void *arg, FAR void *addr)
+{
+  return kmm_malloc_size(addr);
+}
+
+static void zram_pool_free(FAR void *arg, FAR void *addr)
+{
+  kmm_free(addr);
+}
+
+/****************************************************************************
+ * Name: zram_same
+ *
+ * Description:
+ *   Return true if the sector is one word repeated, and that word in fill.
+ *
+ ****************************************************************************/
+
+static bool zram_same(FAR const uintptr_t *words, size_t nwords,
+                      FAR uintptr_t *fill)
+{
+  size_t i;
+
+  for (i = 1; i < nwords; i++)
+    {
+      if (words[i] != words[0])
+        {
+          return false;
+        }
+    }
+
+  *fill = words[0];
+  return true;
+}
+
+/****************************************************************************
+ * Name: zram_release
+ *
+ * Description:
+ *   Release whatever a sector holds in the store.
+ *
+ ****************************************************************************/
+
+static void zram_release(FAR struct zram_struct_s *dev,
+                         FAR struct zram_slot_s *slot)
+{
+  if (slot->zs_flags & ZRAM_SLOT_SAME)
+    {
+      dev->zd_nsame--;
+    }
+  else if (slot->zs_data != NULL)
+    {
+      mempool_multiple_free(dev->zd_pool, slot->zs_data);
+      dev->zd_compsize -= slot->zs_len;
+      if (slot->zs_flags & ZRAM_SLOT_HUGE)
+        {
+          dev->zd_nhuge--;
+        }
+      else
+        {
+          dev->zd_ncompressed--;
+        }
+    }
+
+  slot->zs_data  = NULL;
+  slot->zs_len   = 0;
+  slot->zs_flags = 0;
+}
+
+/****************************************************************************
+ * Name: zram_readsector
+ ****************************************************************************/
+
+static int zram_readsector(FAR struct zram_struct_s *dev,
+                           FAR struct zram_slot_s *slot,
+                           FAR unsigned char *buffer)
+{
+  uintptr_t fill;
+  size_t i;
+
+  if (slot->zs_flags & ZRAM_SLOT_SAME)
+    {
+      fill = (uintptr_t)slot->zs_data;
+      for (i = 0; i < dev->zd_sectsize; i += sizeof(uintptr_t))
+        {
+          memcpy(&buffer[i], &fill, sizeof(uintptr_t));
+        }
+    }
+  else if (slot->zs_data == NULL)
+    {
+      memset(buffer, 0, dev->zd_sectsize);
+    }
+  else if (slot->zs_flags & ZRAM_SLOT_HUGE)
+    {
+      memcpy(buffer, slot->zs_data, dev->zd_sectsize);
+    }
+  else if (lzf_decompress(slot->zs_data, slot->zs_len,
+                          buffer, dev->zd_sectsize) != dev->zd_sectsize)
+    {
+      ferr("ERROR: Corrupted sector at %p\n", slot->zs_data);
+      return -EIO;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: zram_writesector
+ *
+ * Description:
+ *   Store one sector.  The old contents are kept if the store is full.
+ *
+ ****************************************************************************/
+
+static int zram_writesector(FAR struct zram_struct_s *dev,
+                            FAR struct zram_slot_s *slot,
+                            FAR const unsigned char *buffer)
+{
+  FAR struct lzf_header_s *header;
+  FAR const uint8_t *src;
+  FAR void *data;
+  uintptr_t fill;
+  size_t len;
+  uint8_t flags;
+
+  /* Work on a copy: the input needs room in front of it for the LZF
+   * header when the sector does not compress, and must be aligned for
+   * the same-filled check.
+   */
+
+  memcpy(dev->zd_in, buffer, dev->zd_sectsize);
+
+  if (zram_same((FAR const uintptr_t *)dev->zd_in,
+                dev->zd_sectsize / sizeof(uintptr_t), &fill))
+    {
+      zram_release(dev, slot);
+      slot->zs_data  = (FAR void *)fill;
+      slot->zs_flags = ZRAM_SLOT_SAME;
+      dev->zd_nsame++;
+      return OK;
+    }
+
+  /* Anything longer than zd_maxclen would take a block of the largest
+   * pool anyway, so such sectors are stored as they are.
+   */
+
+  len = lzf_compress(dev->zd_in, dev->zd_sectsize, dev->zd_out,
+                     dev->zd_maxclen, dev->zd_state, &header);
+  if (header->lzf_type == LZF_TYPE1_HDR)
+    {
+      src   = dev->zd_out;
+      len  -= LZF_TYPE1_HDR_SIZE;
+      flags = 0;
+    }
+  else
+    {
+      src   = dev->zd_in;
+      len   = dev->zd_sectsize;
+      flags = ZRAM_SLOT_HUGE;
+    }
+
+  data = mempool_multiple_alloc(dev->zd_pool, len);
+  if (data == NULL)
+    {
+      return -ENOSPC;
+    }
+
+  memcpy(data, src, len);
+  zram_release(dev, slot);
+
+  slot->zs_data  = data;
+  slot->zs_len   = len;
+  slot->zs_flags = flags;
+
+  dev->zd_compsize += len;
+  if (flags & ZRAM_SLOT_HUGE)
+    {
+      dev->zd_nhuge++;
+    }
+  else
+    {
+      dev->zd_ncompressed++;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: zram_destroy
+ *
+ * Description:
+ *   Free all resources used by the compressed RAM disk
+ *
+ ****************************************************************************/
+
+static void zram_destroy(FAR struct zram_struct_s *dev)
+{
+  uint32_t i;
+
+  finfo("Destroying compressed RAM disk\n");
+
+  if (dev->zd_table != NULL)
+    {
+      for (i = 0; i < dev->zd_nsectors; i++)
+        {
+          zram_release(dev, &dev->zd_table[i]);
+        }
+
+      kmm_free(dev->zd_table);
+    }
+
+  mempool_multiple_deinit(dev->zd_pool);
+  kmm_free(dev->zd_in - ZRAM_HDRSIZE);
+  nxmutex_destroy(&dev->zd_lock);
+  kmm_free(dev);
+}
+
+/****************************************************************************
+ * Name: zram_open
+ *
+ * Description: Open the block device
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+static int zram_open(FAR struct inode *inode)
+{
+  FAR struct zram_struct_s *dev;
+
+  DEBUGASSERT(inode->i_private);
+  dev = inode->i_private;
+
+  /* Increment the open reference count */
+
+  dev->zd_crefs++;
+  DEBUGASSERT(dev->zd_crefs > 0);
+
+  finfo("zd_crefs: %d\n", dev->zd_crefs);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: zram_close
+ *
+ * Description: close the block device
+ *
+ ****************************************************************************/
+
+static int zram_close(FAR struct inode *inode)
+{
+  FAR struct zram_struct_s *dev;
+
+  DEBUGASSERT(inode->i_private);
+  dev = inode->i_private;
+
+  /* Decrement the open reference count */
+
+  DEBUGASSERT(dev->zd_crefs > 0);
+  dev->zd_crefs--;
+  finfo("zd_crefs: %d\n", dev->zd_crefs);
+
+  /* Release all resources with the last reference of an unlinked disk */
+
+  if (dev->zd_crefs == 0 && dev->zd_unlinked)
+    {
+      zram_destroy(dev);
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: zram_read
+ *
+ * Description:  Read the specified number of sectors
+ *
+ ****************************************************************************/
+
+static ssize_t zram_read(FAR struct inode *inode, FAR unsigned char *buffer,
+                         blkcnt_t start_sector, unsigned int nsectors)
+{
+  FAR struct zram_struct_s *dev;
+  unsigned int i;
+  int ret;
+
+  DEBUGASSERT(inode->i_private);
+  dev = inode->i_private;
+
+  finfo("sector: %" PRIuOFF " nsectors: %u sectorsize: %d\n",
+        start_sector, nsectors, dev->zd_sectsize);
+
+  if (start_sector >= dev->zd_nsectors ||
+      start_sector + nsectors > dev->zd_nsectors)
+    {
+      return -EINVAL;
+    }
+
+  ret = nxmutex_lock(&dev->zd_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (i = 0; i < nsectors; i++)
+    {
+      ret = zram_readsector(dev, &dev->zd_table[start_sector + i],
+                            &buffer[i * dev->zd_sectsize]);
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  dev->zd_nreads += i;
+  nxmutex_unlock(&dev->zd_lock);
+  return i > 0 ? i : ret;
+}
+
+/****************************************************************************
+ * Name: zram_write
+ *
+ * Description: Write the specified number of sectors
+ *
+ ****************************************************************************/
+
+static ssize_t zram_write(FAR struct inode *inode,
+                          FAR const unsigned char *buffer,
+                          blkcnt_t start_sector, unsigned int nsectors)
+{
+  FAR struct zram_struct_s *dev;
+  unsigned int i;
+  int ret;
+
+  DEBUGASSERT(inode->i_private);
+  dev = inode->i_private;
+
+  finfo("sector: %" PRIuOFF " nsectors: %u sectorsize: %d\n",
+        start_sector, nsectors, dev->zd_sectsize);
+
+  if (start_sector >= dev->zd_nsectors ||
+      start_sector + nsectors > dev->zd_nsectors)
+    {
+      return -EFBIG;
+    }
+
+  ret = nxmutex_lock(&dev->zd_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (i = 0; i < nsectors; i++)
+    {
+      ret = zram_writesector(dev, &dev->zd_table[start_sector + i],
+                             &buffer[i * dev->zd_sectsize]);
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  dev->zd_nwrites += i;
+  nxmutex_unlock(&dev->zd_lock);
+  return i > 0 ? i : ret;
+}
+
+/****************************************************************************
+ * Name: zram_geometry
+ *
+ * Description: Return device geometry
+ *
+ ****************************************************************************/
+
+static int zram_geometry(FAR struct inode *inode,
+                         FAR struct geometry *geometry)
+{
+  FAR struct zram_struct_s *dev;
+
+  finfo("Entry\n");
+
+  if (geometry)
+    {
+      dev = inode->i_private;
+
+      memset(geometry, 0, sizeof(*geometry));
+
+      geometry->geo_available     = true;
+      geometry->geo_mediachanged  = false;
+      geometry->geo_writeenabled  = true;
+      geometry->geo_nsectors      = dev->zd_nsectors;
+      geometry->geo_sectorsize    = dev->zd_sectsize;
+
+      finfo("nsectors: %" PRIuOFF " sectorsize: %" PRIi16 "\n",
+            geometry->geo_nsectors, geometry->geo_sectorsize);
+
+      return OK;
+    }
+
+  return -EINVAL;
+}
+
+/****************************************************************************
+ * Name: zram_ioctl
+ *
+ * Description:
+ *   Return the statistics of the compressed RAM disk
+ *
+ ****************************************************************************/
+
+static int zram_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
+{
+  FAR struct zram_struct_s *dev;
+  FAR struct zram_stats_s *stats =
+    (FAR struct zram_stats_s *)((uintptr_t)arg);
+  int ret;
+
+  finfo("Entry\n");
+
+  DEBUGASSERT(inode->i_private);
+  if (cmd != BIOC_ZRAMSTATS || stats == NULL)
+    {
+      return -ENOTTY;
+    }
+
+  dev = inode->i_private;
+  ret = nxmutex_lock(&dev->zd_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  stats->nsectors    = dev->zd_nsectors;
+  stats->sectsize    = dev->zd_sectsize;
+  stats->ncompressed = dev->zd_ncompressed;
+  stats->nhuge       = dev->zd_nhuge;
+  stats->nsame       = dev->zd_nsame;
+  stats->compsize    = dev->zd_compsize;
+  stats->memused     = mempool_multiple_mallinfo(dev->zd_pool).arena;
+  stats->nreads      = dev->zd_nreads;
+  stats->nwrites     = dev->zd_nwrites;
+
+  nxmutex_unlock(&dev->zd_lock);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: zram_unlink
+ *
+ * Description:
+ *   The block driver has been unlinked.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+static int zram_unlink(FAR struct inode *inode)
+{
+  FAR struct zram_struct_s *dev;
+
+  DEBUGASSERT(inode->i_private);
+  dev = inode->i_private;
+
+  dev->zd_unlinked = true;
+
+  /* Are the any open references to the driver? */
+
+  if (dev->zd_crefs == 0)
+    {
+      /* No... release all resources held by the block driver */
+
+      zram_destroy(dev);
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: zram_register
+ *
+ * Description:
+ *   Register a compressed RAM disk as /dev/zramN.  Each sector is stored
+ *   LZF compressed in a memory pool, so the memory used grows with the
+ *   data written and shrinks with how well it compresses.  Sectors filled
+ *   with a repeated word take no memory beyond the sector table.  Sectors
+ *   never written read as zeroes.
+ *
+ * Input Parameters:
+ *   minor:         Selects suffix of device named /dev/zramN, N={1,2,3...}
+ *   nsectors:      Number of sectors on device
+ *   sectsize:      The size of one sector
+ *
+ * Returned Value:
+ *   Zero on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int zram_register(int minor, uint32_t nsectors, uint16_t sectsize)
+{
+  FAR struct zram_struct_s *dev;
+  size_t poolsize[CONFIG_DRVR_ZRAM_NPOOLS];
+  size_t expandsize;
+  size_t npools;
+  size_t delta;
+  char devname[16];
+  int ret = -ENOMEM;
+  int i;
+
+  finfo("nsectors: %" PRIu32 " sectsize: %" PRIu16 "\n",
+        nsectors, sectsize);
+
+  /* Sanity check.  The same-filled check works on whole words. */
+
+  if (minor < 0 || minor > 255 || nsectors == 0 || sectsize == 0 ||
+      sectsize % sizeof(uintptr_t) != 0)
+    {
+      return -EINVAL;
+    }
+
+  /* Allocate a compressed RAM disk device structure */
+
+  dev = kmm_zalloc(sizeof(struct zram_struct_s));
+  if (dev == NULL)
+    {
+      return ret;
+    }
+
+  dev->zd_nsectors = nsectors;
+  dev->zd_sectsize = sectsize;
+  nxmutex_init(&dev->zd_lock);
+
+  /* The store is a multiple mempool whose block sizes step evenly up to
+   * the sector size, so a compressed sector wastes less than one step.
+   */
+
+  delta  = ALIGN_UP(div_round_up(sectsize, CONFIG_DRVR_ZRAM_NPOOLS),
+                    MEMPOOL_ALIGN);
+  npools = div_round_up(sectsize, delta);
+  for (i = 0; i < npools; i++)
+    {
+      poolsize[i] = (i + 1) * delta;
+    }
+
+  dev->zd_maxclen = sectsize > delta ? sectsize - delta : sectsize - 1;
+
+  expandsize = CONFIG_DRVR_ZRAM_EXPANDSIZE;
+  while (expandsize < 4 * poolsize[npools - 1])
+    {
+      expandsize <<= 1;
+    }
+
+  snprintf(dev->zd_name, sizeof(dev->zd_name), "zram%d", minor);
+  dev->zd_pool = mempool_multiple_init(dev->zd_name, poolsize, npools,
+                                       zram_pool_alloc,
+                                       zram_pool_alloc_size,
+                                       zram_pool_free, dev, 0,
+                                       expandsize, expandsize);
+  if (dev->zd_pool == NULL)
+    {
+      goto errout_with_dev;
+    }
+
+  dev->zd_in = kmm_malloc(2 * (ZRAM_HDRSIZE + sectsize));
+  if (dev->zd_in == NULL)
+    {
+      goto errout_with_pool;
+    }
+
+  dev->zd_in  += ZRAM_HDRSIZE;
+  dev->zd_out  = dev->zd_in + sectsize + ZRAM_HDRSIZE;
+
+  dev->zd_table = kmm_zalloc(nsectors * sizeof(struct zram_slot_s));
+  if (dev->zd_table == NULL)
+    {
+      goto errout_with_buffer;
+    }
+
+  /* Create a compressed RAM disk device name */
+
+  snprintf(devname, sizeof(devname), "/dev/zram%d", minor);
+
+  /* Inode private data is a reference to the device structure */
+
+  ret = register_blockdriver(devname, &g_zram_bops, 0, dev);
+  if (ret < 0)
+    {
+      ferr("register_blockdriver failed: %d\n", -ret);
+      zram_destroy(dev);
+    }
+
+  return ret;
+
+errout_with_buffer:
+  kmm_free(dev->zd_in - ZRAM_HDRSIZE);
+errout_with_pool:
+  mempool_multiple_deinit(dev->zd_pool);
+errout_with_dev:
+  nxmutex_destroy(&dev->zd_lock);
+  kmm_free(dev);
+  return ret;
+}
@@ -142,6 +142,11 @@
 #define SMART_WEARFLAGS_FORCE_REORG         0x01
 #define SMART_WEARFLAGS_WRITE_NEEDED        0x02
 
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+#define SMART_MAP_MAGIC             "SMAP"
+#define SMART_MAP_NSLOTS            2
+#endif
+
 #define SET_BITMAP(m, n) do { (m)[(n) / 8] |= 1 << ((n) % 8); } while (0)
 #define CLR_BITMAP(m, n) do { (m)[(n) / 8] &= ~(1 << ((n) % 8)); } while (0)
 #define ISSET_BITMAP(m, n) ((m)[(n) / 8] & (1 << ((n) % 8)))
@@ -297,6 +302,13 @@ struct smart_struct_s
   size_t                bytesalloc;
   struct smart_alloc_s  alloc[SMART_MAX_ALLOCS];   /* Array of memory allocations */
 #endif
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+  uint16_t              mapblock;         /* First erase block of the map slots */
+  uint8_t               mapslot;          /* Slot of the last checkpoint */
+  bool                  mapcurrent;       /* Checkpoint marked current */
+  bool                  mapvalid;         /* Checkpoint matches RAM */
+  uint32_t              mapseq;           /* Sequence of the last checkpoint */
+#endif
 };
 
 #ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
@@ -396,6 +408,29 @@ struct smart_chain_header_s
 };
 #endif
 
+/* Sector map checkpoint header.  It occupies the first MTD block of a map
+ * slot and is followed by the sector map and the release and free counts
+ * of the erase blocks, exactly as they are held in RAM.  The header is
+ * written last, and its current byte is programmed before the first change
+ * of the device after the checkpoint.
+ */
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+struct smart_map_header_s
+{
+  uint8_t           magic[4];       /* SMART_MAP_MAGIC */
+  uint8_t           current;        /* Erased state while current */
+  uint8_t           reserved;
+  uint16_t          sectorsize;     /* Sector size */
+  uint16_t          totalsectors;   /* Number of sectors in the map */
+  uint16_t          neraseblocks;   /* Number of erase block counts */
+  uint16_t          freesectors;    /* Total number of free sectors */
+  uint16_t          releasesectors; /* Total number of released sectors */
+  uint32_t          seq;            /* Checkpoint sequence number */
+  uint32_t          crc;            /* CRC-32 of the header and the map */
+};
+#endif
+
 struct smart_entry_header_s
 {
   uint16_t          flags;         /* Flags, including permissions:
@@ -437,6 +472,10 @@ static int     smart_readsector(FAR struct smart_struct_s *dev,
 #ifdef CONFIG_MTD_SMART_ENABLE_CRC
 static int     smart_validate_crc(FAR struct smart_struct_s *dev);
 #endif
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+static int     smart_map_modify(FAR struct smart_struct_s *dev);
+static int     smart_map_save(FAR struct smart_struct_s *dev);
+#endif
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
 static int     smart_read_wearstatus(FAR struct smart_struct_s *dev);
 static int     smart_relocate_static_data(FAR struct smart_struct_s *dev,
@@ -511,7 +550,27 @@ static int smart_open(FAR struct inode *inode)
 
 static int smart_close(FAR struct inode *inode)
 {
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+  FAR struct smart_struct_s *dev;
+#endif
+
   finfo("Entry\n");
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+  DEBUGASSERT(inode->i_private);
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+  dev = ((FAR struct smart_multiroot_device_s *)inode->i_private)->dev;
+#else
+  dev = inode->i_private;
+#endif
+
+  /* Checkpoint the sector map so that the next mount does not need to
+   * scan the device.
+   */
+
+  smart_map_save(dev);
+#endif
+
   return OK;
 }
 
@@ -949,6 +1008,14 @@ static ssize_t smart_write(FAR struct inode *inode,
 
   /* I think maybe we need to lock on a mutex here */
 
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+  ret = smart_map_modify(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+#endif
+
   /* Get the aligned block.  Here is is assumed: (1) The number of R/W blocks
    * per erase block is a power of 2, and (2) the erase begins with that same
    * alignment.
@@ -1932,6 +1999,470 @@ static int smart_set_wear_level(FAR struct smart_struct_s *dev,
 }
 #endif
 
+/****************************************************************************
+ * Name: smart_readformat
+ *
+ * Description: Reads the format signature information from the physical
+ *              sector holding logical sector zero.  Returns -ENOENT if the
+ *              signature is not valid.
+ *
+ ****************************************************************************/
+
+static int smart_readformat(FAR struct smart_struct_s *dev, uint16_t sector)
+{
+  uint32_t readaddress;
+  int ret;
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+  int x;
+  char devname[32];
+  FAR struct smart_multiroot_device_s *rootdirdev;
+#endif
+
+  /* Read the sector data */
+
+  readaddress = sector * dev->mtdblkspersector * dev->geo.blocksize;
+  ret = MTD_READ(dev->mtd, readaddress, 32, (FAR uint8_t *)dev->rwbuffer);
+  if (ret != 32)
+    {
+      ferr("ERROR: Error reading physical sector %d.\n", sector);
+      return ret < 0 ? ret : -EIO;
+    }
+
+  /* Validate the format signature */
+
+  if (dev->rwbuffer[SMART_FMT_POS1] != SMART_FMT_SIG1 ||
+      dev->rwbuffer[SMART_FMT_POS2] != SMART_FMT_SIG2 ||
+      dev->rwbuffer[SMART_FMT_POS3] != SMART_FMT_SIG3 ||
+      dev->rwbuffer[SMART_FMT_POS4] != SMART_FMT_SIG4)
+    {
+      return -ENOENT;
+    }
+
+  /* Mark the volume as formatted and set the sector size */
+
+  dev->formatstatus = SMART_FMT_STAT_FORMATTED;
+  dev->namesize = dev->rwbuffer[SMART_FMT_NAMESIZE_POS];
+  dev->formatversion = dev->rwbuffer[SMART_FMT_VERSION_POS];
+
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+  dev->rootdirentries = dev->rwbuffer[SMART_FMT_ROOTDIRS_POS];
+
+  /* If rootdirentries is greater than 1, then we need to register
+   * additional block devices.
+   */
+
+  for (x = 1; x < dev->rootdirentries; x++)
+    {
+      if (dev->partname[0] != '\0')
+        {
+          snprintf(devname, sizeof(devname), "/dev/smart%d%sd%d",
+                   dev->minor, dev->partname, x + 1);
+        }
+      else
+        {
+          snprintf(devname, sizeof(devname), "/dev/smart%dd%d",
+                   dev->minor, x + 1);
+        }
+
+      /* Inode private data is a reference to a struct containing
+       * the SMART device structure and the root directory number.
+       */
+
+      rootdirdev = (FAR struct smart_multiroot_device_s *)
+        smart_malloc(dev, sizeof(*rootdirdev), "Root Dir");
+      if (rootdirdev == NULL)
+        {
+          ferr("ERROR: Memory alloc failed\n");
+          return -ENOMEM;
+        }
+
+      /* Populate the rootdirdev */
+
+      rootdirdev->dev = dev;
+      rootdirdev->rootdirnum = x;
+
+      /* Inode private data is a reference to the SMART device
+       * structure.
+       */
+
+      register_blockdriver(devname, &g_bops, 0, rootdirdev);
+    }
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: smart_map_slotblock
+ *
+ * Description: Returns the first MTD block of a sector map checkpoint slot.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+static off_t smart_map_slotblock(FAR struct smart_struct_s *dev,
+                                 uint8_t slot)
+{
+  return (off_t)(dev->mapblock + slot * CONFIG_MTD_SMART_MAP_NBLOCKS) *
+         (dev->geo.erasesize / dev->geo.blocksize);
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_map_size
+ *
+ * Description: Returns the size of the sector map together with the
+ *              release and free counts that follow it in RAM.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+static size_t smart_map_size(FAR struct smart_struct_s *dev)
+{
+  return dev->freecount + dev->neraseblocks - (FAR uint8_t *)dev->smap;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_map_crc
+ *
+ * Description: Calculates the CRC of a sector map checkpoint.  The current
+ *              byte is excluded as it is programmed after the CRC is.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+static uint32_t smart_map_crc(FAR struct smart_struct_s *dev,
+                              FAR const struct smart_map_header_s *header)
+{
+  struct smart_map_header_s tmp;
+  uint32_t crc;
+
+  memcpy(&tmp, header, sizeof(tmp));
+  tmp.current = CONFIG_SMARTFS_ERASEDSTATE;
+  tmp.crc     = 0;
+
+  crc = crc32part((FAR const uint8_t *)dev->smap, smart_map_size(dev), 0);
+  return crc32part((FAR const uint8_t *)&tmp, sizeof(tmp), crc);
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_map_modify
+ *
+ * Description: Called before the device is modified.  Marks the sector map
+ *              checkpoint on the device as no longer current, so that the
+ *              next mount scans the device instead of loading it.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+static int smart_map_modify(FAR struct smart_struct_s *dev)
+{
+  uint8_t current = (uint8_t)~CONFIG_SMARTFS_ERASEDSTATE;
+  size_t offset;
+  ssize_t ret;
+
+  dev->mapvalid = false;
+
+  if (dev->mapcurrent)
+    {
+      offset = smart_map_slotblock(dev, dev->mapslot) * dev->geo.blocksize +
+               offsetof(struct smart_map_header_s, current);
+      ret    = smart_bytewrite(dev, offset, 1, &current);
+      if (ret < 0)
+        {
+          ferr("ERROR: Error %zd invalidating the sector map\n", -ret);
+          return ret;
+        }
+
+      dev->mapcurrent = false;
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_map_load
+ *
+ * Description: Loads the sector map and the free and release counts from
+ *              the newest checkpoint instead of scanning the device.  Fails
+ *              if the checkpoint is missing, damaged or was made stale by a
+ *              later change of the device, and the caller must then perform
+ *              a full scan.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+static int smart_map_load(FAR struct smart_struct_s *dev)
+{
+  struct smart_map_header_s header;
+  struct smart_map_header_s newest;
+  FAR uint8_t *map;
+  size_t mapsize;
+  size_t nblocks;
+  size_t remain;
+  off_t block;
+  bool found = false;
+  uint8_t slot;
+  int ret;
+
+  dev->mapvalid   = false;
+  dev->mapcurrent = false;
+
+  /* Find the checkpoint with the highest sequence number */
+
+  for (slot = 0; slot < SMART_MAP_NSLOTS; slot++)
+    {
+      ret = MTD_BREAD(dev->mtd, smart_map_slotblock(dev, slot), 1,
+                      (FAR uint8_t *)dev->rwbuffer);
+      if (ret != 1)
+        {
+          continue;
+        }
+
+      memcpy(&header, dev->rwbuffer, sizeof(header));
+      if (memcmp(header.magic, SMART_MAP_MAGIC, sizeof(header.magic)) != 0)
+        {
+          continue;
+        }
+
+      if (!found || (int32_t)(header.seq - newest.seq) > 0)
+        {
+          memcpy(&newest, &header, sizeof(newest));
+          dev->mapslot = slot;
+          found = true;
+        }
+    }
+
+  if (!found)
+    {
+      return -ENOENT;
+    }
+
+  dev->mapseq     = newest.seq;
+  dev->mapcurrent = newest.current == CONFIG_SMARTFS_ERASEDSTATE;
+  if (!dev->mapcurrent)
+    {
+      finfo("Sector map checkpoint %" PRIu32 " is stale\n", newest.seq);
+      return -ENOENT;
+    }
+
+  /* Validate the geometry the checkpoint was taken with */
+
+  ret = smart_setsectorsize(dev, newest.sectorsize);
+  if (ret != OK)
+    {
+      goto errout;
+    }
+
+  if (newest.sectorsize != dev->sectorsize ||
+      newest.totalsectors != dev->totalsectors ||
+      newest.neraseblocks != dev->neraseblocks)
+    {
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  /* Read the map directly into RAM, except for the partial last block */
+
+  map     = (FAR uint8_t *)dev->smap;
+  mapsize = smart_map_size(dev);
+  nblocks = mapsize / dev->geo.blocksize;
+  remain  = mapsize % dev->geo.blocksize;
+  block   = smart_map_slotblock(dev, dev->mapslot) + 1;
+
+  if (nblocks > 0)
+    {
+      ret = MTD_BREAD(dev->mtd, block, nblocks, map);
+      if (ret != nblocks)
+        {
+          ret = -EIO;
+          goto errout;
+        }
+    }
+
+  if (remain > 0)
+    {
+      ret = MTD_BREAD(dev->mtd, block + nblocks, 1,
+                      (FAR uint8_t *)dev->rwbuffer);
+      if (ret != 1)
+        {
+          ret = -EIO;
+          goto errout;
+        }
+
+      memcpy(map + nblocks * dev->geo.blocksize, dev->rwbuffer, remain);
+    }
+
+  if (smart_map_crc(dev, &newest) != newest.crc)
+    {
+      ferr("ERROR: Sector map checkpoint CRC error\n");
+      ret = -EIO;
+      goto errout;
+    }
+
+  dev->freesectors    = newest.freesectors;
+  dev->releasesectors = newest.releasesectors;
+  dev->formatstatus   = SMART_FMT_STAT_NOFMT;
+
+  /* Read the format signature from logical sector zero */
+
+  if (dev->smap[0] != 0xffff)
+    {
+      ret = smart_readformat(dev, dev->smap[0]);
+      if (ret < 0)
+        {
+          goto errout;
+        }
+    }
+
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+  /* Read the wear leveling status bits */
+
+  smart_read_wearstatus(dev);
+#endif
+
+  finfo("Loaded sector map checkpoint %" PRIu32 "\n", newest.seq);
+  dev->mapvalid = true;
+  return OK;
+
+errout:
+
+  /* The scan that follows may change the device, so the checkpoint must
+   * not be trusted by the next mount either.
+   */
+
+  ferr("ERROR: Sector map checkpoint not usable: %d\n", ret);
+  smart_map_modify(dev);
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_map_save
+ *
+ * Description: Writes a checkpoint of the sector map and the free and
+ *              release counts into the slot not holding the last one, so
+ *              that a damaged write leaves the previous checkpoint intact.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+static int smart_map_save(FAR struct smart_struct_s *dev)
+{
+  struct smart_map_header_s header;
+  FAR uint8_t *map;
+  size_t mapsize;
+  size_t nblocks;
+  size_t remain;
+  off_t block;
+  uint8_t slot;
+  int ret;
+
+  /* Nothing to do if the device is unchanged since the last checkpoint */
+
+  if (dev->mapvalid || dev->formatstatus != SMART_FMT_STAT_FORMATTED)
+    {
+      return OK;
+    }
+
+#ifdef CONFIG_MTD_SMART_ENABLE_CRC
+  /* Sectors allocated but not yet written only exist in RAM */
+
+  if (dev->allocsector != NULL)
+    {
+      return -EBUSY;
+    }
+#endif
+
+  map     = (FAR uint8_t *)dev->smap;
+  mapsize = smart_map_size(dev);
+  nblocks = mapsize / dev->geo.blocksize;
+  remain  = mapsize % dev->geo.blocksize;
+
+  if (1 + nblocks + (remain > 0) > CONFIG_MTD_SMART_MAP_NBLOCKS *
+      (dev->geo.erasesize / dev->geo.blocksize))
+    {
+      ferr("ERROR: Sector map of %zu bytes does not fit a slot\n", mapsize);
+      return -ENOSPC;
+    }
+
+  ret = smart_map_modify(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  slot  = dev->mapslot ^ 1;
+  block = smart_map_slotblock(dev, slot);
+
+  ret = MTD_ERASE(dev->mtd, dev->mapblock +
+                  slot * CONFIG_MTD_SMART_MAP_NBLOCKS,
+                  CONFIG_MTD_SMART_MAP_NBLOCKS);
+  if (ret < 0)
+    {
+      ferr("ERROR: Error %d erasing the sector map slot\n", -ret);
+      return ret;
+    }
+
+  /* Write the map, then the header that makes it valid */
+
+  if (nblocks > 0)
+    {
+      ret = MTD_BWRITE(dev->mtd, block + 1, nblocks, map);
+      if (ret != nblocks)
+        {
+          goto errout;
+        }
+    }
+
+  if (remain > 0)
+    {
+      memset(dev->rwbuffer, CONFIG_SMARTFS_ERASEDSTATE, dev->geo.blocksize);
+      memcpy(dev->rwbuffer, map + nblocks * dev->geo.blocksize, remain);
+      ret = MTD_BWRITE(dev->mtd, block + 1 + nblocks, 1,
+                       (FAR uint8_t *)dev->rwbuffer);
+      if (ret != 1)
+        {
+          goto errout;
+        }
+    }
+
+  memcpy(header.magic, SMART_MAP_MAGIC, sizeof(header.magic));
+  header.current        = CONFIG_SMARTFS_ERASEDSTATE;
+  header.reserved       = CONFIG_SMARTFS_ERASEDSTATE;
+  header.sectorsize     = dev->sectorsize;
+  header.totalsectors   = dev->totalsectors;
+  header.neraseblocks   = dev->neraseblocks;
+  header.freesectors    = dev->freesectors;
+  header.releasesectors = dev->releasesectors;
+  header.seq            = dev->mapseq + 1;
+  header.crc            = smart_map_crc(dev, &header);
+
+  memset(dev->rwbuffer, CONFIG_SMARTFS_ERASEDSTATE, dev->geo.blocksize);
+  memcpy(dev->rwbuffer, &header, sizeof(header));
+  ret = MTD_BWRITE(dev->mtd, block, 1, (FAR uint8_t *)dev->rwbuffer);
+  if (ret != 1)
+    {
+      goto errout;
+    }
+
+  finfo("Saved sector map checkpoint %" PRIu32 "\n", header.seq);
+
+  dev->mapslot    = slot;
+  dev->mapseq     = header.seq;
+  dev->mapcurrent = true;
+  dev->mapvalid   = true;
+  return OK;
+
+errout:
+  ferr("ERROR: Error %d writing the sector map checkpoint\n", ret);
+  return ret < 0 ? ret : -EIO;
+}
+#endif
+
 /****************************************************************************
  * Name: smart_scan
  *
@@ -1960,11 +2491,6 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 #ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
   int       dupsector;
   uint16_t  duplogsector;
-#endif
-#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
-  int       x;
-  char      devname[32];
-  FAR struct smart_multiroot_device_s *rootdirdev;
 #endif
   static const uint16_t sizetbl[8] =
   {
@@ -1974,6 +2500,15 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 
   finfo("Entry\n");
 
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+  /* Load the sector map from the last checkpoint if it is still current */
+
+  if (smart_map_load(dev) == OK)
+    {
+      return OK;
+    }
+#endif
+
   /* Find the sector size on the volume by reading headers from
    * sectors of decreasing size.  On a formatted volume, the sector
    * size is saved in the header status byte of search sector, so
@@ -2176,22 +2711,10 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 
       if (logicalsector == 0)
         {
-          /* Read the sector data */
-
-          ret = MTD_READ(dev->mtd, readaddress, 32,
-                         (FAR uint8_t *)dev->rwbuffer);
-          if (ret != 32)
-            {
-              ferr("ERROR: Error reading physical sector %d.\n", sector);
-              goto err_out;
-            }
-
           /* Validate the format signature */
 
-          if (dev->rwbuffer[SMART_FMT_POS1] != SMART_FMT_SIG1 ||
-              dev->rwbuffer[SMART_FMT_POS2] != SMART_FMT_SIG2 ||
-              dev->rwbuffer[SMART_FMT_POS3] != SMART_FMT_SIG3 ||
-              dev->rwbuffer[SMART_FMT_POS4] != SMART_FMT_SIG4)
+          ret = smart_readformat(dev, sector);
+          if (ret == -ENOENT)
             {
               /* Invalid signature on a sector claiming to be sector 0!
                * What should we do?  Release it?
@@ -2199,58 +2722,10 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 
               continue;
             }
-
-          /* Mark the volume as formatted and set the sector size */
-
-          dev->formatstatus = SMART_FMT_STAT_FORMATTED;
-          dev->namesize = dev->rwbuffer[SMART_FMT_NAMESIZE_POS];
-          dev->formatversion = dev->rwbuffer[SMART_FMT_VERSION_POS];
-
-#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
-          dev->rootdirentries = dev->rwbuffer[SMART_FMT_ROOTDIRS_POS];
-
-          /* If rootdirentries is greater than 1, then we need to register
-           * additional block devices.
-           */
-
-          for (x = 1; x < dev->rootdirentries; x++)
+          else if (ret < 0)
             {
-              if (dev->partname[0] != '\0')
-                {
-                  snprintf(devname, sizeof(devname), "/dev/smart%d%sd%d",
-                           dev->minor, dev->partname, x + 1);
-                }
-              else
-                {
-                  snprintf(devname, sizeof(devname), "/dev/smart%dd%d",
-                           dev->minor, x + 1);
-                }
-
-              /* Inode private data is a reference to a struct containing
-               * the SMART device structure and the root directory number.
-               */
-
-              rootdirdev = (FAR struct smart_multiroot_device_s *)
-                smart_malloc(dev, sizeof(*rootdirdev), "Root Dir");
-              if (rootdirdev == NULL)
-                {
-                  ferr("ERROR: Memory alloc failed\n");
-                  ret = -ENOMEM;
-                  goto err_out;
-                }
-
-              /* Populate the rootdirdev */
-
-              rootdirdev->dev = dev;
-              rootdirdev->rootdirnum = x;
-
-              /* Inode private data is a reference to the SMART device
-               * structure.
-               */
-
-              ret = register_blockdriver(devname, &g_bops, 0, rootdirdev);
+              goto err_out;
             }
-#endif
         }
 
       /* Test for duplicate logical sectors on the device */
@@ -3166,6 +3641,13 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev,
       return ret;
     }
 
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+  /* The bulk erase removed the sector map checkpoints as well */
+
+  dev->mapcurrent = false;
+  dev->mapvalid   = false;
+#endif
+
   /* Now construct a logical sector zero header to write to the device. */
 
   sectorheader = (FAR struct smart_sect_header_s *)dev->rwbuffer;
@@ -5500,12 +5982,35 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
   dev = inode->i_private;
 #endif
 
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+  /* Invalidate the sector map checkpoint before changing the device */
+
+  if (cmd == BIOC_LLFORMAT || cmd == BIOC_ALLOCSECT ||
+      cmd == BIOC_FREESECT || cmd == BIOC_WRITESECT)
+    {
+      ret = smart_map_modify(dev);
+      if (ret < 0)
+        {
+          goto ok_out;
+        }
+    }
+#endif
+
   /* Process the ioctl's we care about first, pass any we don't respond
    * to directly to the underlying MTD device.
    */
 
   switch (cmd)
     {
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+    case BIOC_FLUSH:
+
+      /* Checkpoint the sector map */
+
+      ret = smart_map_save(dev);
+      goto ok_out;
+#endif
+
     case BIOC_GETFORMAT:
 
       /* Return the format information for the device */
@@ -6197,6 +6702,25 @@ int smart_initialize(int minor, FAR struct mtd_dev_s *mtd,
           goto errout;
         }
 
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+      /* Reserve the erase blocks at the end of the device for the two
+       * sector map checkpoint slots.
+       */
+
+      if (dev->geo.neraseblocks <=
+          SMART_MAP_NSLOTS * CONFIG_MTD_SMART_MAP_NBLOCKS)
+        {
+          ferr("ERROR: Device too small for the sector map checkpoint\n");
+          ret = -EINVAL;
+          goto errout;
+        }
+
+      dev->geo.neraseblocks -= SMART_MAP_NSLOTS *
+                               CONFIG_MTD_SMART_MAP_NBLOCKS;
+      dev->mapblock          = dev->geo.neraseblocks;
+      dev->mapslot           = SMART_MAP_NSLOTS - 1;
+#endif
+
       /* Set the sector size to the default for now */
 
       dev->sectorsize = 0;
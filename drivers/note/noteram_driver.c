@@ -31,9 +31,12 @@
 #include <errno.h>
 #include <stdio.h>
 #include <string.h>
+#include <strings.h>
 #include <inttypes.h>
 #include <poll.h>
 
+#include <nuttx/atomic.h>
+#include <nuttx/irq.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/sched.h>
 #include <nuttx/sched_note.h>
@@ -74,6 +77,24 @@
  * Private Types
  ****************************************************************************/
 
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+
+/* One per-CPU ring.  head and tail are free running byte counters that are
+ * only advanced by the owning CPU (with its local interrupts disabled), so
+ * adding a note takes no lock.  The reader validates every note it copies
+ * against tail, which the writer advances before it overwrites old notes.
+ */
+
+struct noteram_cpu_s
+{
+  FAR uint8_t *buffer;            /* Ring storage, a power of two in size */
+  unsigned int mask;              /* Ring size - 1 */
+  atomic_uint head;               /* Position of the next note to add */
+  atomic_uint tail;               /* Position of the oldest note */
+  unsigned int read;              /* Position of the next note to read */
+};
+#endif
+
 struct noteram_driver_s
 {
   struct note_driver_s driver;
@@ -85,6 +106,9 @@ struct noteram_driver_s
   volatile unsigned int ni_read;
   spinlock_t lock;
   FAR struct pollfd *pfd;
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+  struct noteram_cpu_s ni_cpu[NCPUS];
+#endif
 };
 
 /* The structure to hold the context data of trace dump */
@@ -185,6 +209,7 @@ struct noteram_driver_s g_noteram_driver =
  * Private Functions
  ****************************************************************************/
 
+#ifndef CONFIG_DRIVERS_NOTERAM_PERCPU
 /****************************************************************************
  * Name: noteram_buffer_clear
  *
@@ -418,6 +443,359 @@ static ssize_t noteram_get(FAR struct noteram_driver_s *drv,
   return notelen;
 }
 
+#endif /* !CONFIG_DRIVERS_NOTERAM_PERCPU */
+
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+
+/****************************************************************************
+ * Name: noteram_percpu_setup
+ *
+ * Description:
+ *   Give one CPU its share of the note buffer.  Each ring is rounded down
+ *   to a power of two so that the free running positions wrap correctly.
+ *   The buffer pointer is published last, a reader skips the ring until
+ *   then.
+ *
+ ****************************************************************************/
+
+static void noteram_percpu_setup(FAR struct noteram_driver_s *drv, int cpu)
+{
+  FAR struct noteram_cpu_s *ring = &drv->ni_cpu[cpu];
+  size_t size = drv->ni_bufsize / NCPUS;
+
+  DEBUGASSERT(size > 0);
+  size = (size_t)1 << (flsl(size) - 1);
+
+  ring->mask = size - 1;
+  ring->read = 0;
+  atomic_store(&ring->head, 0);
+  atomic_store(&ring->tail, 0);
+  SP_DMB();
+  ring->buffer = drv->ni_buffer + cpu * size;
+}
+
+/****************************************************************************
+ * Name: noteram_percpu_init
+ *
+ * Description:
+ *   Split the note buffer into one ring per CPU.
+ *
+ ****************************************************************************/
+
+static void noteram_percpu_init(FAR struct noteram_driver_s *drv)
+{
+  int cpu;
+
+  for (cpu = 0; cpu < NCPUS; cpu++)
+    {
+      noteram_percpu_setup(drv, cpu);
+    }
+}
+
+/****************************************************************************
+ * Name: noteram_percpu_copy
+ *
+ * Description:
+ *   Copy len bytes at position pos out of a ring, handling wraparound.
+ *
+ ****************************************************************************/
+
+static void noteram_percpu_copy(FAR struct noteram_cpu_s *ring,
+                                unsigned int pos, FAR uint8_t *buffer,
+                                size_t len)
+{
+  unsigned int index = pos & ring->mask;
+  size_t space = ring->mask + 1 - index;
+
+  space = space < len ? space : len;
+  memcpy(buffer, ring->buffer + index, space);
+  memcpy(buffer + space, ring->buffer, len - space);
+}
+
+/****************************************************************************
+ * Name: noteram_percpu_peek
+ *
+ * Description:
+ *   Copy (at most buflen bytes of) the next unread note of a ring without
+ *   consuming it.  If the writer overwrote the unread notes, the read
+ *   position is moved to the oldest note still in the ring.
+ *
+ * Returned Value:
+ *   The length of the note, or zero if the ring is empty.
+ *
+ ****************************************************************************/
+
+static size_t noteram_percpu_peek(FAR struct noteram_cpu_s *ring,
+                                  FAR uint8_t *buffer, size_t buflen)
+{
+  unsigned int head;
+  unsigned int tail;
+  unsigned int pos;
+  size_t notelen;
+
+  if (ring->buffer == NULL)
+    {
+      return 0;
+    }
+
+  for (; ; )
+    {
+      head = atomic_load_explicit(&ring->head, memory_order_acquire);
+      tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+      pos  = ring->read;
+
+      if ((int)(pos - tail) < 0 || (int)(head - pos) < 0)
+        {
+          pos = ring->read = tail;
+        }
+
+      if (pos == head)
+        {
+          return 0;
+        }
+
+      notelen = ring->buffer[pos & ring->mask];
+      if (notelen >= sizeof(struct note_common_s))
+        {
+          noteram_percpu_copy(ring, pos, buffer,
+                              notelen < buflen ? notelen : buflen);
+        }
+
+      /* The note is valid only if the writer did not start to overwrite
+       * it while it was being copied.
+       */
+
+      SP_DSB();
+      tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+      if ((int)(pos - tail) < 0)
+        {
+          continue;
+        }
+
+      if (notelen < sizeof(struct note_common_s))
+        {
+          /* Cannot happen unless the ring is corrupted, drop the rest */
+
+          ring->read = head;
+          return 0;
+        }
+
+      return notelen;
+    }
+}
+
+/****************************************************************************
+ * Name: noteram_percpu_get
+ *
+ * Description:
+ *   Get the oldest unread note of all per-CPU rings, merging the rings by
+ *   timestamp.
+ *
+ * Returned Value:
+ *   The positive length of the note, zero if all rings are empty or a
+ *   negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static ssize_t noteram_percpu_get(FAR struct noteram_driver_s *drv,
+                                  FAR uint8_t *buffer, size_t buflen)
+{
+  FAR struct noteram_cpu_s *ring;
+  struct note_common_s note;
+  clock_t systime = 0;
+  size_t notelen;
+  int best;
+  int cpu;
+
+  do
+    {
+      best = -1;
+      for (cpu = 0; cpu < NCPUS; cpu++)
+        {
+          if (noteram_percpu_peek(&drv->ni_cpu[cpu], (FAR uint8_t *)&note,
+                                  sizeof(note)) == 0)
+            {
+              continue;
+            }
+
+          if (best < 0 || (sclock_t)(note.nc_systime - systime) < 0)
+            {
+              best    = cpu;
+              systime = note.nc_systime;
+            }
+        }
+
+      if (best < 0)
+        {
+          return 0;
+        }
+
+      ring    = &drv->ni_cpu[best];
+      notelen = noteram_percpu_peek(ring, buffer, buflen);
+    }
+  while (notelen == 0);
+
+  ring->read += NOTE_ALIGN(notelen);
+
+  /* Skip a note that does not fit so that we do not get constipated */
+
+  return notelen > buflen ? -EFBIG : (ssize_t)notelen;
+}
+
+/****************************************************************************
+ * Name: noteram_percpu_unread
+ ****************************************************************************/
+
+static bool noteram_percpu_unread(FAR struct noteram_driver_s *drv)
+{
+  int cpu;
+
+  for (cpu = 0; cpu < NCPUS; cpu++)
+    {
+      FAR struct noteram_cpu_s *ring = &drv->ni_cpu[cpu];
+
+      if (ring->read != atomic_load(&ring->head))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: noteram_percpu_rewind
+ *
+ * Description:
+ *   Move the read position of every ring back to the oldest note or, if
+ *   clear is true, drop all notes.  Clearing races benignly with writers
+ *   that overwrite old notes at the same time.
+ *
+ ****************************************************************************/
+
+static void noteram_percpu_rewind(FAR struct noteram_driver_s *drv,
+                                  bool clear)
+{
+  int cpu;
+
+  for (cpu = 0; cpu < NCPUS; cpu++)
+    {
+      FAR struct noteram_cpu_s *ring = &drv->ni_cpu[cpu];
+
+      if (clear)
+        {
+          ring->read = atomic_load(&ring->head);
+          atomic_store(&ring->tail, ring->read);
+        }
+      else
+        {
+          ring->read = atomic_load(&ring->tail);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: noteram_percpu_add
+ *
+ * Description:
+ *   Add a note to the ring of this CPU.  Only local interrupts are
+ *   disabled, no lock is taken.
+ *
+ ****************************************************************************/
+
+static bool noteram_percpu_add(FAR struct noteram_driver_s *drv,
+                               FAR const void *note, size_t notelen)
+{
+  FAR struct noteram_cpu_s *ring;
+  unsigned int alignlen = NOTE_ALIGN(notelen);
+  unsigned int index;
+  unsigned int head;
+  unsigned int tail;
+  unsigned int space;
+  irqstate_t flags;
+  bool added = false;
+
+  flags = up_irq_save();
+  ring  = &drv->ni_cpu[this_cpu()];
+
+  if (drv->ni_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
+    {
+      goto out;
+    }
+
+  /* The rings of the static driver are set up on their first note, so
+   * that notes added during boot, before noteram_register(), are kept.
+   */
+
+  if (ring->buffer == NULL)
+    {
+      noteram_percpu_setup(drv, this_cpu());
+    }
+
+  DEBUGASSERT(note != NULL && alignlen <= ring->mask);
+  head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+  tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+  if (head + alignlen - tail > ring->mask + 1)
+    {
+      if (drv->ni_overwrite == NOTERAM_MODE_OVERWRITE_DISABLE)
+        {
+          /* Stop recording if not in overwrite mode */
+
+          drv->ni_overwrite = NOTERAM_MODE_OVERWRITE_OVERFLOW;
+          goto out;
+        }
+
+      /* Drop the oldest notes and publish the new tail before their space
+       * is reused, so that a concurrent reader can detect the overwrite.
+       */
+
+      do
+        {
+          tail += NOTE_ALIGN(ring->buffer[tail & ring->mask]);
+        }
+      while (head + alignlen - tail > ring->mask + 1);
+
+      atomic_store_explicit(&ring->tail, tail, memory_order_relaxed);
+      SP_DMB();
+    }
+
+  index = head & ring->mask;
+  space = ring->mask + 1 - index;
+  space = space < notelen ? space : notelen;
+  memcpy(ring->buffer + index, note, space);
+  memcpy(ring->buffer, (FAR const uint8_t *)note + space, notelen - space);
+
+  atomic_store_explicit(&ring->head, head + alignlen, memory_order_release);
+  added = true;
+
+out:
+  up_irq_restore(flags);
+  return added;
+}
+#endif /* CONFIG_DRIVERS_NOTERAM_PERCPU */
+
+/****************************************************************************
+ * Name: noteram_next_note
+ *
+ * Description:
+ *   Get the next note to read from the note buffer(s).
+ *
+ * Assumptions:
+ *   The caller holds drv->lock.
+ *
+ ****************************************************************************/
+
+static ssize_t noteram_next_note(FAR struct noteram_driver_s *drv,
+                                 FAR uint8_t *buffer, size_t buflen)
+{
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+  return noteram_percpu_get(drv, buffer, buflen);
+#else
+  return noteram_get(drv, buffer, buflen);
+#endif
+}
+
 /****************************************************************************
  * Name: noteram_open
  ****************************************************************************/
@@ -430,7 +808,11 @@ static int noteram_open(FAR struct file *filep)
 
   /* Reset the read index of the circular buffer */
 
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+  noteram_percpu_rewind(drv, false);
+#else
   drv->ni_read = drv->ni_tail;
+#endif
   ctx = kmm_zalloc(sizeof(*ctx));
   if (ctx == NULL)
     {
@@ -466,7 +848,7 @@ static ssize_t noteram_read(FAR struct file *filep, FAR char *buffer,
   if (ctx->mode == NOTERAM_MODE_READ_BINARY)
     {
       flags = spin_lock_irqsave_wo_note(&drv->lock);
-      ret = noteram_get(drv, (FAR uint8_t *)buffer, buflen);
+      ret = noteram_next_note(drv, (FAR uint8_t *)buffer, buflen);
       spin_unlock_irqrestore_wo_note(&drv->lock, flags);
     }
   else
@@ -480,7 +862,7 @@ static ssize_t noteram_read(FAR struct file *filep, FAR char *buffer,
           /* Get the next note (removing it from the buffer) */
 
           flags = spin_lock_irqsave_wo_note(&drv->lock);
-          ret = noteram_get(drv, note, sizeof(note));
+          ret = noteram_next_note(drv, note, sizeof(note));
           spin_unlock_irqrestore_wo_note(&drv->lock, flags);
           if (ret <= 0)
             {
@@ -518,7 +900,15 @@ static int noteram_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
        */
 
       case NOTERAM_CLEAR:
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+        noteram_percpu_rewind(drv, true);
+        if (drv->ni_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
+          {
+            drv->ni_overwrite = NOTERAM_MODE_OVERWRITE_DISABLE;
+          }
+#else
         noteram_buffer_clear(drv);
+#endif
         ret = OK;
         break;
 
@@ -651,7 +1041,11 @@ static int noteram_poll(FAR struct file *filep, FAR struct pollfd *fds,
        * don't wait for RX.
        */
 
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+      if (noteram_percpu_unread(drv))
+#else
       if (noteram_unread_length(drv) > 0)
+#endif
         {
           spin_unlock_irqrestore_wo_note(&drv->lock, flags);
           poll_notify(&drv->pfd, 1, POLLIN);
@@ -686,6 +1080,18 @@ errout:
  *
  ****************************************************************************/
 
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+static void noteram_add(FAR struct note_driver_s *driver,
+                        FAR const void *note, size_t notelen)
+{
+  FAR struct noteram_driver_s *drv = (FAR struct noteram_driver_s *)driver;
+
+  if (noteram_percpu_add(drv, note, notelen))
+    {
+      poll_notify(&drv->pfd, 1, POLLIN);
+    }
+}
+#else
 static void noteram_add(FAR struct note_driver_s *driver,
                         FAR const void *note, size_t notelen)
 {
@@ -738,6 +1144,7 @@ static void noteram_add(FAR struct note_driver_s *driver,
   spin_unlock_irqrestore_wo_note(&drv->lock, flags);
   poll_notify(&drv->pfd, 1, POLLIN);
 }
+#endif
 
 /****************************************************************************
  * Name: noteram_dump_init_context
@@ -1254,7 +1661,7 @@ static void noteram_dump(FAR struct noteram_driver_s *drv)
     {
       ssize_t ret;
 
-      ret = noteram_get(drv, note, sizeof(note));
+      ret = noteram_next_note(drv, note, sizeof(note));
       if (ret <= 0)
         {
           break;
@@ -1372,6 +1779,9 @@ noteram_initialize(FAR const char *devpath, size_t bufsize, bool overwrite)
   drv->ni_tail = 0;
   drv->ni_read = 0;
   drv->pfd = NULL;
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+  noteram_percpu_init(drv);
+#endif
 
   ret = note_driver_register(&drv->driver);
   if (ret < 0)
@@ -33,6 +33,7 @@
 
 #include <nuttx/queue.h>
 #include <nuttx/wqueue.h>
+#include <nuttx/fs/aio.h>
 
 #ifdef CONFIG_FS_AIO
 
@@ -63,7 +64,7 @@ struct aio_container_s
   dq_entry_t aioc_link;            /* Supports a doubly linked list */
   FAR struct aiocb *aioc_aiocbp;   /* The contained AIO control block */
   FAR struct file *aioc_filep;     /* File structure to use with the I/O */
-  struct work_s aioc_work;         /* Used to defer I/O to the work thread */
+  struct aio_request_s aioc_req;   /* The request of the I/O engine */
   pid_t aioc_pid;                  /* ID of the waiting task */
 #ifdef CONFIG_PRIORITY_INHERITANCE
   uint8_t aioc_prio;               /* Priority of the waiting task */
@@ -206,11 +207,12 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
  * Name: aio_queue
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Submit the asynchronous I/O to the I/O engine.  The container is
+ *   decanted and the client signalled when the I/O completes.
  *
  * Input Parameters:
- *   arg - Worker argument.  In this case, a pointer to an instance of
- *     struct aiocb cast to void *.
+ *   aioc   - Pointer to the AIO control block container
+ *   opcode - The operation to perform (AIO_OP_READ, _WRITE or _FSYNC)
  *
  * Returned Value:
  *   Zero (OK) on success.  Otherwise, -1 is returned and the errno is set
@@ -218,7 +220,7 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
  *
  ****************************************************************************/
 
-int aio_queue(FAR struct aio_container_s *aioc, worker_t worker);
+int aio_queue(FAR struct aio_container_s *aioc, uint8_t opcode);
 
 /****************************************************************************
  * Name: aio_signal
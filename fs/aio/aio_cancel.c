@@ -122,14 +122,14 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
           if (aioc)
             {
               /* Yes... attempt to cancel the I/O.  There are two
-               * possibilities:* (1) the work has already been started and
-               * is no longer queued, or (2) the work has not been started
-               * and is still in the work queue.  Only the second case can
-               * be canceled.  work_cancel() will return -ENOENT in the
-               * first case.
+               * possibilities:* (1) the I/O has already been started by
+               * the driver or the worker, or (2) it is still waiting for
+               * the file to become ready or for the worker.  Only the
+               * second case can be canceled.  aio_abort() will return
+               * -EBUSY in the first case.
                */
 
-              status = work_cancel(LPWORK, &aioc->aioc_work);
+              status = aio_abort(&aioc->aioc_req);
               if (status >= 0)
                 {
                   /* Remove the container from the list of pending
@@ -179,14 +179,14 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
           if (aioc)
             {
               /* Yes... attempt to cancel the I/O.  There are two
-               * possibilities:* (1) the work has already been started and
-               * is no longer queued, or (2) the work has not been started
-               * and is still in the work queue.  Only the second case can
-               * be canceled.  work_cancel() will return -ENOENT in the
-               * first case.
+               * possibilities:* (1) the I/O has already been started by
+               * the driver or the worker, or (2) it is still waiting for
+               * the file to become ready or for the worker.  Only the
+               * second case can be canceled.  aio_abort() will return
+               * -EBUSY in the first case.
                */
 
-              status = work_cancel(LPWORK, &aioc->aioc_work);
+              status = aio_abort(&aioc->aioc_req);
               if (status >= 0)
                 {
                   /* Remove the container from the list of pending
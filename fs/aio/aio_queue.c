@@ -30,7 +30,8 @@
 #include <errno.h>
 #include <debug.h>
 
-#include <nuttx/wqueue.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/fs/aio.h>
 
 #include "aio/aio.h"
 
@@ -40,15 +41,50 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: aio_complete
+ *
+ * Description:
+ *   Called by the I/O engine when the asynchronous I/O completes.
+ *
+ ****************************************************************************/
+
+static void aio_complete(FAR struct aio_request_s *req, ssize_t result)
+{
+  FAR struct aio_container_s *aioc =
+    container_of(req, struct aio_container_s, aioc_req);
+  FAR struct aiocb *aiocbp;
+  pid_t pid;
+
+  /* Decant the AIO control block and free the container before signalling
+   * the client, so that it can queue the next I/O at once.
+   */
+
+  pid    = aioc->aioc_pid;
+  aiocbp = aioc_decant(aioc);
+  DEBUGASSERT(aiocbp);
+
+  aiocbp->aio_result = result;
+
+  /* Signal the client */
+
+  aio_signal(pid, aiocbp);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
 /****************************************************************************
  * Name: aio_queue
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Submit the asynchronous I/O to the I/O engine.  The container is
+ *   decanted and the client signalled when the I/O completes.
  *
  * Input Parameters:
- *   arg - Worker argument.  In this case, a pointer to an instance of
- *     struct aiocb cast to void *.
+ *   aioc   - Pointer to the AIO control block container
+ *   opcode - The operation to perform (AIO_OP_READ, _WRITE or _FSYNC)
  *
  * Returned Value:
  *   Zero (OK) on success.  Otherwise, -1 is returned and the errno is set
@@ -56,43 +92,32 @@
  *
  ****************************************************************************/
 
-int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
+int aio_queue(FAR struct aio_container_s *aioc, uint8_t opcode)
 {
+  FAR struct aio_request_s *req = &aioc->aioc_req;
+  FAR struct aiocb *aiocbp = aioc->aioc_aiocbp;
   int ret;
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Prohibit context switches until we complete the queuing */
-
-  sched_lock();
-
-  /* Make sure that the low-priority worker thread is running at at least
-   * the priority specified for this action.
-   */
+  DEBUGASSERT(aiocbp);
 
-  lpwork_boostpriority(aioc->aioc_prio);
+  req->opcode   = opcode;
+  req->filep    = aioc->aioc_filep;
+  req->buf      = (FAR void *)aiocbp->aio_buf;
+  req->nbytes   = aiocbp->aio_nbytes;
+  req->offset   = aiocbp->aio_offset;
+  req->complete = aio_complete;
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  req->prio     = aioc->aioc_prio;
 #endif
 
-  /* Schedule the work on the low priority worker thread */
-
-  ret = work_queue(LPWORK, &aioc->aioc_work, worker, aioc, 0);
+  ret = aio_submit(req);
   if (ret < 0)
     {
-      FAR struct aiocb *aiocbp = aioc->aioc_aiocbp;
-      DEBUGASSERT(aiocbp);
-
-#ifdef CONFIG_PRIORITY_INHERITANCE
-      lpwork_restorepriority(aioc->aioc_prio);
-#endif
       aiocbp->aio_result = ret;
       set_errno(-ret);
       ret = ERROR;
     }
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Now the low-priority work queue might run at its new priority */
-
-  sched_unlock();
-#endif
   return ret;
 }
 
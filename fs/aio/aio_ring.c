@@ -0,0 +1,597 @@
+/****************************************************************************
+ * fs/aio/aio_ring.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <sched.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <debug.h>
+#include <string.h>
+#include <strings.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/aio.h>
+#include <nuttx/mm/map.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/sched.h>
+
+#ifdef CONFIG_FS_AIO_RING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define AIO_RING_MAXENTRIES 4096
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct aio_ring_s;
+
+/* One in-flight submission entry */
+
+struct aio_ring_req_s
+{
+  struct aio_request_s          req;      /* Must be first */
+  FAR struct aio_ring_s        *ring;     /* The ring it belongs to */
+  FAR struct aio_ring_req_s    *flink;    /* Free, batch or start list */
+  FAR struct aio_ring_req_s    *link;     /* Next request of a link chain */
+  uint64_t                      user_data;
+  int                           error;    /* Set if the entry is invalid */
+};
+
+/* The state of one open of /dev/aio */
+
+struct aio_ring_s
+{
+  mutex_t                       lock;     /* Serializes the submitters */
+  spinlock_t                    spinlock; /* Protects completions */
+  sem_t                         waitsem;  /* Posted on every completion */
+  FAR struct aio_rings_s       *rings;    /* Shared with the application */
+  FAR struct aio_sqe_s         *sqes;
+  FAR struct aio_cqe_s         *cqes;
+  FAR struct aio_ring_req_s    *reqs;     /* One per submission entry */
+  FAR struct aio_ring_req_s    *freelist;
+  FAR struct aio_ring_req_s    *startlist; /* Requests waiting to start */
+  bool                          starting; /* The start list is drained */
+  uint32_t                      inflight;
+  size_t                        size;     /* Size of the shared mapping */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int aio_ring_open(FAR struct file *filep);
+static int aio_ring_close(FAR struct file *filep);
+static int aio_ring_ioctl(FAR struct file *filep, int cmd,
+                          unsigned long arg);
+static int aio_ring_mmap(FAR struct file *filep,
+                         FAR struct mm_map_entry_s *map);
+
+static void aio_ring_start(FAR struct aio_ring_req_s *r);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_aio_ring_fops =
+{
+  aio_ring_open,   /* open */
+  aio_ring_close,  /* close */
+  NULL,            /* read */
+  NULL,            /* write */
+  NULL,            /* seek */
+  aio_ring_ioctl,  /* ioctl */
+  aio_ring_mmap,   /* mmap */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_ring_complete
+ *
+ * Description:
+ *   Post the completion entry of a request and start the request linked
+ *   to it, or cancel the rest of the chain if the request failed.
+ *
+ ****************************************************************************/
+
+static void aio_ring_complete(FAR struct aio_request_s *req,
+                              ssize_t result)
+{
+  FAR struct aio_ring_req_s *r = (FAR struct aio_ring_req_s *)req;
+  FAR struct aio_ring_req_s *link = r->link;
+  FAR struct aio_ring_s *ring = r->ring;
+  FAR struct aio_rings_s *rings = ring->rings;
+  FAR struct aio_cqe_s *cqe;
+  irqstate_t flags;
+  uint32_t tail;
+
+  if (req->filep != NULL)
+    {
+      fs_putfilep(req->filep);
+    }
+
+  flags = spin_lock_irqsave(&ring->spinlock);
+
+  tail = rings->cq_tail;
+  if (tail - rings->cq_head < rings->cq_entries)
+    {
+      cqe            = &ring->cqes[tail & (rings->cq_entries - 1)];
+      cqe->user_data = r->user_data;
+      cqe->res       = result;
+      cqe->flags     = 0;
+
+      /* Publish the entry before the new tail */
+
+      SP_DMB();
+      rings->cq_tail = tail + 1;
+    }
+  else
+    {
+      rings->cq_overflow++;
+    }
+
+  r->flink       = ring->freelist;
+  ring->freelist = r;
+  ring->inflight--;
+
+  spin_unlock_irqrestore(&ring->spinlock, flags);
+  nxsem_post(&ring->waitsem);
+
+  if (link != NULL)
+    {
+      if (result < 0)
+        {
+          link->error = -ECANCELED;
+        }
+
+      aio_ring_start(link);
+    }
+}
+
+/****************************************************************************
+ * Name: aio_ring_start
+ *
+ * Description:
+ *   Start a request.  A request may complete before aio_submit() returns
+ *   and start its successor, so requests are started from a list drained
+ *   by one caller at a time instead of recursively, which could otherwise
+ *   nest as deep as the longest link chain.
+ *
+ ****************************************************************************/
+
+static void aio_ring_start(FAR struct aio_ring_req_s *r)
+{
+  FAR struct aio_ring_s *ring = r->ring;
+  irqstate_t flags;
+  int ret;
+
+  flags = spin_lock_irqsave(&ring->spinlock);
+  r->flink        = ring->startlist;
+  ring->startlist = r;
+
+  if (ring->starting)
+    {
+      spin_unlock_irqrestore(&ring->spinlock, flags);
+      return;
+    }
+
+  ring->starting = true;
+  while ((r = ring->startlist) != NULL)
+    {
+      ring->startlist = r->flink;
+      spin_unlock_irqrestore(&ring->spinlock, flags);
+
+      ret = r->error;
+      if (ret >= 0)
+        {
+          ret = aio_submit(&r->req);
+        }
+
+      if (ret < 0)
+        {
+          aio_ring_complete(&r->req, ret);
+        }
+
+      flags = spin_lock_irqsave(&ring->spinlock);
+    }
+
+  ring->starting = false;
+  spin_unlock_irqrestore(&ring->spinlock, flags);
+}
+
+/****************************************************************************
+ * Name: aio_ring_prepare
+ *
+ * Description:
+ *   Take one submission entry and turn it into a request.
+ *
+ ****************************************************************************/
+
+static void aio_ring_prepare(FAR struct aio_ring_s *ring,
+                             FAR struct aio_ring_req_s *r,
+                             FAR const struct aio_sqe_s *sqe, uint8_t prio)
+{
+  FAR struct aio_request_s *req = &r->req;
+
+  memset(r, 0, sizeof(*r));
+  r->ring       = ring;
+  r->user_data  = sqe->user_data;
+
+  req->opcode   = sqe->opcode;
+  req->buf      = sqe->buf;
+  req->nbytes   = sqe->len;
+  req->offset   = sqe->offset;
+  req->complete = aio_ring_complete;
+  req->prio     = prio;
+
+  if (sqe->opcode > AIO_OP_FSYNC)
+    {
+      r->error = -EINVAL;
+    }
+  else if ((sqe->opcode == AIO_OP_READ || sqe->opcode == AIO_OP_WRITE) &&
+           sqe->offset < 0)
+    {
+      r->error = -EINVAL;
+    }
+  else if (sqe->opcode != AIO_OP_NOP)
+    {
+      r->error = fs_getfilep(sqe->fd, &req->filep);
+      if (r->error < 0)
+        {
+          req->filep = NULL;
+          return;
+        }
+
+      /* The file must have been opened for the transfer, drivers with an
+       * aio method are called without going through file_read/write().
+       */
+
+      if ((sqe->opcode == AIO_OP_READ &&
+           (req->filep->f_oflags & O_RDOK) == 0) ||
+          (sqe->opcode == AIO_OP_WRITE &&
+           (req->filep->f_oflags & O_WROK) == 0))
+        {
+          r->error = -EBADF;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: aio_ring_setup
+ ****************************************************************************/
+
+static int aio_ring_setup(FAR struct aio_ring_s *ring,
+                          FAR struct aio_params_s *params)
+{
+  FAR struct aio_rings_s *rings;
+  uint32_t sq_entries;
+  uint32_t cq_entries;
+  size_t sq_off;
+  size_t cq_off;
+  size_t size;
+  uint32_t i;
+
+  if (ring->rings != NULL)
+    {
+      return -EBUSY;
+    }
+
+  if (params->sq_entries == 0 || params->sq_entries > AIO_RING_MAXENTRIES)
+    {
+      return -EINVAL;
+    }
+
+  sq_entries = 1 << fls(params->sq_entries - 1);
+  cq_entries = 2 * sq_entries;
+
+  sq_off = ALIGN_UP(sizeof(struct aio_rings_s), sizeof(uint64_t));
+  cq_off = sq_off + sq_entries * sizeof(struct aio_sqe_s);
+  size   = cq_off + cq_entries * sizeof(struct aio_cqe_s);
+
+  /* The rings are accessed by the application, allocate them from the
+   * user heap.
+   */
+
+  rings = kumm_zalloc(size);
+  if (rings == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ring->reqs = kmm_zalloc(sq_entries * sizeof(struct aio_ring_req_s));
+  if (ring->reqs == NULL)
+    {
+      kumm_free(rings);
+      return -ENOMEM;
+    }
+
+  for (i = 0; i < sq_entries; i++)
+    {
+      ring->reqs[i].flink = ring->freelist;
+      ring->freelist      = &ring->reqs[i];
+    }
+
+  rings->sq_entries = sq_entries;
+  rings->sq_off     = sq_off;
+  rings->cq_entries = cq_entries;
+  rings->cq_off     = cq_off;
+
+  ring->sqes  = (FAR struct aio_sqe_s *)((FAR char *)rings + sq_off);
+  ring->cqes  = (FAR struct aio_cqe_s *)((FAR char *)rings + cq_off);
+  ring->size  = size;
+  ring->rings = rings;
+
+  params->sq_entries = sq_entries;
+  params->cq_entries = cq_entries;
+  params->size       = size;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aio_ring_enter
+ *
+ * Description:
+ *   Submit up to enter->to_submit entries as one batch, then wait for
+ *   enter->min_complete completion entries.  The requests of a link chain
+ *   are all prepared before the head of the chain is started, so the chain
+ *   is complete by the time the head completes.
+ *
+ ****************************************************************************/
+
+static int aio_ring_enter(FAR struct aio_ring_s *ring,
+                          FAR const struct aio_enter_s *enter)
+{
+  FAR struct aio_rings_s *rings = ring->rings;
+  FAR struct aio_ring_req_s *heads = NULL;
+  FAR struct aio_ring_req_s **tail = &heads;
+  FAR struct aio_ring_req_s *prev = NULL;
+  FAR struct aio_sqe_s *sqe;
+  FAR struct aio_ring_req_s *r;
+  struct sched_param param;
+  irqstate_t flags;
+  uint32_t head;
+  int nsubmit = 0;
+  int ret;
+
+  if (rings == NULL)
+    {
+      return -EINVAL;
+    }
+
+  /* The requests run at the priority of the submitter */
+
+  nxsched_get_param(0, &param);
+
+  head = rings->sq_head;
+  while (nsubmit < enter->to_submit && head != rings->sq_tail)
+    {
+      flags = spin_lock_irqsave(&ring->spinlock);
+      r = ring->freelist;
+      if (r != NULL)
+        {
+          ring->freelist = r->flink;
+          ring->inflight++;
+        }
+
+      spin_unlock_irqrestore(&ring->spinlock, flags);
+      if (r == NULL)
+        {
+          break;
+        }
+
+      /* Read the entry only after the tail that published it */
+
+      SP_DMB();
+      sqe = &ring->sqes[head & (rings->sq_entries - 1)];
+      aio_ring_prepare(ring, r, sqe, param.sched_priority);
+
+      if (prev != NULL)
+        {
+          prev->link = r;
+        }
+      else
+        {
+          *tail = r;
+          tail  = &r->flink;
+        }
+
+      prev = (sqe->flags & AIO_SQE_LINK) != 0 ? r : NULL;
+      rings->sq_head = ++head;
+      nsubmit++;
+    }
+
+  /* Start the heads of all chains of the batch */
+
+  while (heads != NULL)
+    {
+      r     = heads;
+      heads = r->flink;
+      aio_ring_start(r);
+    }
+
+  /* Wait for completions */
+
+  while (rings->cq_tail - rings->cq_head < enter->min_complete &&
+         ring->inflight > 0)
+    {
+      ret = nxsem_wait(&ring->waitsem);
+      if (ret < 0)
+        {
+          return nsubmit > 0 ? nsubmit : ret;
+        }
+    }
+
+  return nsubmit;
+}
+
+/****************************************************************************
+ * Name: aio_ring_open
+ ****************************************************************************/
+
+static int aio_ring_open(FAR struct file *filep)
+{
+  FAR struct aio_ring_s *ring;
+
+  ring = kmm_zalloc(sizeof(struct aio_ring_s));
+  if (ring == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  nxmutex_init(&ring->lock);
+  spin_lock_init(&ring->spinlock);
+  nxsem_init(&ring->waitsem, 0, 0);
+
+  filep->f_priv = ring;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aio_ring_close
+ *
+ * Description:
+ *   Cancel the requests that have not started yet, which may be waiting
+ *   for a file that never becomes ready, and wait for the rest of the
+ *   requests in flight, they still reference the rings.
+ *
+ ****************************************************************************/
+
+static int aio_ring_close(FAR struct file *filep)
+{
+  FAR struct aio_ring_s *ring = filep->f_priv;
+  uint32_t i;
+
+  if (ring->rings != NULL)
+    {
+      for (i = 0; i < ring->rings->sq_entries; i++)
+        {
+          if (aio_abort(&ring->reqs[i].req) == OK)
+            {
+              aio_ring_complete(&ring->reqs[i].req, -ECANCELED);
+            }
+        }
+    }
+
+  while (ring->inflight > 0)
+    {
+      nxsem_wait_uninterruptible(&ring->waitsem);
+    }
+
+  if (ring->rings != NULL)
+    {
+      kumm_free(ring->rings);
+      kmm_free(ring->reqs);
+    }
+
+  nxsem_destroy(&ring->waitsem);
+  nxmutex_destroy(&ring->lock);
+  kmm_free(ring);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aio_ring_ioctl
+ ****************************************************************************/
+
+static int aio_ring_ioctl(FAR struct file *filep, int cmd,
+                          unsigned long arg)
+{
+  FAR struct aio_ring_s *ring = filep->f_priv;
+  int ret;
+
+  ret = nxmutex_lock(&ring->lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  switch (cmd)
+    {
+      case AIOC_SETUP:
+        ret = aio_ring_setup(ring,
+                             (FAR struct aio_params_s *)(uintptr_t)arg);
+        break;
+
+      case AIOC_ENTER:
+        ret = aio_ring_enter(ring,
+                             (FAR const struct aio_enter_s *)(uintptr_t)arg);
+        break;
+
+      default:
+        ret = -ENOTTY;
+        break;
+    }
+
+  nxmutex_unlock(&ring->lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: aio_ring_mmap
+ ****************************************************************************/
+
+static int aio_ring_mmap(FAR struct file *filep,
+                         FAR struct mm_map_entry_s *map)
+{
+  FAR struct aio_ring_s *ring = filep->f_priv;
+
+  if (ring->rings == NULL || map->offset < 0 || map->length == 0 ||
+      map->offset + map->length > ring->size)
+    {
+      return -EINVAL;
+    }
+
+  map->vaddr = (FAR char *)ring->rings + map->offset;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_ring_register
+ ****************************************************************************/
+
+int aio_ring_register(void)
+{
+  return register_driver("/dev/aio", &g_aio_ring_fops, 0666, NULL);
+}
+
+#endif /* CONFIG_FS_AIO_RING */
@@ -0,0 +1,393 @@
+/****************************************************************************
+ * fs/aio/aio_submit.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+#include <string.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/aio.h>
+
+#ifdef CONFIG_FS_AIO
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Request states */
+
+#define AIO_STATE_IDLE      0  /* Not submitted or completed */
+#define AIO_STATE_DRIVER    1  /* Owned by the driver (driver aio method) */
+#define AIO_STATE_POLL      2  /* Waiting for the file to become ready */
+#define AIO_STATE_READY     3  /* Ready, queued to the worker */
+#define AIO_STATE_QUEUED    4  /* Queued to the worker, blocking I/O */
+#define AIO_STATE_RUNNING   5  /* Running on the worker */
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_pollable
+ *
+ * Description:
+ *   Return true if the file is a stream (socket, pipe or a driver without
+ *   a file position) whose readiness can be waited for with poll.
+ *
+ ****************************************************************************/
+
+static bool aio_pollable(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+
+  if (inode == NULL)
+    {
+      return false;
+    }
+
+  if (INODE_IS_SOCKET(inode) || INODE_IS_PIPE(inode))
+    {
+      return true;
+    }
+
+  return INODE_IS_DRIVER(inode) && inode->u.i_ops != NULL &&
+         inode->u.i_ops->poll != NULL && inode->u.i_ops->seek == NULL;
+}
+
+/****************************************************************************
+ * Name: aio_driver
+ *
+ * Description:
+ *   Hand the request to the aio method of the driver, if it has one.
+ *
+ ****************************************************************************/
+
+static int aio_driver(FAR struct aio_request_s *req)
+{
+  FAR struct inode *inode = req->filep->f_inode;
+
+  if (inode == NULL || !INODE_IS_DRIVER(inode) || inode->u.i_ops == NULL ||
+      inode->u.i_ops->aio == NULL)
+    {
+      return -ENOTTY;
+    }
+
+  return inode->u.i_ops->aio(req->filep, req);
+}
+
+/****************************************************************************
+ * Name: aio_complete
+ ****************************************************************************/
+
+static void aio_complete(FAR struct aio_request_s *req, ssize_t result)
+{
+  req->state = AIO_STATE_IDLE;
+  req->complete(req, result);
+}
+
+/****************************************************************************
+ * Name: aio_done_worker
+ *
+ * Description:
+ *   Deliver a completion reported from interrupt context.
+ *
+ ****************************************************************************/
+
+static void aio_done_worker(FAR void *arg)
+{
+  FAR struct aio_request_s *req = arg;
+
+  aio_complete(req, req->result);
+}
+
+/****************************************************************************
+ * Name: aio_worker
+ *
+ * Description:
+ *   Perform the request on the worker thread.  Streams are only queued
+ *   here once they are ready, so the transfer does not block.
+ *
+ ****************************************************************************/
+
+static void aio_worker(FAR void *arg)
+{
+  FAR struct aio_request_s *req = arg;
+  FAR struct file *filep = req->filep;
+  irqstate_t flags;
+  ssize_t ret;
+  bool stream;
+
+  flags      = enter_critical_section();
+  stream     = req->state == AIO_STATE_READY;
+  req->state = AIO_STATE_RUNNING;
+  leave_critical_section(flags);
+
+  if (stream)
+    {
+      file_poll(filep, &req->fds, false);
+    }
+
+  switch (req->opcode)
+    {
+      case AIO_OP_READ:
+        if (stream)
+          {
+            ret = file_read(filep, req->buf, req->nbytes);
+          }
+        else
+          {
+            ret = file_pread(filep, req->buf, req->nbytes, req->offset);
+          }
+        break;
+
+      case AIO_OP_WRITE:
+        if (stream || (filep->f_oflags & O_APPEND) != 0)
+          {
+            ret = file_write(filep, req->buf, req->nbytes);
+          }
+        else
+          {
+            ret = file_pwrite(filep, req->buf, req->nbytes, req->offset);
+          }
+        break;
+
+      case AIO_OP_FSYNC:
+        ret = file_fsync(filep);
+        break;
+
+      default:
+        ret = -EINVAL;
+        break;
+    }
+
+  if (ret < 0)
+    {
+      ferr("ERROR: aio operation %d failed: %zd\n", req->opcode, ret);
+    }
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  if (!stream)
+    {
+      /* Restore the low priority worker thread default priority */
+
+      lpwork_restorepriority(req->prio);
+    }
+#endif
+
+  aio_complete(req, ret);
+}
+
+/****************************************************************************
+ * Name: aio_poll_cb
+ *
+ * Description:
+ *   The stream became ready, queue the transfer to the worker.  Runs in
+ *   the context of the driver that reported the event.
+ *
+ ****************************************************************************/
+
+static void aio_poll_cb(FAR struct pollfd *fds)
+{
+  FAR struct aio_request_s *req = fds->arg;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (req->state == AIO_STATE_POLL)
+    {
+      req->state = AIO_STATE_READY;
+      work_queue(LPWORK, &req->work, aio_worker, req, 0);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: aio_queue_worker
+ *
+ * Description:
+ *   Run the request on the low priority work queue, which is boosted to
+ *   the priority of the submitter.
+ *
+ ****************************************************************************/
+
+static int aio_queue_worker(FAR struct aio_request_s *req)
+{
+  int ret;
+
+  req->state = AIO_STATE_QUEUED;
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  /* Prohibit context switches until we complete the queuing */
+
+  sched_lock();
+
+  /* Make sure that the low-priority worker thread is running at at least
+   * the priority specified for this action.
+   */
+
+  lpwork_boostpriority(req->prio);
+#endif
+
+  ret = work_queue(LPWORK, &req->work, aio_worker, req, 0);
+  if (ret < 0)
+    {
+#ifdef CONFIG_PRIORITY_INHERITANCE
+      lpwork_restorepriority(req->prio);
+#endif
+      req->state = AIO_STATE_IDLE;
+    }
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  sched_unlock();
+#endif
+
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_submit
+ ****************************************************************************/
+
+int aio_submit(FAR struct aio_request_s *req)
+{
+  int ret;
+
+  DEBUGASSERT(req != NULL && req->complete != NULL);
+
+  if (req->opcode == AIO_OP_NOP)
+    {
+      aio_complete(req, 0);
+      return OK;
+    }
+
+  if (req->opcode == AIO_OP_READ || req->opcode == AIO_OP_WRITE)
+    {
+      /* Let the driver take the request if it can complete it without a
+       * thread.
+       */
+
+      req->state = AIO_STATE_DRIVER;
+      ret = aio_driver(req);
+      if (ret == OK)
+        {
+          return OK;
+        }
+
+      /* Wait for streams to become ready instead of blocking a worker
+       * until they are.
+       */
+
+      if (aio_pollable(req->filep))
+        {
+          memset(&req->fds, 0, sizeof(req->fds));
+          req->fds.events = req->opcode == AIO_OP_READ ? POLLIN : POLLOUT;
+          req->fds.arg    = req;
+          req->fds.cb     = aio_poll_cb;
+          req->state      = AIO_STATE_POLL;
+
+          ret = file_poll(req->filep, &req->fds, true);
+          if (ret >= 0)
+            {
+              return OK;
+            }
+        }
+    }
+
+  return aio_queue_worker(req);
+}
+
+/****************************************************************************
+ * Name: aio_done
+ ****************************************************************************/
+
+void aio_done(FAR struct aio_request_s *req, ssize_t result)
+{
+  DEBUGASSERT(req->state == AIO_STATE_DRIVER);
+
+  if (up_interrupt_context())
+    {
+      req->result = result;
+      work_queue(LPWORK, &req->work, aio_done_worker, req, 0);
+    }
+  else
+    {
+      aio_complete(req, result);
+    }
+}
+
+/****************************************************************************
+ * Name: aio_abort
+ ****************************************************************************/
+
+int aio_abort(FAR struct aio_request_s *req)
+{
+  irqstate_t flags;
+  uint8_t state;
+  int ret = -EBUSY;
+
+  flags = enter_critical_section();
+  state = req->state;
+  if (state == AIO_STATE_POLL)
+    {
+      req->state = AIO_STATE_IDLE;
+      ret = OK;
+    }
+  else if ((state == AIO_STATE_READY || state == AIO_STATE_QUEUED) &&
+           work_cancel(LPWORK, &req->work) >= 0)
+    {
+      req->state = AIO_STATE_IDLE;
+      ret = OK;
+    }
+
+  leave_critical_section(flags);
+
+  if (ret == OK && state != AIO_STATE_QUEUED)
+    {
+      file_poll(req->filep, &req->fds, false);
+    }
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  if (ret == OK && state == AIO_STATE_QUEUED)
+    {
+      lpwork_restorepriority(req->prio);
+    }
+#endif
+
+  return ret;
+}
+
+#endif /* CONFIG_FS_AIO */
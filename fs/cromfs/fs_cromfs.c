@@ -39,6 +39,7 @@
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
 
@@ -69,9 +70,18 @@ struct cromfs_dir_s
 struct cromfs_file_s
 {
   FAR const struct cromfs_node_s *ff_node;  /* The open file node */
-  uint32_t ff_offset;                       /* Cached block offset (zero means none) */
-  uint16_t ff_ulen;                         /* Length of decompressed data in cache */
-  FAR uint8_t *ff_buffer;                   /* Cached, decompressed data */
+  FAR struct lzf_header_s *ff_blkhdr;       /* Last block read (NULL: none) */
+  uint32_t ff_blkoffs;                      /* File offset of that block */
+};
+
+/* One decompressed block in the block cache */
+
+struct cromfs_cache_s
+{
+  uint32_t cc_offset;                       /* Block offset (zero means none) */
+  uint32_t cc_lru;                          /* Time of the last use */
+  uint16_t cc_ulen;                         /* Length of decompressed data */
+  FAR uint8_t *cc_buffer;                   /* Decompressed data */
 };
 
 /* This is the form of the callback from cromfs_foreach_node(): */
@@ -226,6 +236,16 @@ const struct mountpt_operations g_cromfs_operations =
 
 extern const struct cromfs_volume_s g_cromfs_image;
 
+/* The decompressed blocks shared by all open files.  Repeated small reads
+ * of the same compressed block are served from here instead of inflating
+ * the block again.
+ */
+
+static struct cromfs_cache_s g_cromfs_cache[CONFIG_FS_CROMFS_CACHE_NBLOCKS];
+static mutex_t g_cromfs_cache_lock = NXMUTEX_INITIALIZER;
+static uint32_t g_cromfs_cache_clock;
+static unsigned int g_cromfs_nmounts;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -724,6 +744,98 @@ static int cromfs_find_node(FAR const struct cromfs_volume_s *fs,
     }
 }
 
+/****************************************************************************
+ * Name: cromfs_cache_read
+ *
+ * Description:
+ *   Copy data from a compressed block, decompressing the block into the
+ *   block cache unless it is already there.
+ *
+ ****************************************************************************/
+
+static int cromfs_cache_read(FAR const struct cromfs_volume_s *fs,
+                             FAR const uint8_t *src, uint16_t clen,
+                             FAR uint8_t *dest, unsigned int copyoffs,
+                             unsigned int copysize)
+{
+  FAR struct cromfs_cache_s *victim = NULL;
+  FAR struct cromfs_cache_s *cc;
+  uint32_t voloffs;
+  int ret;
+  int i;
+
+  voloffs = cromfs_addr2offset(fs, src);
+
+  ret = nxmutex_lock(&g_cromfs_cache_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (i = 0; i < CONFIG_FS_CROMFS_CACHE_NBLOCKS; i++)
+    {
+      cc = &g_cromfs_cache[i];
+      if (cc->cc_offset == voloffs && cc->cc_buffer != NULL)
+        {
+          break;
+        }
+
+      if (victim == NULL || cc->cc_buffer == NULL ||
+          (victim->cc_buffer != NULL && cc->cc_lru < victim->cc_lru))
+        {
+          victim = cc;
+        }
+    }
+
+  if (i >= CONFIG_FS_CROMFS_CACHE_NBLOCKS)
+    {
+      /* Not cached, decompress the block in place of the least recently
+       * used one.
+       */
+
+      cc = victim;
+      if (cc->cc_buffer == NULL)
+        {
+          cc->cc_buffer = fs_heap_malloc(fs->cv_bsize);
+          if (cc->cc_buffer == NULL)
+            {
+              nxmutex_unlock(&g_cromfs_cache_lock);
+              return -ENOMEM;
+            }
+        }
+
+      cc->cc_ulen   = lzf_decompress(src, clen, cc->cc_buffer,
+                                     fs->cv_bsize);
+      cc->cc_offset = voloffs;
+    }
+
+  finfo("voloffs=%" PRIu32 " cached=%d copyoffs=%u copysize=%u\n",
+        voloffs, i < CONFIG_FS_CROMFS_CACHE_NBLOCKS, copyoffs, copysize);
+  DEBUGASSERT(cc->cc_ulen >= (copyoffs + copysize));
+
+  cc->cc_lru = ++g_cromfs_cache_clock;
+  memcpy(dest, &cc->cc_buffer[copyoffs], copysize);
+
+  nxmutex_unlock(&g_cromfs_cache_lock);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: cromfs_cache_purge
+ ****************************************************************************/
+
+static void cromfs_cache_purge(void)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FS_CROMFS_CACHE_NBLOCKS; i++)
+    {
+      fs_heap_free(g_cromfs_cache[i].cc_buffer);
+      g_cromfs_cache[i].cc_buffer = NULL;
+      g_cromfs_cache[i].cc_offset = 0;
+    }
+}
+
 /****************************************************************************
  * Name: cromfs_open
  ****************************************************************************/
@@ -792,15 +904,6 @@ static int cromfs_open(FAR struct file *filep, FAR const char *relpath,
       return -ENOMEM;
     }
 
-  /* Create a file buffer to support partial sector accesses */
-
-  ff->ff_buffer = fs_heap_malloc(fs->cv_bsize);
-  if (!ff->ff_buffer)
-    {
-      fs_heap_free(ff);
-      return -ENOMEM;
-    }
-
   /* Save the node in the open file instance */
 
   ff->ff_node = (FAR const struct cromfs_node_s *)
@@ -826,11 +929,10 @@ static int cromfs_close(FAR struct file *filep)
   /* Get the open file instance from the file structure */
 
   ff = filep->f_priv;
-  DEBUGASSERT(ff->ff_node != NULL && ff->ff_buffer != NULL);
+  DEBUGASSERT(ff->ff_node != NULL);
 
   /* Free all resources consumed by the opened file */
 
-  fs_heap_free(ff->ff_buffer);
   fs_heap_free(ff);
 
   return OK;
@@ -857,6 +959,7 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
   uint16_t clen;
   unsigned int copysize;
   unsigned int copyoffs;
+  int ret;
 
   finfo("Read %zu bytes from offset %jd\n", buflen, (intmax_t)filep->f_pos);
   DEBUGASSERT(filep->f_priv != NULL);
@@ -872,7 +975,7 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
   /* Get the open file instance from the file structure */
 
   ff = (FAR struct cromfs_file_s *)filep->f_priv;
-  DEBUGASSERT(ff->ff_node != NULL && ff->ff_buffer != NULL);
+  DEBUGASSERT(ff->ff_node != NULL);
 
   /* Check for a read past the end of the file */
 
@@ -903,6 +1006,16 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
   nexthdr   = (FAR struct lzf_header_s *)
                cromfs_offset2addr(fs, ff->ff_node->u.cn_blocks);
 
+  /* Resume the search from the block of the previous read, sequential
+   * reads do not need to walk the block headers from the start each time.
+   */
+
+  if (ff->ff_blkhdr != NULL && fpos >= ff->ff_blkoffs)
+    {
+      nexthdr = ff->ff_blkhdr;
+      blkoffs = ff->ff_blkoffs;
+    }
+
   /* Look until we find the compressed block containing the start of the
    * requested data.
    */
@@ -984,42 +1097,18 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
            * buffer, then we can decompress directly into the user buffer.
            */
 
+          src = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
           if (filep->f_pos <= blkoffs && ulen <= remaining)
             {
-              uint32_t voloffs;
-
-              copyoffs = 0;
-              copysize = ulen;
-
-              /* Get the address and offset in the CROMFS image to obtain
-               * the data.  Check if we already have this offset in the
-               * cache.
-               */
-
-              src     = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
-              voloffs = cromfs_addr2offset(fs, src);
-              if (voloffs != ff->ff_offset)
-                {
-                  unsigned int decomplen;
-
-                  decomplen = lzf_decompress(src, clen, dest, fs->cv_bsize);
+              copysize = lzf_decompress(src, clen, dest, fs->cv_bsize);
 
-                  ff->ff_offset = voloffs;
-                  ff->ff_ulen   = decomplen;
-                }
-
-              finfo("voloffs=%" PRIu32 " blkoffs=%" PRIu32
-                    " ulen=%" PRIu16 " ff_offset=%" PRIu32 " copysize=%u\n",
-                    voloffs, blkoffs, ulen, ff->ff_offset, copysize);
-              DEBUGASSERT(ff->ff_ulen >= copysize);
+              finfo("blkoffs=%" PRIu32 " ulen=%" PRIu16 " copysize=%u\n",
+                    blkoffs, ulen, copysize);
+              DEBUGASSERT(copysize == ulen);
             }
           else
             {
-              uint32_t voloffs;
-
-              /* No, we will need to decompress into the our intermediate
-               * decompression buffer.
-               */
+              /* No, we will need to go through the block cache */
 
               copyoffs = (blkoffs >= filep->f_pos) ?
                             0 : filep->f_pos - blkoffs;
@@ -1035,29 +1124,17 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
 
               DEBUGASSERT((copyoffs + copysize) <=  fs->cv_bsize);
 
-              src = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
-              voloffs = cromfs_addr2offset(fs, src);
-              if (voloffs != ff->ff_offset)
+              ret = cromfs_cache_read(fs, src, clen, dest, copyoffs,
+                                      copysize);
+              if (ret < 0)
                 {
-                  unsigned int decomplen;
-
-                  decomplen = lzf_decompress(src, clen, ff->ff_buffer,
-                                             fs->cv_bsize);
+                  if (remaining == buflen)
+                    {
+                      return ret;
+                    }
 
-                  ff->ff_offset = voloffs;
-                  ff->ff_ulen   = decomplen;
+                  break;
                 }
-
-              finfo("voloffs=%" PRIu32 " blkoffs=%" PRIu32 " ulen=%" PRIu16
-                    " clen=%" PRIu16 " ff_offset=%" PRIu32
-                    "  copyoffs=%u copysize=%u\n",
-                    voloffs, blkoffs, ulen, clen, ff->ff_offset,
-                    copyoffs, copysize);
-              DEBUGASSERT(ff->ff_ulen >= (copyoffs + copysize));
-
-              /* Then copy to user buffer */
-
-              memcpy(dest, &ff->ff_buffer[copyoffs], copysize);
             }
         }
 
@@ -1068,10 +1145,18 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
       fpos      += copysize;
     }
 
-  /* Update the file pointer */
+  /* Remember the last block for the next read and update the file
+   * pointer
+   */
+
+  if (buflen > 0)
+    {
+      ff->ff_blkhdr  = currhdr;
+      ff->ff_blkoffs = blkoffs;
+    }
 
   filep->f_pos = fpos;
-  return buflen;
+  return buflen - remaining;
 }
 
 /****************************************************************************
@@ -1113,7 +1198,7 @@ static int cromfs_dup(FAR const struct file *oldp, FAR struct file *newp)
   /* Get the open file instance from the file structure */
 
   oldff = oldp->f_priv;
-  DEBUGASSERT(oldff->ff_node != NULL && oldff->ff_buffer != NULL);
+  DEBUGASSERT(oldff->ff_node != NULL);
 
   /* Allocate and initialize an new open file instance referring to the
    * same node.
@@ -1125,15 +1210,6 @@ static int cromfs_dup(FAR const struct file *oldp, FAR struct file *newp)
       return -ENOMEM;
     }
 
-  /* Create a file buffer to support partial sector accesses */
-
-  newff->ff_buffer = fs_heap_malloc(fs->cv_bsize);
-  if (newff->ff_buffer == NULL)
-    {
-      fs_heap_free(newff);
-      return -ENOMEM;
-    }
-
   /* Save the node in the open file instance */
 
   newff->ff_node = oldff->ff_node;
@@ -1170,7 +1246,7 @@ static int cromfs_fstat(FAR const struct file *filep, FAR struct stat *buf)
    */
 
   ff              = filep->f_priv;
-  DEBUGASSERT(ff->ff_node != NULL && ff->ff_buffer != NULL);
+  DEBUGASSERT(ff->ff_node != NULL);
 
   inode           = filep->f_inode;
   fs              = inode->i_private;
@@ -1432,6 +1508,10 @@ static int cromfs_bind(FAR struct inode *blkdriver, FAR const void *data,
   DEBUGASSERT(blkdriver == NULL && handle != NULL);
   DEBUGASSERT(g_cromfs_image.cv_magic == CROMFS_MAGIC);
 
+  nxmutex_lock(&g_cromfs_cache_lock);
+  g_cromfs_nmounts++;
+  nxmutex_unlock(&g_cromfs_cache_lock);
+
   /* Return the new file system handle */
 
   *handle = (FAR void *)&g_cromfs_image;
@@ -1451,6 +1531,16 @@ static int cromfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
 {
   finfo("handle: %p blkdriver: %p flags: %02x\n",
         handle, blkdriver, flags);
+
+  /* Release the block cache with the last mount */
+
+  nxmutex_lock(&g_cromfs_cache_lock);
+  if (--g_cromfs_nmounts == 0)
+    {
+      cromfs_cache_purge();
+    }
+
+  nxmutex_unlock(&g_cromfs_cache_lock);
   return OK;
 }
 
@@ -88,6 +88,8 @@ void fs_initialize(void)
 
   inode_initialize();
 
+  files_initialize();
+
   file_initlk();
 
 #ifdef CONFIG_FS_AIO
@@ -236,6 +236,33 @@ static void hostfs_mkpath(FAR struct hostfs_mountpt_s  *fs,
     }
 }
 
+/****************************************************************************
+ * Name: hostfs_fill
+ *
+ * Description:
+ *   Page cache fill callback.  host_read() reads at the host file position,
+ *   so position it first; hostfs_write() and hostfs_seek() therefore never
+ *   rely on the host file position when the page cache is enabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_PAGECACHE
+static ssize_t hostfs_fill(FAR void *arg, FAR char *buffer, off_t offset,
+                           size_t buflen)
+{
+  FAR struct hostfs_ofile_s *hf = arg;
+  off_t ret;
+
+  ret = host_lseek(hf->fd, 0, offset, SEEK_SET);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return host_read(hf->fd, buffer, buflen);
+}
+#endif
+
 /****************************************************************************
  * Name: hostfs_open
  ****************************************************************************/
@@ -246,6 +273,9 @@ static int hostfs_open(FAR struct file *filep, FAR const char *relpath,
   FAR struct inode *inode;
   FAR struct hostfs_mountpt_s *fs;
   FAR struct hostfs_ofile_s  *hf;
+#ifdef CONFIG_FS_PAGECACHE
+  struct stat buf;
+#endif
   char path[HOSTFS_MAX_PATH];
   size_t len;
   int ret;
@@ -323,6 +353,24 @@ static int hostfs_open(FAR struct file *filep, FAR const char *relpath,
    * (but a simple reference count could have done that).
    */
 
+#ifdef CONFIG_FS_PAGECACHE
+  /* Cache regular files, keyed by the host inode and versioned by its
+   * modification time and size.  Handles that cannot read still need the
+   * key, their writes invalidate the pages read through other handles.
+   * Semihosting and Windows hosts report no inode number or time, every
+   * file would share one key, so those files are not cached.
+   */
+
+  pagecache_open(&hf->cache, NULL, 0, 0);
+  if (host_fstat(hf->fd, &buf) >= 0 && S_ISREG(buf.st_mode) &&
+      buf.st_ino != 0 && (buf.st_mtim.tv_sec != 0 ||
+                          buf.st_mtim.tv_nsec != 0))
+    {
+      pagecache_open(&hf->cache, fs, buf.st_ino,
+                     pagecache_version(&buf.st_mtim, buf.st_size));
+    }
+#endif
+
   hf->fnext = fs->fs_head;
   hf->crefs = 1;
   hf->oflags = oflags;
@@ -468,7 +516,12 @@ static ssize_t hostfs_read(FAR struct file *filep, FAR char *buffer,
 
   /* Call the host to perform the read */
 
+#ifdef CONFIG_FS_PAGECACHE
+  ret = pagecache_read(&hf->cache, buffer, buflen, filep->f_pos,
+                       hostfs_fill, hf);
+#else
   ret = host_read(hf->fd, buffer, buflen);
+#endif
   if (ret > 0)
     {
       filep->f_pos += ret;
@@ -518,6 +571,20 @@ static ssize_t hostfs_write(FAR struct file *filep, const char *buffer,
       goto errout_with_lock;
     }
 
+#ifdef CONFIG_FS_PAGECACHE
+  /* The host file position may have been moved by a page cache fill */
+
+  pagecache_invalidate(&hf->cache);
+  if ((hf->oflags & O_APPEND) == 0)
+    {
+      ret = host_lseek(hf->fd, 0, filep->f_pos, SEEK_SET);
+      if (ret < 0)
+        {
+          goto errout_with_lock;
+        }
+    }
+#endif
+
   /* Call the host to perform the write */
 
   ret = host_write(hf->fd, buffer, buflen);
@@ -562,6 +629,16 @@ static off_t hostfs_seek(FAR struct file *filep, off_t offset, int whence)
       return ret;
     }
 
+#ifdef CONFIG_FS_PAGECACHE
+  /* The host file position may have been moved by a page cache fill */
+
+  if (whence == SEEK_CUR)
+    {
+      offset += filep->f_pos;
+      whence  = SEEK_SET;
+    }
+#endif
+
   /* Call our internal routine to perform the seek */
 
   ret = host_lseek(hf->fd, filep->f_pos, offset, whence);
@@ -830,6 +907,9 @@ static int hostfs_ftruncate(FAR struct file *filep, off_t length)
 
   /* Call the host to perform the truncate */
 
+#ifdef CONFIG_FS_PAGECACHE
+  pagecache_invalidate(&hf->cache);
+#endif
   ret = host_ftruncate(hf->fd, length);
 
   nxmutex_unlock(&g_lock);
@@ -1151,6 +1231,9 @@ static int hostfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
     }
 
   nxmutex_unlock(&g_lock);
+#ifdef CONFIG_FS_PAGECACHE
+  pagecache_purge(fs);
+#endif
   fs_heap_free(fs);
   return ret;
 }
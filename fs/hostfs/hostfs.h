@@ -31,6 +31,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include <nuttx/fs/pagecache.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -51,6 +53,9 @@ struct hostfs_ofile_s
   int16_t                   crefs;   /* Reference count */
   mode_t                    oflags;  /* Open mode */
   int                       fd;
+#ifdef CONFIG_FS_PAGECACHE
+  struct pagecache_file_s   cache;   /* Page cache state */
+#endif
   char                      relpath[1];
 };
 
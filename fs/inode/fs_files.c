@@ -37,6 +37,7 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/cancelpt.h>
+#include <nuttx/mm/mempool.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/mutex.h>
 #include <nuttx/sched.h>
@@ -56,10 +57,77 @@
 #include "inode/inode.h"
 #include "fs_heap.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The number of file blocks the cache grows by at a time */
+
+#define FILES_CACHE_NEXPAND 4
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_FILE_CACHE
+static struct mempool_cache_s g_files_cache;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_FS_FILE_CACHE
+static FAR void *files_cache_alloc(FAR struct mempool_s *pool, size_t size)
+{
+  return fs_heap_memalign(MEMPOOL_ALIGN, size);
+}
+
+static void files_cache_free(FAR struct mempool_s *pool, FAR void *addr)
+{
+  fs_heap_free(addr);
+}
+#endif
+
+/****************************************************************************
+ * Name: files_alloc_block
+ *
+ * Description:
+ *   Allocate a zeroed block of CONFIG_NFILE_DESCRIPTORS_PER_BLOCK files.
+ *
+ ****************************************************************************/
+
+static FAR struct file *files_alloc_block(void)
+{
+#ifdef CONFIG_FS_FILE_CACHE
+  FAR struct file *files = mempool_cache_alloc(&g_files_cache);
+
+  if (files != NULL)
+    {
+      memset(files, 0,
+             sizeof(struct file) * CONFIG_NFILE_DESCRIPTORS_PER_BLOCK);
+    }
+
+  return files;
+#else
+  return fs_heap_zalloc(sizeof(struct file) *
+                        CONFIG_NFILE_DESCRIPTORS_PER_BLOCK);
+#endif
+}
+
+/****************************************************************************
+ * Name: files_free_block
+ ****************************************************************************/
+
+static void files_free_block(FAR struct file *files)
+{
+#ifdef CONFIG_FS_FILE_CACHE
+  mempool_cache_free(&g_files_cache, files);
+#else
+  fs_heap_free(files);
+#endif
+}
+
 /****************************************************************************
  * Name: files_fget_by_index
  ****************************************************************************/
@@ -148,13 +216,12 @@ static int files_extend(FAR struct filelist *list, size_t row)
   i = orig_rows;
   do
     {
-      files[i] = fs_heap_zalloc(sizeof(struct file) *
-                            CONFIG_NFILE_DESCRIPTORS_PER_BLOCK);
+      files[i] = files_alloc_block();
       if (files[i] == NULL)
         {
           while (--i >= orig_rows)
             {
-              fs_heap_free(files[i]);
+              files_free_block(files[i]);
             }
 
           fs_heap_free(files);
@@ -176,7 +243,7 @@ static int files_extend(FAR struct filelist *list, size_t row)
 
       for (j = orig_rows; j < i; j++)
         {
-          fs_heap_free(files[j]);
+          files_free_block(files[j]);
         }
 
       fs_heap_free(files);
@@ -352,6 +419,25 @@ static int nx_dup3_from_tcb(FAR struct tcb_s *tcb, int fd1, int fd2,
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: files_initialize
+ *
+ * Description:
+ *   Initialize the cache of file blocks.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_FILE_CACHE
+void files_initialize(void)
+{
+  g_files_cache.pool.alloc = files_cache_alloc;
+  g_files_cache.pool.free  = files_cache_free;
+  mempool_cache_init(&g_files_cache, "files",
+                     sizeof(struct file) * CONFIG_NFILE_DESCRIPTORS_PER_BLOCK,
+                     FILES_CACHE_NEXPAND);
+}
+#endif
+
 /****************************************************************************
  * Name: files_initlist
  *
@@ -498,7 +584,7 @@ void files_putlist(FAR struct filelist *list)
 
       if (i != 0)
         {
-          fs_heap_free(list->fl_files[i]);
+          files_free_block(list->fl_files[i]);
         }
     }
 
@@ -169,6 +169,20 @@ EXTERN FAR struct inode *g_root_inode;
 
 void inode_initialize(void);
 
+/****************************************************************************
+ * Name: files_initialize
+ *
+ * Description:
+ *   Initialize the cache of file blocks.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_FILE_CACHE
+void files_initialize(void);
+#else
+#  define files_initialize()
+#endif
+
 /****************************************************************************
  * Name: inode_lock
  *
@@ -26,6 +26,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <inttypes.h>
 #include <string.h>
 
 #include <nuttx/fs/fs.h>
@@ -66,6 +67,17 @@ struct littlefs_file_s
   int                   refs;
 };
 
+#if CONFIG_FS_LITTLEFS_BLOCK_CACHE > 0
+/* One line of the block cache, cache_size bytes of a littlefs block */
+
+struct littlefs_cline_s
+{
+  lfs_block_t           block;  /* littlefs block number */
+  lfs_off_t             off;    /* Offset of the line in the block */
+  uint32_t              stamp;  /* Last access, 0 if the line is unused */
+};
+#endif
+
 /* This structure represents the overall mountpoint state. An instance of
  * this structure is retained as inode private data on each mountpoint that
  * is mounted with a littlefs filesystem.
@@ -78,6 +90,13 @@ struct littlefs_mountpt_s
   struct mtd_geometry_s geo;
   struct lfs_config     cfg;
   struct lfs            lfs;
+#if CONFIG_FS_LITTLEFS_BLOCK_CACHE > 0
+  FAR uint8_t          *cbuffer;
+  uint32_t              cstamp;
+  uint32_t              chits;
+  uint32_t              cmisses;
+  struct littlefs_cline_s cline[CONFIG_FS_LITTLEFS_BLOCK_CACHE];
+#endif
 };
 
 struct littlefs_attr_s
@@ -622,6 +641,29 @@ static int littlefs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         }
         break;
 
+#if CONFIG_FS_LITTLEFS_BLOCK_CACHE > 0
+      case FIOC_CACHESTAT:
+        {
+          FAR struct fs_cachestat_s *stat =
+            (FAR struct fs_cachestat_s *)(uintptr_t)arg;
+
+          if (stat == NULL)
+            {
+              ret = -EINVAL;
+            }
+          else
+            {
+              stat->nlines   = fs->cbuffer != NULL ?
+                               CONFIG_FS_LITTLEFS_BLOCK_CACHE : 0;
+              stat->linesize = fs->cfg.cache_size;
+              stat->hits     = fs->chits;
+              stat->misses   = fs->cmisses;
+              ret = OK;
+            }
+        }
+        break;
+#endif
+
       default:
         {
           if (INODE_IS_MTD(drv))
@@ -1083,9 +1125,9 @@ static int littlefs_rewinddir(FAR struct inode *mountpt,
  *
  ****************************************************************************/
 
-static int littlefs_read_block(FAR const struct lfs_config *c,
-                               lfs_block_t block, lfs_off_t off,
-                               FAR void *buffer, lfs_size_t size)
+static int littlefs_read_device(FAR const struct lfs_config *c,
+                                lfs_block_t block, lfs_off_t off,
+                                FAR void *buffer, lfs_size_t size)
 {
   FAR struct littlefs_mountpt_s *fs = c->context;
   FAR struct mtd_geometry_s *geo = &fs->geo;
@@ -1107,6 +1149,152 @@ static int littlefs_read_block(FAR const struct lfs_config *c,
   return ret >= 0 ? OK : ret;
 }
 
+#if CONFIG_FS_LITTLEFS_BLOCK_CACHE > 0
+
+/****************************************************************************
+ * Name: littlefs_cache_line
+ *
+ * Description:
+ *   Return the cache line holding the cache_size bytes at offset off of
+ *   the block, reading it from the device on a miss.  The cache is shared
+ *   by all files of the mountpoint, and mostly holds metadata: littlefs
+ *   reads file data larger than its own caches directly into the user
+ *   buffer, and such reads bypass this cache.
+ *
+ ****************************************************************************/
+
+static int littlefs_cache_line(FAR const struct lfs_config *c,
+                               lfs_block_t block, lfs_off_t off,
+                               FAR uint8_t **data)
+{
+  FAR struct littlefs_mountpt_s *fs = c->context;
+  FAR struct littlefs_cline_s *victim = &fs->cline[0];
+  int ret;
+  int i;
+
+  for (i = 0; i < CONFIG_FS_LITTLEFS_BLOCK_CACHE; i++)
+    {
+      FAR struct littlefs_cline_s *line = &fs->cline[i];
+
+      if (line->stamp != 0 && line->block == block && line->off == off)
+        {
+          line->stamp = ++fs->cstamp;
+          fs->chits++;
+          *data = fs->cbuffer + i * c->cache_size;
+          return OK;
+        }
+
+      if (line->stamp < victim->stamp)
+        {
+          victim = line;
+        }
+    }
+
+  /* Replace the least recently used line */
+
+  fs->cmisses++;
+  *data = fs->cbuffer + (victim - fs->cline) * c->cache_size;
+
+  ret = littlefs_read_device(c, block, off, *data, c->cache_size);
+  if (ret < 0)
+    {
+      victim->stamp = 0;
+      return ret;
+    }
+
+  victim->block = block;
+  victim->off   = off;
+  victim->stamp = ++fs->cstamp;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: littlefs_cache_update
+ *
+ * Description:
+ *   Keep the cache lines of the block coherent with a program (buffer is
+ *   not NULL) or an erase (buffer is NULL) of the device.
+ *
+ ****************************************************************************/
+
+static void littlefs_cache_update(FAR const struct lfs_config *c,
+                                  lfs_block_t block, lfs_off_t off,
+                                  FAR const void *buffer, lfs_size_t size)
+{
+  FAR struct littlefs_mountpt_s *fs = c->context;
+  int i;
+
+  for (i = 0; i < CONFIG_FS_LITTLEFS_BLOCK_CACHE; i++)
+    {
+      FAR struct littlefs_cline_s *line = &fs->cline[i];
+      lfs_off_t start;
+      lfs_off_t end;
+
+      if (line->stamp == 0 || line->block != block)
+        {
+          continue;
+        }
+
+      if (buffer == NULL)
+        {
+          line->stamp = 0;
+          continue;
+        }
+
+      start = lfs_max(off, line->off);
+      end   = lfs_min(off + size, line->off + c->cache_size);
+      if (start < end)
+        {
+          memcpy(fs->cbuffer + i * c->cache_size + (start - line->off),
+                 (FAR const uint8_t *)buffer + (start - off), end - start);
+        }
+    }
+}
+
+#endif /* CONFIG_FS_LITTLEFS_BLOCK_CACHE > 0 */
+
+/****************************************************************************
+ * Name: littlefs_read_block
+ ****************************************************************************/
+
+static int littlefs_read_block(FAR const struct lfs_config *c,
+                               lfs_block_t block, lfs_off_t off,
+                               FAR void *buffer, lfs_size_t size)
+{
+#if CONFIG_FS_LITTLEFS_BLOCK_CACHE > 0
+  FAR struct littlefs_mountpt_s *fs = c->context;
+  FAR uint8_t *dest = buffer;
+  FAR uint8_t *data;
+  int ret;
+
+  if (fs->cbuffer == NULL || size > c->cache_size)
+    {
+      return littlefs_read_device(c, block, off, buffer, size);
+    }
+
+  while (size > 0)
+    {
+      lfs_off_t loff = off % c->cache_size;
+      lfs_size_t n = lfs_min(size, c->cache_size - loff);
+
+      ret = littlefs_cache_line(c, block, off - loff, &data);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      memcpy(dest, data + loff, n);
+      dest += n;
+      off  += n;
+      size -= n;
+    }
+
+  return OK;
+#else
+  return littlefs_read_device(c, block, off, buffer, size);
+#endif
+}
+
 /****************************************************************************
  * Name: littlefs_write_block
  ****************************************************************************/
@@ -1118,8 +1306,18 @@ static int littlefs_write_block(FAR const struct lfs_config *c,
   FAR struct littlefs_mountpt_s *fs = c->context;
   FAR struct mtd_geometry_s *geo = &fs->geo;
   FAR struct inode *drv = fs->drv;
+#if CONFIG_FS_LITTLEFS_BLOCK_CACHE > 0
+  lfs_block_t lblock = block;
+#endif
   int ret;
 
+#if CONFIG_FS_LITTLEFS_BLOCK_CACHE > 0
+  if (fs->cbuffer != NULL)
+    {
+      littlefs_cache_update(c, block, off, buffer, size);
+    }
+
+#endif
   block = (block * c->block_size + off) / geo->blocksize;
   size  = size / geo->blocksize;
 
@@ -1132,6 +1330,15 @@ static int littlefs_write_block(FAR const struct lfs_config *c,
       ret = drv->u.i_bops->write(drv, buffer, block, size);
     }
 
+#if CONFIG_FS_LITTLEFS_BLOCK_CACHE > 0
+  /* The device content is unknown after a failed program */
+
+  if (ret < 0 && fs->cbuffer != NULL)
+    {
+      littlefs_cache_update(c, lblock, 0, NULL, 0);
+    }
+#endif
+
   return ret >= 0 ? OK : ret;
 }
 
@@ -1146,6 +1353,13 @@ static int littlefs_erase_block(FAR const struct lfs_config *c,
   FAR struct inode *drv = fs->drv;
   int ret = OK;
 
+#if CONFIG_FS_LITTLEFS_BLOCK_CACHE > 0
+  if (fs->cbuffer != NULL)
+    {
+      littlefs_cache_update(c, block, 0, NULL, 0);
+    }
+
+#endif
   if (INODE_IS_MTD(drv))
     {
       FAR struct mtd_geometry_s *geo = &fs->geo;
@@ -1295,6 +1509,17 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
   fs->cfg.lookahead_size = CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE;
 #endif
 
+#if CONFIG_FS_LITTLEFS_BLOCK_CACHE > 0
+  /* The block cache is optional, littlefs works without it */
+
+  fs->cbuffer = fs_heap_malloc(fs->cfg.cache_size *
+                               CONFIG_FS_LITTLEFS_BLOCK_CACHE);
+  if (fs->cbuffer == NULL)
+    {
+      fwarn("WARNING: No memory for the block cache\n");
+    }
+#endif
+
   /* Then get information about the littlefs filesystem on the devices
    * managed by this driver.
    */
@@ -1339,6 +1564,13 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
   return OK;
 
 errout_with_fs:
+#if CONFIG_FS_LITTLEFS_BLOCK_CACHE > 0
+  if (fs->cbuffer != NULL)
+    {
+      fs_heap_free(fs->cbuffer);
+    }
+
+#endif
   nxmutex_destroy(&fs->lock);
   fs_heap_free(fs);
 errout_with_block:
@@ -1398,6 +1630,16 @@ static int littlefs_unbind(FAR void *handle, FAR struct inode **driver,
 
       /* Release the mountpoint private data */
 
+#if CONFIG_FS_LITTLEFS_BLOCK_CACHE > 0
+      finfo("Block cache hits %" PRIu32 " misses %" PRIu32 "\n",
+            fs->chits, fs->cmisses);
+
+      if (fs->cbuffer != NULL)
+        {
+          fs_heap_free(fs->cbuffer);
+        }
+
+#endif
       nxmutex_destroy(&fs->lock);
       fs_heap_free(fs);
     }
@@ -23,8 +23,11 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+#include <nuttx/arch.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/pgalloc.h>
 #include <nuttx/sched.h>
+#include <sys/mman.h>
 #include <assert.h>
 #include <debug.h>
 
@@ -32,10 +35,154 @@
 #include "sched/sched.h"
 #include "fs_heap.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* MAP_HUGETLB mappings of user memory are backed by pages instead of the
+ * heap, which needs the page allocator and per-process virtual mappings.
+ */
+
+#if defined(CONFIG_MM_PGALLOC_LARGEPAGE) && defined(CONFIG_BUILD_KERNEL) && \
+    defined(CONFIG_ARCH_VMA_MAPPING)
+#  define ANONMAP_PAGES
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef ANONMAP_PAGES
+/****************************************************************************
+ * Name: unmap_anonymous_pages
+ ****************************************************************************/
+
+static int unmap_anonymous_pages(FAR struct task_group_s *group,
+                                 FAR struct mm_map_entry_s *entry,
+                                 FAR void *start,
+                                 size_t length)
+{
+  FAR uintptr_t *pages = entry->priv.p;
+  unsigned int npages = MM_NPAGES(entry->length);
+  unsigned int i;
+
+  /* A partial unmap could split a large page, so only the whole mapping
+   * may be unmapped.
+   */
+
+  if (start != entry->vaddr || length < entry->length)
+    {
+      ferr("ERROR: Cannot partially unmap a MAP_HUGETLB mapping\n");
+      return -ENOSYS;
+    }
+
+  if (group)
+    {
+      up_shmdt((uintptr_t)entry->vaddr, npages);
+      vm_release_region(get_group_mm(group), entry->vaddr, entry->length);
+    }
+
+  for (i = 0; i < npages; i++)
+    {
+      mm_pgfree(pages[i], 1);
+    }
+
+  kmm_free(pages);
+  return mm_map_remove(get_group_mm(group), entry);
+}
+
+/****************************************************************************
+ * Name: map_anonymous_pages
+ *
+ * Description:
+ *   Back a user mapping with physically contiguous large pages, or with
+ *   separate pages if there are none.
+ *
+ ****************************************************************************/
+
+static int map_anonymous_pages(FAR struct mm_map_entry_s *entry)
+{
+  FAR struct mm_map_s *mm = get_current_mm();
+  FAR uintptr_t *pages;
+  unsigned int npages = MM_NPAGES(entry->length);
+  unsigned int i = 0;
+  uintptr_t paddr;
+  int ret;
+
+  pages = kmm_malloc(npages * sizeof(uintptr_t));
+  if (pages == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  paddr = mm_pgalloc_large(npages);
+  if (paddr != 0)
+    {
+      for (; i < npages; i++, paddr += MM_PGSIZE)
+        {
+          pages[i] = paddr;
+        }
+    }
+
+  for (; i < npages; i++)
+    {
+      pages[i] = mm_pgalloc(1);
+      if (pages[i] == 0)
+        {
+          ret = -ENOMEM;
+          goto errout_with_pages;
+        }
+    }
+
+  /* Unless MAP_UNINITIALIZED, the caller clears the mapping anyway */
+
+  if ((entry->flags & MAP_UNINITIALIZED) != 0)
+    {
+      for (i = 0; i < npages; i++)
+        {
+          up_addrenv_page_wipe(pages[i]);
+        }
+    }
+
+  entry->vaddr = vm_alloc_region(mm, NULL, entry->length);
+  if (entry->vaddr == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout_with_pages;
+    }
+
+  ret = up_shmat(pages, npages, (uintptr_t)entry->vaddr);
+  if (ret < 0)
+    {
+      goto errout_with_vaddr;
+    }
+
+  entry->munmap = unmap_anonymous_pages;
+  entry->priv.p = pages;
+
+  ret = mm_map_add(mm, entry);
+  if (ret < 0)
+    {
+      up_shmdt((uintptr_t)entry->vaddr, npages);
+      goto errout_with_vaddr;
+    }
+
+  return ret;
+
+errout_with_vaddr:
+  vm_release_region(mm, entry->vaddr, entry->length);
+  entry->vaddr = NULL;
+errout_with_pages:
+  while (i-- > 0)
+    {
+      mm_pgfree(pages[i], 1);
+    }
+
+  kmm_free(pages);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: unmap_anonymous
  ****************************************************************************/
@@ -121,6 +268,13 @@ int map_anonymous(FAR struct mm_map_entry_s *entry, bool kernel)
 {
   int ret;
 
+#ifdef ANONMAP_PAGES
+  if (!kernel && (entry->flags & MAP_HUGETLB) != 0)
+    {
+      return map_anonymous_pages(entry);
+    }
+#endif
+
   /* REVISIT:  Should reside outside of the heap.  That is really the
    * only purpose of MAP_ANONYMOUS:  To get non-heap memory.  In KERNEL
    * build, this could be accomplished using pgalloc(), provided that
@@ -50,6 +50,7 @@ static int file_mmap_(FAR struct file *filep, FAR void *start,
                       size_t length, int prot, int flags, off_t offset,
                       enum mm_map_type_e type, FAR void **mapped)
 {
+  struct mm_map_entry_s entry;
   int ret = -ENOTTY;
 
   /* Pass the information about the mapping in mm_map_entry_s structure.
@@ -57,17 +58,12 @@ static int file_mmap_(FAR struct file *filep, FAR void *start,
    * will also add it to the kernel maintained list of mappings.
    */
 
-  struct mm_map_entry_s entry =
-    {
-     NULL,     /* sq_entry_t */
-     start,
-     length,
-     offset,
-     prot,
-     flags,
-     { NULL }, /* priv.p */
-     NULL      /* munmap */
-    };
+  memset(&entry, 0, sizeof(entry));
+  entry.vaddr  = start;
+  entry.length = length;
+  entry.offset = offset;
+  entry.prot   = prot;
+  entry.flags  = flags;
 
   /* Since only a tiny subset of mmap() functionality, we have to verify many
    * things.
@@ -125,12 +125,12 @@ static int nxmq_file_poll(FAR struct file *filep,
 
       /* Immediately notify on any of the requested events */
 
-      if (msgq->nmsgs < msgq->maxmsgs)
+      if (nxmq_nmsgs(msgq) < msgq->maxmsgs)
         {
           eventset |= POLLOUT;
         }
 
-      if (msgq->nmsgs > 0)
+      if (nxmq_nmsgs(msgq) > 0)
         {
           eventset |= POLLIN;
         }
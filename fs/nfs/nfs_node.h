@@ -48,6 +48,8 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/fs/pagecache.h>
+
 #include "nfs_proto.h"
 
 /****************************************************************************
@@ -70,6 +72,9 @@ struct nfsnode
   struct timespec     n_ctime;      /* File creation time */
   nfsfh_t             n_fhandle;    /* NFS File Handle */
   uint64_t            n_size;       /* Current size of file */
+#ifdef CONFIG_FS_PAGECACHE
+  struct pagecache_file_s n_cache;  /* Page cache state */
+#endif
 };
 
 #endif /* __FS_NFS_NFS_NODE_H */
@@ -654,6 +654,10 @@ static int nfs_open(FAR struct file *filep, FAR const char *relpath,
 {
   FAR struct nfsmount *nmp;
   FAR struct nfsnode *np;
+#ifdef CONFIG_FS_PAGECACHE
+  uint64_t ino = 0xcbf29ce484222325ull;
+  int i;
+#endif
   int ret;
 
   /* Get the mountpoint inode reference from the file structure and the
@@ -727,6 +731,21 @@ static int nfs_open(FAR struct file *filep, FAR const char *relpath,
 
   np->n_crefs = 1;
 
+#ifdef CONFIG_FS_PAGECACHE
+  /* The file handle is the only stable identity of an NFS file, so hash
+   * it into the page cache key.  Handles that cannot read still need the
+   * key, their writes invalidate the pages read through other handles.
+   */
+
+  for (i = 0; i < np->n_fhsize; i++)
+    {
+      ino = (ino ^ ((FAR uint8_t *)&np->n_fhandle)[i]) * 0x100000001b3ull;
+    }
+
+  pagecache_open(&np->n_cache, nmp, ino,
+                 pagecache_version(&np->n_mtime, np->n_size));
+#endif
+
   /* Attach the private data to the struct file instance */
 
   filep->f_priv = np;
@@ -861,7 +880,12 @@ static int nfs_close(FAR struct file *filep)
 }
 
 /****************************************************************************
- * Name: nfs_read
+ * Name: nfs_fileread
+ *
+ * Description:
+ *   Read from the open file at the given offset with as many READ RPCs as
+ *   needed.  Also used as the page cache fill callback.  The caller holds
+ *   the mountpoint lock.
  *
  * Returned Value:
  *   The (non-negative) number of bytes read on success; a negated errno
@@ -869,9 +893,10 @@ static int nfs_close(FAR struct file *filep)
  *
  ****************************************************************************/
 
-static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
-                        size_t buflen)
+static ssize_t nfs_fileread(FAR void *arg, FAR char *buffer, off_t offset,
+                            size_t buflen)
 {
+  FAR struct file           *filep = arg;
   FAR struct nfsmount       *nmp;
   FAR struct nfsnode        *np;
   ssize_t                    readsize;
@@ -881,37 +906,9 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
   FAR uint32_t              *ptr;
   int                        ret = 0;
 
-  finfo("Read %zu bytes from offset %jd\n",
-        buflen, (intmax_t)filep->f_pos);
-
-  /* Sanity checks */
-
-  DEBUGASSERT(filep->f_priv != NULL);
-
-  /* Recover our private data from the struct file instance */
-
   nmp = filep->f_inode->i_private;
   np  = (FAR struct nfsnode *)filep->f_priv;
 
-  DEBUGASSERT(nmp != NULL);
-
-  ret = nxmutex_lock(&nmp->nm_lock);
-  if (ret < 0)
-    {
-      return (ssize_t)ret;
-    }
-
-  /* Get the number of bytes left in the file and truncate read count so that
-   * it does not exceed the number of bytes left in the file.
-   */
-
-  tmp = np->n_size - filep->f_pos;
-  if (buflen > tmp)
-    {
-      buflen = tmp;
-      finfo("Read size truncated to %zu\n", buflen);
-    }
-
   /* Now loop until we fill the user buffer (or hit the end of the file) */
 
   for (bytesread = 0; bytesread < buflen; )
@@ -952,7 +949,7 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
 
       /* Copy the file offset */
 
-      txdr_hyper((uint64_t)filep->f_pos, ptr);
+      txdr_hyper((uint64_t)offset, ptr);
       ptr += 2;
       reqlen += 2*sizeof(uint32_t);
 
@@ -971,7 +968,7 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
       if (ret)
         {
           ferr("ERROR: nfs_request failed: %d\n", ret);
-          goto errout_with_lock;
+          break;
         }
 
       /* The read was successful.  Get a pointer to the beginning of the NFS
@@ -1015,9 +1012,9 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
 
       /* Update the read state data */
 
-      filep->f_pos += readsize;
-      bytesread    += readsize;
-      buffer       += readsize;
+      offset    += readsize;
+      bytesread += readsize;
+      buffer    += readsize;
 
       /* Check if we hit the end of file */
 
@@ -1027,11 +1024,72 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
         }
     }
 
-errout_with_lock:
-  nxmutex_unlock(&nmp->nm_lock);
   return bytesread > 0 ? bytesread : ret;
 }
 
+/****************************************************************************
+ * Name: nfs_read
+ *
+ * Returned Value:
+ *   The (non-negative) number of bytes read on success; a negated errno
+ *   value on failure.
+ *
+ ****************************************************************************/
+
+static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
+                        size_t buflen)
+{
+  FAR struct nfsmount       *nmp;
+  FAR struct nfsnode        *np;
+  ssize_t                    tmp;
+  ssize_t                    ret;
+
+  finfo("Read %zu bytes from offset %jd\n",
+        buflen, (intmax_t)filep->f_pos);
+
+  /* Sanity checks */
+
+  DEBUGASSERT(filep->f_priv != NULL);
+
+  /* Recover our private data from the struct file instance */
+
+  nmp = filep->f_inode->i_private;
+  np  = (FAR struct nfsnode *)filep->f_priv;
+
+  DEBUGASSERT(nmp != NULL);
+
+  ret = nxmutex_lock(&nmp->nm_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Get the number of bytes left in the file and truncate read count so that
+   * it does not exceed the number of bytes left in the file.
+   */
+
+  tmp = np->n_size - filep->f_pos;
+  if (buflen > tmp)
+    {
+      buflen = tmp;
+      finfo("Read size truncated to %zu\n", buflen);
+    }
+
+#ifdef CONFIG_FS_PAGECACHE
+  ret = pagecache_read(&np->n_cache, buffer, buflen, filep->f_pos,
+                       nfs_fileread, filep);
+#else
+  ret = nfs_fileread(filep, buffer, filep->f_pos, buflen);
+#endif
+  if (ret > 0)
+    {
+      filep->f_pos += ret;
+    }
+
+  nxmutex_unlock(&nmp->nm_lock);
+  return ret;
+}
+
 /****************************************************************************
  * Name: nfs_write
  *
@@ -1076,6 +1134,10 @@ static ssize_t nfs_write(FAR struct file *filep, FAR const char *buffer,
       return (ssize_t)ret;
     }
 
+#ifdef CONFIG_FS_PAGECACHE
+  pagecache_invalidate(&np->n_cache);
+#endif
+
   /* Check if the file size would exceed the range of off_t */
 
   if (np->n_size + buflen < np->n_size)
@@ -1429,6 +1491,13 @@ static int nfs_fchstat(FAR const struct file *filep,
       return ret;
     }
 
+#ifdef CONFIG_FS_PAGECACHE
+  if ((flags & CH_STAT_SIZE) != 0)
+    {
+      pagecache_invalidate(&np->n_cache);
+    }
+#endif
+
   /* Change the file mode, owner, group and time. */
 
   ret = nfs_filechstat(nmp, np, buf, flags);
@@ -1467,6 +1536,10 @@ static int nfs_truncate(FAR struct file *filep, off_t length)
     {
       struct stat buf;
 
+#ifdef CONFIG_FS_PAGECACHE
+      pagecache_invalidate(&np->n_cache);
+#endif
+
       /* Then perform the SETATTR RPC to set the new file size */
 
       buf.st_size = length;
@@ -2243,6 +2316,9 @@ static int nfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
 
   /* And free any allocated resources */
 
+#ifdef CONFIG_FS_PAGECACHE
+  pagecache_purge(nmp);
+#endif
   nxmutex_destroy(&nmp->nm_lock);
   fs_heap_free(nmp->nm_rpcclnt);
   fs_heap_free(nmp);
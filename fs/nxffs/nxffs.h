@@ -36,6 +36,7 @@
 #include <nuttx/fs/nxffs.h>
 #include <nuttx/mutex.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -279,6 +280,13 @@ struct nxffs_volume_s
   FAR struct nxffs_ofile_s *ofiles;    /* A singly-linked list of open files */
   FAR uint8_t              *cache;     /* On cached erase block for general I/O */
   FAR uint8_t              *pack;      /* A full erase block to support packing */
+#ifdef CONFIG_NXFFS_WRITEBACK
+  bool                      dirty;     /* Cache holds data not yet written */
+#endif
+#ifdef CONFIG_NXFFS_GC
+  off_t                     gcbytes;   /* Bytes deleted since the last pack */
+  struct work_s             gcwork;    /* Background packing work */
+#endif
 };
 
 /* This structure describes the state of the blocks on the NXFFS volume */
@@ -485,6 +493,30 @@ int nxffs_rdcache(FAR struct nxffs_volume_s *volume, off_t block);
 
 int nxffs_wrcache(FAR struct nxffs_volume_s *volume);
 
+/****************************************************************************
+ * Name: nxffs_flushcache
+ *
+ * Description:
+ *   Write the volume cache memory to FLASH if it holds data that has not
+ *   been written yet.  This must be done before accessing FLASH directly,
+ *   bypassing the cache.
+ *
+ * Input Parameters:
+ *   volume - Describes the current volume
+ *
+ * Returned Value:
+ *   Negated errnos are returned only in the case of MTD reported failures.
+ *
+ * Defined in nxffs_cache.c
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_WRITEBACK
+int nxffs_flushcache(FAR struct nxffs_volume_s *volume);
+#else
+#  define nxffs_flushcache(v) OK
+#endif
+
 /****************************************************************************
  * Name: nxffs_ioseek
  *
@@ -1060,6 +1092,28 @@ int nxffs_rminode(FAR struct nxffs_volume_s *volume, FAR const char *name);
 
 int nxffs_pack(FAR struct nxffs_volume_s *volume);
 
+/****************************************************************************
+ * Name: nxffs_gcschedule
+ *
+ * Description:
+ *   Account for deleted FLASH data and schedule packing the volume in the
+ *   background once CONFIG_NXFFS_GC_THRESHOLD bytes were deleted.
+ *
+ * Input Parameters:
+ *   volume - Describes the NXFFS volume
+ *   nbytes - The number of bytes that were deleted
+ *
+ * Assumptions:
+ *   The caller holds the NXFFS semaphore.
+ *
+ * Defined in nxffs_gc.c
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_GC
+void nxffs_gcschedule(FAR struct nxffs_volume_s *volume, off_t nbytes);
+#endif
+
 /****************************************************************************
  * Standard mountpoint operation methods
  *
@@ -62,6 +62,18 @@ int nxffs_rdcache(FAR struct nxffs_volume_s *volume, off_t block)
 
   if (block != volume->cblock)
     {
+#ifdef CONFIG_NXFFS_WRITEBACK
+      /* Write back the data that was buffered in the cache before it is
+       * replaced.
+       */
+
+      int ret = nxffs_flushcache(volume);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+#endif
       /* Read the specified blocks into cache */
 
       nxfrd = MTD_BREAD(volume->mtd, block, 1, volume->cache);
@@ -110,9 +122,50 @@ int nxffs_wrcache(FAR struct nxffs_volume_s *volume)
 
   /* Write was successful */
 
+#ifdef CONFIG_NXFFS_WRITEBACK
+  volume->dirty = false;
+#endif
   return OK;
 }
 
+/****************************************************************************
+ * Name: nxffs_flushcache
+ *
+ * Description:
+ *   Write the volume cache memory to FLASH if it holds data that has not
+ *   been written yet.  If the write fails the buffered data is dropped
+ *   after the error is reported, so that the cache can be used for other
+ *   blocks again.
+ *
+ * Input Parameters:
+ *   volume - Describes the current volume
+ *
+ * Returned Value:
+ *   Negated errnos are returned only in the case of MTD reported failures.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_WRITEBACK
+int nxffs_flushcache(FAR struct nxffs_volume_s *volume)
+{
+  int ret;
+
+  if (!volume->dirty)
+    {
+      return OK;
+    }
+
+  ret = nxffs_wrcache(volume);
+  if (ret < 0)
+    {
+      volume->dirty  = false;
+      volume->cblock = (off_t)-1;
+    }
+
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: nxffs_ioseek
  *
@@ -0,0 +1,127 @@
+/****************************************************************************
+ * fs/nxffs/nxffs_gc.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/mutex.h>
+#include <nuttx/wqueue.h>
+
+#include "nxffs.h"
+
+#ifdef CONFIG_NXFFS_GC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define NXFFS_GC_DELAY MSEC2TICK(CONFIG_NXFFS_GC_DELAY)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxffs_gcworker
+ *
+ * Description:
+ *   Pack the volume on the low priority work queue.  Packing is postponed
+ *   while the volume is locked or a file is open for writing: the writer
+ *   appends at the end of the FLASH and would be relocated by the pack.
+ *
+ ****************************************************************************/
+
+static void nxffs_gcworker(FAR void *arg)
+{
+  FAR struct nxffs_volume_s *volume = arg;
+  int ret;
+
+  if (nxmutex_trylock(&volume->lock) < 0)
+    {
+      work_queue(LPWORK, &volume->gcwork, nxffs_gcworker, volume,
+                 NXFFS_GC_DELAY);
+      return;
+    }
+
+  if (nxffs_findwriter(volume) != NULL)
+    {
+      work_queue(LPWORK, &volume->gcwork, nxffs_gcworker, volume,
+                 NXFFS_GC_DELAY);
+    }
+  else if (volume->gcbytes >= CONFIG_NXFFS_GC_THRESHOLD)
+    {
+      finfo("Packing %jd deleted bytes\n", (intmax_t)volume->gcbytes);
+
+      ret = nxffs_pack(volume);
+      if (ret < 0)
+        {
+          ferr("ERROR: Failed to pack the volume: %d\n", ret);
+        }
+
+      /* Don't retry until more data is deleted, even if nothing could be
+       * reclaimed this time.
+       */
+
+      volume->gcbytes = 0;
+    }
+
+  nxmutex_unlock(&volume->lock);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxffs_gcschedule
+ *
+ * Description:
+ *   Account for deleted FLASH data and schedule packing the volume in the
+ *   background once CONFIG_NXFFS_GC_THRESHOLD bytes were deleted.
+ *
+ * Input Parameters:
+ *   volume - Describes the NXFFS volume
+ *   nbytes - The number of bytes that were deleted
+ *
+ * Assumptions:
+ *   The caller holds the NXFFS semaphore.
+ *
+ ****************************************************************************/
+
+void nxffs_gcschedule(FAR struct nxffs_volume_s *volume, off_t nbytes)
+{
+  volume->gcbytes += nbytes;
+  if (volume->gcbytes >= CONFIG_NXFFS_GC_THRESHOLD &&
+      work_available(&volume->gcwork))
+    {
+      work_queue(LPWORK, &volume->gcwork, nxffs_gcworker, volume,
+                 NXFFS_GC_DELAY);
+    }
+}
+
+#endif /* CONFIG_NXFFS_GC */
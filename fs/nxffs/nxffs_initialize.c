@@ -63,7 +63,7 @@ const struct mountpt_operations g_nxffs_operations =
 #endif
   NULL,              /* poll */
 
-  NULL,              /* sync -- No buffered data */
+  NULL,              /* sync -- Files are committed on close */
   nxffs_dup,         /* dup */
   nxffs_fstat,       /* fstat */
   NULL,              /* fchstat */
@@ -565,6 +565,15 @@ int nxffs_unbind(FAR void *handle, FAR struct inode **blkdriver,
       return -ENOSYS;
     }
 
-  return g_volume.ofiles ? -EBUSY : OK;
+  if (g_volume.ofiles)
+    {
+      return -EBUSY;
+    }
+
+#ifdef CONFIG_NXFFS_GC
+  work_cancel_sync(LPWORK, &g_volume.gcwork);
+#endif
+
+  return OK;
 #endif
 }
@@ -1275,6 +1275,17 @@ int nxffs_pack(FAR struct nxffs_volume_s *volume)
   int i;
   int ret = OK;
 
+  /* Packing reads and writes FLASH directly, write back any data that is
+   * buffered in the cache first.
+   */
+
+  ret = nxffs_flushcache(volume);
+  if (ret < 0)
+    {
+      ferr("ERROR: Failed to flush the cache: %d\n", -ret);
+      return ret;
+    }
+
   /* Get the offset to the first valid inode entry */
 
   wrfile = NULL;
@@ -1609,5 +1620,16 @@ start_pack:
 errout_with_pack:
   nxffs_freeentry(&pack.src.entry);
   nxffs_freeentry(&pack.dest.entry);
+
+  /* The FLASH content behind the cache may have changed */
+
+  volume->cblock = (off_t)-1;
+#ifdef CONFIG_NXFFS_GC
+  if (ret >= 0)
+    {
+      volume->gcbytes = 0;
+    }
+#endif
+
   return ret;
 }
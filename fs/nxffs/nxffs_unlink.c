@@ -113,6 +113,15 @@ int nxffs_rminode(FAR struct nxffs_volume_s *volume, FAR const char *name)
       ferr("ERROR: Failed to write block %jd: %d\n",
            (intmax_t)volume->ioblock, ret);
     }
+#ifdef CONFIG_NXFFS_GC
+  else
+    {
+      /* The inode and its data can now be reclaimed by packing */
+
+      nxffs_gcschedule(volume, SIZEOF_NXFFS_INODE_HDR +
+                       strlen(entry.name) + entry.datlen);
+    }
+#endif
 
 errout_with_entry:
   nxffs_freeentry(&entry);
@@ -368,16 +368,22 @@ static inline ssize_t nxffs_wrappend(FAR struct nxffs_volume_s *volume,
 
       /* And write the partial write block to FLASH -- unless the data
        * block is full.  In that case, the block will be written below.
+       * With write-back, the partial block is only written when the cache
+       * is needed for another block.
        */
 
       if (nbytesleft > 0)
         {
+#ifdef CONFIG_NXFFS_WRITEBACK
+          volume->dirty = true;
+#else
           ret = nxffs_wrcache(volume);
           if (ret < 0)
             {
               ferr("ERROR: nxffs_wrcache failed: %d\n", -ret);
               return ret;
             }
+#endif
         }
     }
 
@@ -461,16 +467,22 @@ static inline ssize_t nxffs_zappend(FAR struct nxffs_volume_s *volume,
 
       /* And write the partial write block to FLASH -- unless the data
        * block is full.  In that case, the block will be written below.
+       * With write-back, the partial block is only written when the cache
+       * is needed for another block.
        */
 
       if (nbytesleft > 0)
         {
+#ifdef CONFIG_NXFFS_WRITEBACK
+          volume->dirty = true;
+#else
           ret = nxffs_wrcache(volume);
           if (ret < 0)
             {
               ferr("ERROR: nxffs_wrcache failed: %d\n", -ret);
               return ret;
             }
+#endif
         }
     }
 
@@ -577,6 +589,18 @@ ssize_t nxffs_write(FAR struct file *filep, FAR const char *buffer,
 
       nxffs_ioseek(volume, wrfile->doffset);
 
+      /* The block may have been replaced in the cache by other accesses
+       * since the last write.
+       */
+
+      ret = nxffs_rdcache(volume, volume->ioblock);
+      if (ret < 0)
+        {
+          ferr("ERROR: Failed to read block %jd into cache: %d\n",
+               (intmax_t)volume->ioblock, -ret);
+          goto errout_with_lock;
+        }
+
       /* Verify that the FLASH data that was previously written is still
        * intact
        */
@@ -674,6 +698,18 @@ int nxffs_wrextend(FAR struct nxffs_volume_s *volume,
 
       nxffs_ioseek(volume, wrfile->doffset);
 
+      /* The block may have been replaced in the cache by other accesses
+       * since the last write.
+       */
+
+      ret = nxffs_rdcache(volume, volume->ioblock);
+      if (ret < 0)
+        {
+          ferr("ERROR: Failed to read block %jd into cache: %d\n",
+               (intmax_t)volume->ioblock, -ret);
+          return ret;
+        }
+
       /* Verify that the FLASH data that was previously written is still
        * intact
        */
@@ -37,6 +37,7 @@
 #include <errno.h>
 #include <debug.h>
 #include <ctype.h>
+#include <execinfo.h>
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/pgalloc.h>
@@ -73,6 +74,16 @@ struct meminfo_file_s
   char line[MEMINFO_LINELEN];     /* Pre-allocated buffer for formatted lines */
 };
 
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMFRAG
+struct memfrag_s
+{
+  struct mm_fraginfo_s info;
+#if CONFIG_MM_BACKTRACE > 0
+  struct mm_fragsite_s sites[CONFIG_FS_PROCFS_MEMFRAG_NSITES];
+#endif
+};
+#endif
+
 #if defined(CONFIG_ARCH_HAVE_PROGMEM) && defined(CONFIG_FS_PROCFS_INCLUDE_PROGMEM)
 struct progmem_info_s
 {
@@ -104,6 +115,10 @@ static ssize_t memdump_read(FAR struct file *filep, FAR char *buffer,
 static ssize_t memdump_write(FAR struct file *filep, FAR const char *buffer,
                              size_t buflen);
 #endif
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMFRAG
+static ssize_t memfrag_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen);
+#endif
 static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
                  size_t buflen);
 static int     meminfo_dup(FAR const struct file *oldp,
@@ -151,6 +166,23 @@ const struct procfs_operations g_memdump_operations =
 };
 #endif
 
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMFRAG
+const struct procfs_operations g_memfrag_operations =
+{
+  meminfo_open,   /* open */
+  meminfo_close,  /* close */
+  memfrag_read,   /* read */
+  NULL,           /* write */
+  NULL,           /* poll */
+  meminfo_dup,    /* dup */
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+  meminfo_stat    /* stat */
+};
+#endif
+
 static FAR struct procfs_meminfo_entry_s *g_procfs_meminfo = NULL;
 
 /****************************************************************************
@@ -643,6 +675,148 @@ dump:
 }
 #endif
 
+/****************************************************************************
+ * Name: memfrag_compare
+ ****************************************************************************/
+
+#if !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMFRAG) && CONFIG_MM_BACKTRACE > 0
+static int memfrag_compare(FAR const void *a, FAR const void *b)
+{
+  FAR const struct mm_fragsite_s *site_a = a;
+  FAR const struct mm_fragsite_s *site_b = b;
+
+  /* Largest sites first, the empty entries last */
+
+  if (site_a->size != site_b->size)
+    {
+      return site_a->size < site_b->size ? 1 : -1;
+    }
+
+  return 0;
+}
+#endif
+
+/****************************************************************************
+ * Name: memfrag_read
+ *
+ * Description:
+ *   Show for each heap the free and allocated blocks of each size class,
+ *   the largest free block of each region, how much of the free memory is
+ *   not in the largest free block and, with CONFIG_MM_BACKTRACE > 0, the
+ *   allocated memory of each allocation site.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMFRAG
+static ssize_t memfrag_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR const struct procfs_meminfo_entry_s *entry;
+  FAR struct mm_fraginfo_s *info;
+  FAR struct memfrag_s *frag;
+  off_t offset = filep->f_pos;
+  size_t totalfree;
+  size_t mxfree;
+  ssize_t ret;
+  int i;
+
+  DEBUGASSERT(buffer != NULL && buflen > 0);
+
+  /* The report is too large for the stack */
+
+  frag = fs_heap_malloc(sizeof(struct memfrag_s));
+  if (frag == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  info = &frag->info;
+#if CONFIG_MM_BACKTRACE > 0
+  info->sites  = frag->sites;
+  info->nsites = CONFIG_FS_PROCFS_MEMFRAG_NSITES;
+#endif
+
+  for (entry = g_procfs_meminfo; entry != NULL; entry = entry->next)
+    {
+      mm_free_delaylist(entry->heap);
+      mm_fraginfo(entry->heap, info);
+
+      procfs_sprintf(buffer, buflen, &offset, "%s:\n%11s%11s%11s%11s%11s\n",
+                     entry->name, "class", "nfree", "free", "nused",
+                     "used");
+
+      totalfree = 0;
+      for (i = 0; i < MM_FRAG_NCLASSES; i++)
+        {
+          totalfree += info->free[i];
+          if (info->nfree[i] > 0 || info->nused[i] > 0)
+            {
+              procfs_sprintf(buffer, buflen, &offset,
+                             "%11lu%11lu%11lu%11lu%11lu\n",
+                             1ul << i,
+                             (unsigned long)info->nfree[i],
+                             (unsigned long)info->free[i],
+                             (unsigned long)info->nused[i],
+                             (unsigned long)info->used[i]);
+            }
+        }
+
+      procfs_sprintf(buffer, buflen, &offset, "%11s%11s\n",
+                     "region", "maxfree");
+
+      mxfree = 0;
+      for (i = 0; i < info->nregions; i++)
+        {
+          procfs_sprintf(buffer, buflen, &offset, "%11d%11lu\n",
+                         i, (unsigned long)info->mxfree[i]);
+          if (info->mxfree[i] > mxfree)
+            {
+              mxfree = info->mxfree[i];
+            }
+        }
+
+      /* The share of the free memory that can't be allocated at once */
+
+      procfs_sprintf(buffer, buflen, &offset, "fragmentation: %lu%%\n",
+                     totalfree == 0 ? 0ul : (unsigned long)
+                     (100 - (uint64_t)mxfree * 100 / totalfree));
+
+#if CONFIG_MM_BACKTRACE > 0
+      qsort(info->sites, info->nsites, sizeof(struct mm_fragsite_s),
+            memfrag_compare);
+
+      procfs_sprintf(buffer, buflen, &offset, "%*s%11s%11s%11s%11s\n",
+                     BACKTRACE_PTR_FMT_WIDTH, "site", "nblocks", "size",
+                     "npinning", "seqmin");
+
+      for (i = 0; i < info->nsites && info->sites[i].nblocks > 0; i++)
+        {
+          procfs_sprintf(buffer, buflen, &offset,
+                         "%*p%11lu%11lu%11lu%11lu\n",
+                         BACKTRACE_PTR_FMT_WIDTH, info->sites[i].site,
+                         (unsigned long)info->sites[i].nblocks,
+                         (unsigned long)info->sites[i].size,
+                         (unsigned long)info->sites[i].npinning,
+                         info->sites[i].seqmin);
+        }
+
+      if (info->nlost > 0)
+        {
+          procfs_sprintf(buffer, buflen, &offset, "%*s%11lu\n",
+                         BACKTRACE_PTR_FMT_WIDTH, "other",
+                         (unsigned long)info->nlost);
+        }
+#endif
+    }
+
+  fs_heap_free(frag);
+
+  ret = offset < 0 ? -offset : 0;
+  filep->f_pos += ret;
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: meminfo_dup
  *
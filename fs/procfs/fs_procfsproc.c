@@ -97,6 +97,9 @@ enum proc_node_e
 #ifdef CONFIG_SCHED_CRITMONITOR
   PROC_CRITMON,                       /* Critical section monitor */
 #endif
+#ifdef CONFIG_SCHED_LATENCY
+  PROC_LATENCY,                       /* Scheduling latency histograms */
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
   PROC_HEAP,                          /* Task heap info */
 #endif
@@ -188,6 +191,11 @@ static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
                  off_t offset);
 #endif
+#ifdef CONFIG_SCHED_LATENCY
+static ssize_t proc_latency(FAR struct proc_file_s *procfile,
+                 FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
+                 off_t offset);
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
 static ssize_t proc_heap(FAR struct proc_file_s *procfile,
                          FAR struct tcb_s *tcb, FAR char *buffer,
@@ -300,6 +308,13 @@ static const struct proc_node_s g_critmon =
 };
 #endif
 
+#ifdef CONFIG_SCHED_LATENCY
+static const struct proc_node_s g_latency =
+{
+  "latency",       "latency", (uint8_t)PROC_LATENCY,     DTYPE_FILE        /* Scheduling latency */
+};
+#endif
+
 #if CONFIG_MM_BACKTRACE >= 0
 static const struct proc_node_s g_heap =
 {
@@ -354,6 +369,9 @@ static FAR const struct proc_node_s * const g_nodeinfo[] =
 #ifdef CONFIG_SCHED_CRITMONITOR
   &g_critmon,      /* Critical section Monitor */
 #endif
+#ifdef CONFIG_SCHED_LATENCY
+  &g_latency,      /* Scheduling latency histograms */
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
   &g_heap,         /* Task heap info */
 #endif
@@ -383,6 +401,9 @@ static const struct proc_node_s * const g_level0info[] =
 #ifdef CONFIG_SCHED_CRITMONITOR
   &g_critmon,      /* Critical section monitor */
 #endif
+#ifdef CONFIG_SCHED_LATENCY
+  &g_latency,      /* Scheduling latency histograms */
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
   &g_heap,         /* Task heap info */
 #endif
@@ -878,6 +899,57 @@ static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
 }
 #endif
 
+/****************************************************************************
+ * Name: proc_latency
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LATENCY
+static ssize_t proc_latency(FAR struct proc_file_s *procfile,
+                            FAR struct tcb_s *tcb, FAR char *buffer,
+                            size_t buflen, off_t offset)
+{
+  static FAR const char * const names[SCHED_LATENCY_NTYPES] =
+  {
+    "wakeup", "runqueue", "irq"
+  };
+
+  FAR struct sched_latency_s *latency;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize = 0;
+  int type;
+  int i;
+
+  /* One line per latency type: count, maximum and the log2 histogram,
+   * all in microseconds, bucket n counting the samples below 2^n.
+   */
+
+  for (type = 0; type < SCHED_LATENCY_NTYPES && totalsize < buflen; type++)
+    {
+      latency  = &tcb->latency[type];
+      linesize = procfs_snprintf(procfile->line, STATUS_LINELEN,
+                                 "%-10s%9" PRIu32 "%9" PRIu32,
+                                 names[type], latency->count, latency->max);
+
+      for (i = 0; i < SCHED_LATENCY_NBUCKETS; i++)
+        {
+          linesize += procfs_snprintf(procfile->line + linesize,
+                                      STATUS_LINELEN - linesize,
+                                      "%9" PRIu32, latency->bucket[i]);
+        }
+
+      linesize  += procfs_snprintf(procfile->line + linesize,
+                                   STATUS_LINELEN - linesize, "\n");
+      copysize   = procfs_memcpy(procfile->line, linesize,
+                                 buffer + totalsize, buflen - totalsize,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: proc_heap
  ****************************************************************************/
@@ -1624,6 +1696,11 @@ static ssize_t proc_read(FAR struct file *filep, FAR char *buffer,
       ret = proc_critmon(procfile, tcb, buffer, buflen, filep->f_pos);
       break;
 #endif
+#ifdef CONFIG_SCHED_LATENCY
+    case PROC_LATENCY: /* Scheduling latency histograms */
+      ret = proc_latency(procfile, tcb, buffer, buflen, filep->f_pos);
+      break;
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
     case PROC_HEAP: /* Task heap info */
       ret = proc_heap(procfile, tcb, buffer, buflen, filep->f_pos);
@@ -1704,6 +1781,15 @@ static ssize_t proc_write(FAR struct file *filep, FAR const char *buffer,
                                    filep->f_pos);
         break;
 #endif
+#ifdef CONFIG_SCHED_LATENCY
+      case PROC_LATENCY:
+
+        /* Any write resets the histograms of the thread */
+
+        nxsched_reset_latency(tcb);
+        ret = buflen;
+        break;
+#endif
 
       default:
         ret = -EINVAL;
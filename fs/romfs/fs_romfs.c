@@ -413,6 +413,19 @@ static ssize_t romfs_read(FAR struct file *filep, FAR char *buffer,
       buflen = bytesleft;
     }
 
+  /* In XIP mode, the file is contiguous in the address space.  Copy the
+   * whole request at once instead of sector by sector.
+   */
+
+  if (rm->rm_xipbase)
+    {
+      memcpy(userbuffer,
+             rm->rm_xipbase + rf->rf_startoffset + filep->f_pos, buflen);
+      filep->f_pos += buflen;
+      readsize      = buflen;
+      goto errout_with_lock;
+    }
+
   /* Loop until either (1) all data has been transferred, or (2) an
    * error occurs.
    */
@@ -71,6 +71,11 @@ struct rpmsgfs_ofile_s
   int16_t                    crefs;    /* Reference count */
   mode_t                     oflags;   /* Open mode */
   int                        fd;
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  FAR char                   *rabuf;   /* Read-ahead buffer */
+  size_t                     ralen;    /* Valid bytes in rabuf */
+  size_t                     rapos;    /* Bytes of rabuf already consumed */
+#endif
 };
 
 /* This structure represents the overall mountpoint state.  An instance of
@@ -268,6 +273,111 @@ static void rpmsgfs_mkpath(FAR struct rpmsgfs_mountpt_s *fs,
     }
 }
 
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+/****************************************************************************
+ * Name: rpmsgfs_ra_drop
+ *
+ * Description:
+ *   Drop the read-ahead data and move the remote file position back to
+ *   the position seen by the user.
+ *
+ ****************************************************************************/
+
+static int rpmsgfs_ra_drop(FAR struct rpmsgfs_mountpt_s *fs,
+                           FAR struct rpmsgfs_ofile_s *hf)
+{
+  off_t unread = hf->ralen - hf->rapos;
+  off_t ret;
+
+  hf->ralen = 0;
+  hf->rapos = 0;
+
+  if (unread > 0)
+    {
+      ret = rpmsgfs_client_lseek(fs->handle, hf->fd, -unread, SEEK_CUR);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: rpmsgfs_ra_read
+ ****************************************************************************/
+
+static ssize_t rpmsgfs_ra_read(FAR struct rpmsgfs_mountpt_s *fs,
+                               FAR struct rpmsgfs_ofile_s *hf,
+                               FAR char *buffer, size_t buflen)
+{
+  size_t nread = 0;
+  ssize_t ret;
+
+  while (nread < buflen)
+    {
+      if (hf->rapos < hf->ralen)
+        {
+          ret = hf->ralen - hf->rapos;
+          if (ret > buflen - nread)
+            {
+              ret = buflen - nread;
+            }
+
+          memcpy(buffer + nread, hf->rabuf + hf->rapos, ret);
+          hf->rapos += ret;
+          nread     += ret;
+
+          /* A short fill means the end of the file was reached */
+
+          if (hf->ralen < CONFIG_FS_RPMSGFS_READAHEAD)
+            {
+              break;
+            }
+
+          continue;
+        }
+
+      /* Large reads go straight to the caller's buffer */
+
+      if (buflen - nread >= CONFIG_FS_RPMSGFS_READAHEAD)
+        {
+          ret = rpmsgfs_client_read(fs->handle, hf->fd, buffer + nread,
+                                    buflen - nread);
+          if (ret <= 0)
+            {
+              return nread > 0 ? nread : ret;
+            }
+
+          return nread + ret;
+        }
+
+      if (hf->rabuf == NULL)
+        {
+          hf->rabuf = fs_heap_malloc(CONFIG_FS_RPMSGFS_READAHEAD);
+          if (hf->rabuf == NULL)
+            {
+              return nread > 0 ? nread : -ENOMEM;
+            }
+        }
+
+      hf->rapos = 0;
+      hf->ralen = 0;
+      ret = rpmsgfs_client_read(fs->handle, hf->fd, hf->rabuf,
+                                CONFIG_FS_RPMSGFS_READAHEAD);
+      if (ret <= 0)
+        {
+          return nread > 0 ? nread : ret;
+        }
+
+      hf->ralen = ret;
+    }
+
+  return nread;
+}
+#endif
+
 /****************************************************************************
  * Name: rpmsgfs_open
  ****************************************************************************/
@@ -363,6 +473,11 @@ static int rpmsgfs_open(FAR struct file *filep, FAR const char *relpath,
   hf->fnext = fs->fs_head;
   hf->crefs = 1;
   hf->oflags = oflags;
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  hf->rabuf = NULL;
+  hf->ralen = 0;
+  hf->rapos = 0;
+#endif
   fs->fs_head = hf;
 
   ret = OK;
@@ -464,6 +579,9 @@ static int rpmsgfs_close(FAR struct file *filep)
   /* Now free the pointer */
 
   filep->f_priv = NULL;
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  fs_heap_free(hf->rabuf);
+#endif
   fs_heap_free(hf);
 
 okout:
@@ -505,7 +623,11 @@ static ssize_t rpmsgfs_read(FAR struct file *filep, FAR char *buffer,
 
   /* Call the host to perform the read */
 
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  ret = rpmsgfs_ra_read(fs, hf, buffer, buflen);
+#else
   ret = rpmsgfs_client_read(fs->handle, hf->fd, buffer, buflen);
+#endif
   if (ret > 0)
     {
       filep->f_pos += ret;
@@ -555,6 +677,14 @@ static ssize_t rpmsgfs_write(FAR struct file *filep, const char *buffer,
       goto errout_with_lock;
     }
 
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  ret = rpmsgfs_ra_drop(fs, hf);
+  if (ret < 0)
+    {
+      goto errout_with_lock;
+    }
+#endif
+
   /* Call the host to perform the write */
 
   ret = rpmsgfs_client_write(fs->handle, hf->fd, buffer, buflen);
@@ -599,12 +729,34 @@ static off_t rpmsgfs_seek(FAR struct file *filep, off_t offset, int whence)
       return ret;
     }
 
-  /* Call our internal routine to perform the seek */
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  /* Seeks within the read-ahead buffer need no round trip */
+
+  if (whence == SEEK_SET || whence == SEEK_CUR)
+    {
+      off_t pos = whence == SEEK_SET ? offset : filep->f_pos + offset;
+      off_t start = filep->f_pos - hf->rapos;
 
-  ret = rpmsgfs_client_lseek(fs->handle, hf->fd, offset, whence);
+      if (hf->ralen > 0 && pos >= start && pos <= start + hf->ralen)
+        {
+          hf->rapos    = pos - start;
+          filep->f_pos = pos;
+          nxmutex_unlock(&fs->fs_lock);
+          return pos;
+        }
+    }
+
+  ret = rpmsgfs_ra_drop(fs, hf);
   if (ret >= 0)
+#endif
     {
-      filep->f_pos = ret;
+      /* Call our internal routine to perform the seek */
+
+      ret = rpmsgfs_client_lseek(fs->handle, hf->fd, offset, whence);
+      if (ret >= 0)
+        {
+          filep->f_pos = ret;
+        }
     }
 
   nxmutex_unlock(&fs->fs_lock);
@@ -642,6 +794,15 @@ static int rpmsgfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
       return ret;
     }
 
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  ret = rpmsgfs_ra_drop(fs, hf);
+  if (ret < 0)
+    {
+      nxmutex_unlock(&fs->fs_lock);
+      return ret;
+    }
+#endif
+
   /* Call our internal routine to perform the ioctl */
 
   ret = rpmsgfs_client_ioctl(fs->handle, hf->fd, cmd, arg);
@@ -689,6 +850,9 @@ static int rpmsgfs_sync(FAR struct file *filep)
       return ret;
     }
 
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  rpmsgfs_ra_drop(fs, hf);
+#endif
   rpmsgfs_client_sync(fs->handle, hf->fd);
 
   nxmutex_unlock(&fs->fs_lock);
@@ -852,7 +1016,13 @@ static int rpmsgfs_truncate(FAR struct file *filep, off_t length)
 
   /* Call the host to perform the truncate */
 
-  ret = rpmsgfs_client_ftruncate(fs->handle, hf->fd, length);
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  ret = rpmsgfs_ra_drop(fs, hf);
+  if (ret >= 0)
+#endif
+    {
+      ret = rpmsgfs_client_ftruncate(fs->handle, hf->fd, length);
+    }
 
   nxmutex_unlock(&fs->fs_lock);
   return ret;
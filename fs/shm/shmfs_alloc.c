@@ -102,6 +102,9 @@ FAR struct shmfs_object_s *shmfs_alloc_object(size_t length)
   size_t i = 0;
   FAR void **pages;
   size_t n_pages = MM_NPAGES(length);
+#ifdef CONFIG_MM_PGALLOC_LARGEPAGE
+  uintptr_t paddr;
+#endif
 
   object = fs_heap_zalloc(sizeof(struct shmfs_object_s) +
                       (n_pages - 1) * sizeof(object->paddr));
@@ -109,6 +112,23 @@ FAR struct shmfs_object_s *shmfs_alloc_object(size_t length)
   if (object)
     {
       pages = &object->paddr;
+
+#ifdef CONFIG_MM_PGALLOC_LARGEPAGE
+      /* shm_open() has no flag to ask for large pages, so try them first
+       * and fall back to separate pages.
+       */
+
+      paddr = mm_pgalloc_large(n_pages);
+      if (paddr != 0)
+        {
+          for (; i < n_pages; i++, paddr += MM_PGSIZE)
+            {
+              pages[i] = (FAR void *)paddr;
+              up_addrenv_page_wipe(paddr);
+            }
+        }
+#endif
+
       for (; i < n_pages; i++)
         {
           pages[i] = (FAR void *)mm_pgalloc(1);
@@ -24,6 +24,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/param.h>
 #include <sys/stat.h>
 #include <sys/statfs.h>
 #include <stdint.h>
@@ -52,8 +53,14 @@
 #  warning CONFIG_FS_TMPFS_DIRECTORY_FREEGUARD needs to be > ALLOCGUARD
 #endif
 
-#if CONFIG_FS_TMPFS_FILE_FREEGUARD <= CONFIG_FS_TMPFS_FILE_ALLOCGUARD
-#  warning CONFIG_FS_TMPFS_FILE_FREEGUARD needs to be > ALLOCGUARD
+#if CONFIG_FS_TMPFS_FILE_EXTENTSIZE < CONFIG_FS_TMPFS_FILE_ALLOCGUARD
+#  warning CONFIG_FS_TMPFS_FILE_EXTENTSIZE needs to be >= ALLOCGUARD
+#endif
+
+#if defined(CONFIG_FS_LARGEFILE)
+#  define OFF_MAX INT64_MAX
+#else
+#  define OFF_MAX INT32_MAX
 #endif
 
 #define tmpfs_lock(fs) \
@@ -92,8 +99,6 @@ struct tmpfs_dir_s
 
 static int  tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
               unsigned int nentries);
-static int  tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
-              size_t newsize);
 static void tmpfs_release_lockedobject(FAR struct tmpfs_object_s *to);
 static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo);
 static int  tmpfs_release_file(FAR struct tmpfs_file_s *tfo);
@@ -265,80 +270,334 @@ static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
 }
 
 /****************************************************************************
- * Name: tmpfs_realloc_file
+ * Name: tmpfs_find_extent
+ *
+ * Description:
+ *   Return the index of the last extent starting at or before the file
+ *   offset, or -1 if there is none.
+ *
+ ****************************************************************************/
+
+static int tmpfs_find_extent(FAR struct tmpfs_file_s *tfo, off_t offset)
+{
+  int low = 0;
+  int high = (int)tfo->tfo_nextents - 1;
+  int mid;
+
+  while (low <= high)
+    {
+      mid = (low + high) / 2;
+      if (tfo->tfo_extents[mid]->te_offset <= offset)
+        {
+          low = mid + 1;
+        }
+      else
+        {
+          high = mid - 1;
+        }
+    }
+
+  return high;
+}
+
+/****************************************************************************
+ * Name: tmpfs_alloc_extent
+ *
+ * Description:
+ *   Allocate a new extent for at least nbytes at the file offset and insert
+ *   it after the extent at index.  The capacity grows with the file size up
+ *   to CONFIG_FS_TMPFS_FILE_EXTENTSIZE, so that appends are served from the
+ *   unused capacity of the last extent most of the time, but never extends
+ *   past limit.
+ *
  ****************************************************************************/
 
-static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
-                              size_t newsize)
+static FAR struct tmpfs_extent_s *
+tmpfs_alloc_extent(FAR struct tmpfs_file_s *tfo, int index, off_t offset,
+                   size_t nbytes, off_t limit)
 {
-  FAR uint8_t *newdata;
+  FAR struct tmpfs_extent_s **extents;
+  FAR struct tmpfs_extent_s *te;
   size_t allocsize;
-  size_t delta;
+  unsigned int maxextents;
 
-  /* Are we growing or shrinking the object? */
+  allocsize = MAX(tfo->tfo_size, CONFIG_FS_TMPFS_FILE_ALLOCGUARD);
+  allocsize = MIN(allocsize, CONFIG_FS_TMPFS_FILE_EXTENTSIZE);
+  allocsize = MAX(allocsize, nbytes);
+  if (allocsize > limit - offset)
+    {
+      allocsize = limit - offset;
+    }
 
-  if (newsize <= tfo->tfo_alloc)
+  if (SIZEOF_TMPFS_EXTENT(allocsize) < allocsize)
     {
-      /* Shrinking ... Shrink unconditionally if the size is shrinking to
-       * zero.
-       */
+      /* There must have been an integer overflow */
+
+      return NULL;
+    }
 
-      if (newsize == 0)
+  /* Make room in the extent array */
+
+  if (tfo->tfo_nextents >= tfo->tfo_maxextents)
+    {
+      maxextents = tfo->tfo_maxextents ? 2 * tfo->tfo_maxextents : 4;
+      extents = fs_heap_realloc(tfo->tfo_extents,
+                                maxextents * sizeof(*extents));
+      if (extents == NULL)
         {
-          /* Free the file object */
+          return NULL;
+        }
+
+      tfo->tfo_extents    = extents;
+      tfo->tfo_maxextents = maxextents;
+    }
+
+  te = fs_heap_malloc(SIZEOF_TMPFS_EXTENT(allocsize));
+  if (te == NULL)
+    {
+      return NULL;
+    }
+
+  te->te_offset = offset;
+  te->te_length = 0;
+  te->te_alloc  = allocsize;
+
+  index++;
+  memmove(&tfo->tfo_extents[index + 1], &tfo->tfo_extents[index],
+          (tfo->tfo_nextents - index) * sizeof(*tfo->tfo_extents));
+  tfo->tfo_extents[index] = te;
+  tfo->tfo_nextents++;
+  tfo->tfo_alloc += allocsize;
+  return te;
+}
+
+/****************************************************************************
+ * Name: tmpfs_free_extents
+ *
+ * Description:
+ *   Free all extents starting at index.
+ *
+ ****************************************************************************/
+
+static void tmpfs_free_extents(FAR struct tmpfs_file_s *tfo,
+                               unsigned int index)
+{
+  FAR struct tmpfs_extent_s *te;
 
-          fs_heap_free(tfo->tfo_data);
-          tfo->tfo_data = NULL;
-          tfo->tfo_alloc = 0;
-          tfo->tfo_size = 0;
-          return OK;
+  while (tfo->tfo_nextents > index)
+    {
+      te = tfo->tfo_extents[--tfo->tfo_nextents];
+      tfo->tfo_alloc -= te->te_alloc;
+      fs_heap_free(te);
+    }
+}
+
+/****************************************************************************
+ * Name: tmpfs_free_data
+ ****************************************************************************/
+
+static void tmpfs_free_data(FAR struct tmpfs_file_s *tfo)
+{
+  tmpfs_free_extents(tfo, 0);
+  fs_heap_free(tfo->tfo_extents);
+
+  tfo->tfo_extents    = NULL;
+  tfo->tfo_maxextents = 0;
+  tfo->tfo_size       = 0;
+}
+
+/****************************************************************************
+ * Name: tmpfs_read_file
+ *
+ * Description:
+ *   Copy file data to a buffer.  The range must lie within the file.
+ *
+ ****************************************************************************/
+
+static void tmpfs_read_file(FAR struct tmpfs_file_s *tfo, off_t offset,
+                            FAR uint8_t *buffer, size_t buflen)
+{
+  FAR struct tmpfs_extent_s *te;
+  off_t next;
+  size_t nbytes;
+  int index;
+
+  while (buflen > 0)
+    {
+      index = tmpfs_find_extent(tfo, offset);
+      te    = index >= 0 ? tfo->tfo_extents[index] : NULL;
+
+      if (te != NULL && offset < te->te_offset + (off_t)te->te_length)
+        {
+          nbytes = MIN(buflen, te->te_offset + te->te_length - offset);
+          memcpy(buffer, &te->te_data[offset - te->te_offset], nbytes);
         }
-      else if (newsize > 0)
+      else
         {
-          /* Otherwise, don't realloc unless the object has shrunk by a
-           * lot.
-           */
+          /* A hole, up to the next extent */
 
-          delta = tfo->tfo_alloc - newsize;
+          next   = index + 1 < (int)tfo->tfo_nextents ?
+                   tfo->tfo_extents[index + 1]->te_offset : tfo->tfo_size;
+          nbytes = MIN(buflen, next - offset);
+          memset(buffer, 0, nbytes);
+        }
 
-          /* We should make sure the shrunked memory be zero */
+      offset += nbytes;
+      buffer += nbytes;
+      buflen -= nbytes;
+    }
+}
 
-          memset(tfo->tfo_data + newsize, 0, delta);
-          if (delta <= CONFIG_FS_TMPFS_FILE_FREEGUARD)
-            {
-              /* Hasn't shrunk enough.. Return doing nothing for now */
+/****************************************************************************
+ * Name: tmpfs_write_file
+ *
+ * Description:
+ *   Copy a buffer to the file, extending it if needed.  Existing extents
+ *   never move, only new extents are allocated.
+ *
+ * Returned Value:
+ *   The number of bytes written, or -ENOMEM if nothing could be written.
+ *
+ ****************************************************************************/
+
+static ssize_t tmpfs_write_file(FAR struct tmpfs_file_s *tfo, off_t offset,
+                                FAR const uint8_t *buffer, size_t buflen)
+{
+  FAR struct tmpfs_extent_s *te;
+  size_t nwritten = 0;
+  size_t nbytes;
+  off_t limit;
+  off_t pos;
+  int index;
+
+  while (nwritten < buflen)
+    {
+      index = tmpfs_find_extent(tfo, offset);
+      te    = index >= 0 ? tfo->tfo_extents[index] : NULL;
+      limit = index + 1 < (int)tfo->tfo_nextents ?
+              tfo->tfo_extents[index + 1]->te_offset : OFF_MAX;
 
-              tfo->tfo_size = newsize;
-              return OK;
+      if (te == NULL || offset >= te->te_offset + (off_t)te->te_alloc)
+        {
+          /* Not within the capacity of an extent, allocate a new one */
+
+          nbytes = MIN(buflen - nwritten, limit - offset);
+          te = tmpfs_alloc_extent(tfo, index, offset, nbytes, limit);
+          if (te == NULL)
+            {
+              break;
             }
         }
+
+      /* Copy the data, zeroing the unused capacity skipped over */
+
+      pos    = offset - te->te_offset;
+      nbytes = MIN(buflen - nwritten, te->te_alloc - pos);
+      if (pos > te->te_length)
+        {
+          memset(&te->te_data[te->te_length], 0, pos - te->te_length);
+        }
+
+      memcpy(&te->te_data[pos], &buffer[nwritten], nbytes);
+      if (pos + nbytes > te->te_length)
+        {
+          te->te_length = pos + nbytes;
+        }
+
+      offset   += nbytes;
+      nwritten += nbytes;
     }
 
-  /* Added some additional amount to the new size to account frequent
-   * reallocations.
-   */
+  if (offset > tfo->tfo_size)
+    {
+      tfo->tfo_size = offset;
+    }
+
+  return nwritten > 0 || buflen == 0 ? (ssize_t)nwritten : -ENOMEM;
+}
+
+/****************************************************************************
+ * Name: tmpfs_resize_file
+ *
+ * Description:
+ *   Change the size of the file.  Growing the file only creates a hole,
+ *   shrinking it frees the extents past the new end of the file.
+ *
+ ****************************************************************************/
 
-  allocsize = newsize + CONFIG_FS_TMPFS_FILE_ALLOCGUARD;
-  if (allocsize < newsize)
+static void tmpfs_resize_file(FAR struct tmpfs_file_s *tfo, size_t newsize)
+{
+  FAR struct tmpfs_extent_s *te;
+  int index;
+
+  if (newsize == 0)
     {
-      /* There must have been an integer overflow */
+      tmpfs_free_data(tfo);
+    }
+  else if (newsize < tfo->tfo_size)
+    {
+      index = tmpfs_find_extent(tfo, newsize - 1);
+      tmpfs_free_extents(tfo, index + 1);
 
-      return -ENOMEM;
+      if (index >= 0)
+        {
+          te = tfo->tfo_extents[index];
+          te->te_length = MIN(te->te_length, newsize - te->te_offset);
+        }
     }
 
-  /* Realloc the file object */
+  tfo->tfo_size = newsize;
+}
+
+/****************************************************************************
+ * Name: tmpfs_coalesce_file
+ *
+ * Description:
+ *   Replace the extents of the file with a single one, so that it can be
+ *   mapped.
+ *
+ ****************************************************************************/
+
+static int tmpfs_coalesce_file(FAR struct tmpfs_file_s *tfo)
+{
+  FAR struct tmpfs_extent_s **extents;
+  FAR struct tmpfs_extent_s *te;
+
+  if (SIZEOF_TMPFS_EXTENT(tfo->tfo_size) < tfo->tfo_size)
+    {
+      return -ENOMEM;
+    }
 
-  newdata = fs_heap_realloc(tfo->tfo_data, allocsize);
-  if (newdata == NULL)
+  te = fs_heap_malloc(SIZEOF_TMPFS_EXTENT(tfo->tfo_size));
+  if (te == NULL)
     {
       return -ENOMEM;
     }
 
-  /* Return the new address of the reallocated file object */
+  te->te_offset = 0;
+  te->te_length = tfo->tfo_size;
+  te->te_alloc  = tfo->tfo_size;
+  tmpfs_read_file(tfo, 0, te->te_data, tfo->tfo_size);
+
+  if (tfo->tfo_maxextents == 0)
+    {
+      /* The file was one big hole */
+
+      extents = fs_heap_malloc(sizeof(*extents));
+      if (extents == NULL)
+        {
+          fs_heap_free(te);
+          return -ENOMEM;
+        }
 
-  tfo->tfo_alloc = allocsize;
-  tfo->tfo_size  = newsize;
-  tfo->tfo_data  = newdata;
+      tfo->tfo_extents    = extents;
+      tfo->tfo_maxextents = 1;
+    }
+
+  tmpfs_free_extents(tfo, 0);
+  tfo->tfo_extents[0] = te;
+  tfo->tfo_nextents   = 1;
+  tfo->tfo_alloc     += te->te_alloc;
   return OK;
 }
 
@@ -379,7 +638,7 @@ static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo)
     {
       tmpfs_unlock_file(tfo);
       nxrmutex_destroy(&tfo->tfo_lock);
-      fs_heap_free(tfo->tfo_data);
+      tmpfs_free_data(tfo);
       fs_heap_free(tfo);
     }
 
@@ -578,7 +837,6 @@ tmpfs_alloc_file(FAR struct tmpfs_directory_s *parent)
   tfo->tfo_parent = parent;
   tfo->tfo_flags  = 0;
   tfo->tfo_size   = 0;
-  tfo->tfo_data   = NULL;
 
   nxrmutex_init(&tfo->tfo_lock);
   tmpfs_lock_file(tfo);
@@ -1170,14 +1428,24 @@ static int tmpfs_statfs_callout(FAR struct tmpfs_directory_s *tdo,
   if (to->to_type == TMPFS_REGULAR)
     {
       FAR struct tmpfs_file_s *tmptfo;
+      unsigned int i;
 
       /* It is a file object.  Increment the number of files and update the
        * amount of memory in use.
        */
 
       tmptfo             = (FAR struct tmpfs_file_s *)to;
-      tmpbuf->tsf_alloc += sizeof(struct tmpfs_file_s);
-      tmpbuf->tsf_avail += to->to_alloc - tmptfo->tfo_size;
+      tmpbuf->tsf_alloc += sizeof(struct tmpfs_file_s) +
+                           tmptfo->tfo_maxextents *
+                           sizeof(FAR struct tmpfs_extent_s *) +
+                           tmptfo->tfo_nextents * SIZEOF_TMPFS_EXTENT(0);
+
+      for (i = 0; i < tmptfo->tfo_nextents; i++)
+        {
+          tmpbuf->tsf_avail += tmptfo->tfo_extents[i]->te_alloc -
+                               tmptfo->tfo_extents[i]->te_length;
+        }
+
       tmpbuf->tsf_files++;
     }
   else /* if (to->to_type == TMPFS_DIRECTORY) */
@@ -1253,7 +1521,7 @@ static int tmpfs_free_callout(FAR struct tmpfs_directory_s *tdo,
           return TMPFS_UNLINKED;
         }
 
-      fs_heap_free(tfo->tfo_data);
+      tmpfs_free_data(tfo);
     }
   else /* if (to->to_type == TMPFS_DIRECTORY) */
     {
@@ -1426,11 +1694,7 @@ static int tmpfs_open(FAR struct file *filep, FAR const char *relpath,
 
           if (tfo->tfo_size > 0)
             {
-              ret = tmpfs_realloc_file(tfo, 0);
-              if (ret < 0)
-                {
-                  goto errout_with_filelock;
-                }
+              tmpfs_resize_file(tfo, 0);
             }
         }
     }
@@ -1574,15 +1838,8 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
 
   /* Copy data from the memory object to the user buffer */
 
-  if (tfo->tfo_data != NULL)
-    {
-      memcpy(buffer, &tfo->tfo_data[startpos], nread);
-      filep->f_pos += nread;
-    }
-  else
-    {
-      DEBUGASSERT(tfo->tfo_size == 0 && nread == 0);
-    }
+  tmpfs_read_file(tfo, startpos, (FAR uint8_t *)buffer, nread);
+  filep->f_pos += nread;
 
   /* Release the lock on the file */
 
@@ -1600,7 +1857,6 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
   FAR struct tmpfs_file_s *tfo;
   ssize_t nwritten;
   off_t startpos;
-  off_t endpos;
   int ret;
 
   finfo("filep: %p buffer: %p buflen: %lu\n",
@@ -1630,41 +1886,21 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
       startpos = filep->f_pos;
     }
 
-  nwritten = buflen;
-  endpos   = startpos + buflen;
-
-  if (endpos > tfo->tfo_size)
-    {
-      /* Reallocate the file to handle the write past the end of the file. */
-
-      ret = tmpfs_realloc_file(tfo, (size_t)endpos);
-      if (ret < 0)
-        {
-          goto errout_with_lock;
-        }
-    }
-
-  /* Copy data from the memory object to the user buffer */
+  /* Copy data from the user buffer to the memory object, new extents are
+   * allocated for the data past the end of the file.
+   */
 
-  if (tfo->tfo_data != NULL)
+  nwritten = tmpfs_write_file(tfo, startpos, (FAR const uint8_t *)buffer,
+                              buflen);
+  if (nwritten > 0)
     {
-      memcpy(&tfo->tfo_data[startpos], buffer, nwritten);
+      filep->f_pos = startpos + nwritten;
     }
-  else
-    {
-      DEBUGASSERT(tfo->tfo_size == 0 && nwritten == 0);
-    }
-
-  filep->f_pos = endpos;
 
   /* Release the lock on the file */
 
   tmpfs_unlock_file(tfo);
   return nwritten;
-
-errout_with_lock:
-  tmpfs_unlock_file(tfo);
-  return (ssize_t)ret;
 }
 
 /****************************************************************************
@@ -1741,7 +1977,9 @@ static int tmpfs_unmap(FAR struct task_group_s *group,
       ret = mm_map_remove(get_group_mm(group), entry);
       if (ret >= 0)
         {
-          ret = tmpfs_release_file(tfo);
+          tmpfs_lock_file(tfo);
+          tfo->tfo_nmaps--;
+          tmpfs_release_lockedfile(tfo);
         }
     }
 
@@ -1753,8 +1991,9 @@ static int tmpfs_unmap(FAR struct task_group_s *group,
     {
       entry->length = offset;
       tmpfs_lock_file(tfo);
-      ret = tmpfs_realloc_file(tfo, offset);
+      tmpfs_resize_file(tfo, offset);
       tmpfs_unlock_file(tfo);
+      ret = OK;
     }
 
   return ret;
@@ -1762,8 +2001,10 @@ static int tmpfs_unmap(FAR struct task_group_s *group,
 
 static int tmpfs_mmap(FAR struct file *filep, FAR struct mm_map_entry_s *map)
 {
+  FAR struct tmpfs_extent_s *te = NULL;
   FAR struct tmpfs_file_s *tfo;
-  int ret = -EINVAL;
+  int index;
+  int ret;
 
   DEBUGASSERT(filep->f_priv != NULL);
 
@@ -1773,22 +2014,62 @@ static int tmpfs_mmap(FAR struct file *filep, FAR struct mm_map_entry_s *map)
 
   DEBUGASSERT(tfo != NULL);
 
-  if (map->offset >= 0 && map->offset < tfo->tfo_size &&
-      map->length && map->offset + map->length <= tfo->tfo_size)
+  ret = tmpfs_lock_file(tfo);
+  if (ret < 0)
     {
-      map->vaddr = tfo->tfo_data + map->offset;
-      map->priv.p = tfo;
-      map->munmap = tmpfs_unmap;
-      ret = mm_map_add(get_current_mm(), map);
+      return ret;
+    }
 
-      if (ret >= 0)
+  if (map->offset < 0 || map->offset >= tfo->tfo_size ||
+      map->length == 0 || map->offset + map->length > tfo->tfo_size)
+    {
+      ret = -EINVAL;
+      goto errout_with_lock;
+    }
+
+  /* The range is mapped in place if it lies within one extent.  Otherwise
+   * the file is first coalesced into a single extent, which is only
+   * possible while no other mapping references the current extents; fall
+   * back to a copy (-ENOTTY) in that case.
+   */
+
+  index = tmpfs_find_extent(tfo, map->offset);
+  if (index >= 0)
+    {
+      te = tfo->tfo_extents[index];
+    }
+
+  if (te == NULL ||
+      map->offset + map->length > te->te_offset + te->te_length)
+    {
+      if (tfo->tfo_nmaps > 0)
         {
-          tmpfs_lock_file(tfo);
-          tfo->tfo_refs++;
-          tmpfs_unlock_file(tfo);
+          ret = -ENOTTY;
+          goto errout_with_lock;
+        }
+
+      ret = tmpfs_coalesce_file(tfo);
+      if (ret < 0)
+        {
+          goto errout_with_lock;
         }
+
+      te = tfo->tfo_extents[0];
     }
 
+  map->vaddr = &te->te_data[map->offset - te->te_offset];
+  map->priv.p = tfo;
+  map->munmap = tmpfs_unmap;
+  ret = mm_map_add(get_current_mm(), map);
+
+  if (ret >= 0)
+    {
+      tfo->tfo_refs++;
+      tfo->tfo_nmaps++;
+    }
+
+errout_with_lock:
+  tmpfs_unlock_file(tfo);
   return ret;
 }
 
@@ -1830,8 +2111,30 @@ static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
     {
       FAR uintptr_t *ptr = (FAR uintptr_t *)arg;
 
-      *ptr = (uintptr_t)tfo->tfo_data;
-      return OK;
+      /* Only a file held in a single extent is directly addressable */
+
+      ret = tmpfs_lock_file(tfo);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      if (tfo->tfo_nextents == 0 && tfo->tfo_size == 0)
+        {
+          *ptr = 0;
+        }
+      else if (tfo->tfo_nextents == 1 &&
+               tfo->tfo_extents[0]->te_offset == 0 &&
+               tfo->tfo_extents[0]->te_length == tfo->tfo_size)
+        {
+          *ptr = (uintptr_t)tfo->tfo_extents[0]->te_data;
+        }
+      else
+        {
+          ret = -ENOTTY;
+        }
+
+      tmpfs_unlock_file(tfo);
     }
 
   return ret;
@@ -1956,31 +2259,17 @@ static int tmpfs_truncate(FAR struct file *filep, off_t length)
   oldsize = tfo->tfo_size;
   if (oldsize != length)
     {
-      /* The size is changing.. up or down.  Reallocate the file memory. */
-
-      ret = tmpfs_realloc_file(tfo, (size_t)length);
-      if (ret < 0)
-        {
-          goto errout_with_lock;
-        }
-
-      /* If the size has increased, then we need to zero the newly added
-       * memory.
+      /* The size is changing.. up or down.  Growing the file leaves a hole
+       * which reads as zeros, shrinking it frees the extents past the end.
        */
 
-      if (length > oldsize)
-        {
-          memset(&tfo->tfo_data[oldsize], 0, length - oldsize);
-        }
-
-      ret = OK;
+      tmpfs_resize_file(tfo, (size_t)length);
     }
 
   /* Release the lock on the file */
 
-errout_with_lock:
   tmpfs_unlock_file(tfo);
-  return ret;
+  return OK;
 }
 
 /****************************************************************************
@@ -2414,7 +2703,7 @@ static int tmpfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
   else
     {
       nxrmutex_destroy(&tfo->tfo_lock);
-      fs_heap_free(tfo->tfo_data);
+      tmpfs_free_data(tfo);
       fs_heap_free(tfo);
     }
 
@@ -27,6 +27,7 @@
 
 #include <nuttx/config.h>
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <nuttx/fs/fs.h>
@@ -103,6 +104,22 @@ struct tmpfs_directory_s
 
 #define SIZEOF_TMPFS_DIRECTORY(n) ((n) * sizeof(struct tmpfs_dirent_s))
 
+/* One extent of file data.  The extents of a file are sorted by offset
+ * and do not overlap, including their unused capacity.  Ranges of the
+ * file not covered by the valid data of an extent are holes, which read
+ * as zeros.
+ */
+
+struct tmpfs_extent_s
+{
+  off_t    te_offset;    /* File offset of te_data[0] */
+  size_t   te_length;    /* Number of valid bytes in te_data */
+  size_t   te_alloc;     /* Capacity of te_data */
+  uint8_t  te_data[1];   /* Extent data starts here */
+};
+
+#define SIZEOF_TMPFS_EXTENT(n) (offsetof(struct tmpfs_extent_s, te_data) + (n))
+
 /* The form of a regular file memory object
  *
  * NOTE that in this very simplified implementation, there is no per-open
@@ -124,9 +141,12 @@ struct tmpfs_file_s
 
   /* Remaining fields are unique to a directory object */
 
-  uint8_t       tfo_flags; /* See TFO_FLAG_* definitions */
-  size_t        tfo_size;  /* Valid file size */
-  FAR uint8_t  *tfo_data;  /* File data starts here */
+  uint8_t       tfo_flags;    /* See TFO_FLAG_* definitions */
+  uint16_t      tfo_nmaps;    /* Number of mmap() mappings */
+  size_t        tfo_size;     /* Valid file size */
+  unsigned int  tfo_nextents; /* Number of extents */
+  unsigned int  tfo_maxextents;
+  FAR struct tmpfs_extent_s **tfo_extents; /* Extents, sorted by offset */
 };
 
 /* This structure represents one instance of a TMPFS file system */
@@ -774,17 +774,16 @@ int v9fs_client_statfs(FAR struct v9fs_client_s *client,
 }
 
 /****************************************************************************
- * v9fs_client_stat
+ * v9fs_client_getattr
  ****************************************************************************/
 
-int v9fs_client_stat(FAR struct v9fs_client_s *client, uint32_t fid,
-                     FAR struct stat *buf)
+static int v9fs_client_getattr(FAR struct v9fs_client_s *client,
+                               uint32_t fid,
+                               FAR struct v9fs_rstat_s *response)
 {
   struct v9fs_stat_s request;
-  struct v9fs_rstat_s response;
   struct iovec wiov[1];
   struct iovec riov[1];
-  int ret;
 
   /* size[4] Tgetattr tag[2] fid[4] request_mask[8]
    * size[4] Rgetattr tag[2] valid[8] qid[13] mode[4] uid[4] gid[4] nlink[8]
@@ -802,16 +801,30 @@ int v9fs_client_stat(FAR struct v9fs_client_s *client, uint32_t fid,
 
   wiov[0].iov_base = &request;
   wiov[0].iov_len = V9FS_HDRSZ + V9FS_BIT32SZ + V9FS_BIT64SZ;
-  riov[0].iov_base = &response;
-  riov[0].iov_len = sizeof(response);
+  riov[0].iov_base = response;
+  riov[0].iov_len = sizeof(*response);
 
-  ret = v9fs_client_rpc(client->transport, wiov, 1, riov, 1,
-                        request.header.tag);
+  return v9fs_client_rpc(client->transport, wiov, 1, riov, 1,
+                         request.header.tag);
+}
+
+/****************************************************************************
+ * v9fs_client_stat
+ ****************************************************************************/
+
+int v9fs_client_stat(FAR struct v9fs_client_s *client, uint32_t fid,
+                     FAR struct stat *buf)
+{
+  struct v9fs_rstat_s response;
+  int ret;
+
+  ret = v9fs_client_getattr(client, fid, &response);
   if (ret < 0)
     {
       return ret;
     }
 
+  buf->st_ino   = response.qid.path;
   buf->st_mode  = response.mode;
   buf->st_uid   = response.uid;
   buf->st_gid   = response.gid;
@@ -830,6 +843,35 @@ int v9fs_client_stat(FAR struct v9fs_client_s *client, uint32_t fid,
   return 0;
 }
 
+/****************************************************************************
+ * v9fs_client_getversion
+ *
+ * Description:
+ *   Return the identity (qid path) and the version of a file.  The version
+ *   combines the qid version with the modification time and size, since
+ *   many servers leave the qid version at zero for regular files.
+ *
+ ****************************************************************************/
+
+int v9fs_client_getversion(FAR struct v9fs_client_s *client, uint32_t fid,
+                           FAR uint64_t *ino, FAR uint64_t *version)
+{
+  struct v9fs_rstat_s response;
+  int ret;
+
+  ret = v9fs_client_getattr(client, fid, &response);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  *ino     = response.qid.path;
+  *version = (response.mtime_sec * 1000000000 + response.mtime_nsec) ^
+             (response.size << 32 | response.size >> 32) ^
+             response.qid.version;
+  return 0;
+}
+
 /****************************************************************************
  * v9fs_client_getsize
  ****************************************************************************/
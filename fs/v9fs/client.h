@@ -86,6 +86,8 @@ int v9fs_client_statfs(FAR struct v9fs_client_s *client,
                        FAR struct statfs *buf);
 int v9fs_client_stat(FAR struct v9fs_client_s *client, uint32_t fid,
                      FAR struct stat *buf);
+int v9fs_client_getversion(FAR struct v9fs_client_s *client, uint32_t fid,
+                           FAR uint64_t *ino, FAR uint64_t *version);
 off_t v9fs_client_getsize(FAR struct v9fs_client_s *client, uint32_t fid);
 int v9fs_client_chstat(FAR struct v9fs_client_s *client, uint32_t fid,
                        FAR const struct stat *buf, int flags);
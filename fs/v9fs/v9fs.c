@@ -32,6 +32,7 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/fs/pagecache.h>
 
 #include "inode/inode.h"
 #include "client.h"
@@ -45,6 +46,9 @@ struct v9fs_vfs_file_s
 {
   uint32_t fid;
   mutex_t  lock;
+#ifdef CONFIG_FS_PAGECACHE
+  struct pagecache_file_s cache;
+#endif
 };
 
 struct v9fs_vfs_dirent_s
@@ -153,6 +157,25 @@ const struct mountpt_operations g_v9fs_operations =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: v9fs_vfs_fill
+ *
+ * Description:
+ *   Read from the file at the given offset, also used as the page cache
+ *   fill callback.
+ *
+ ****************************************************************************/
+
+static ssize_t v9fs_vfs_fill(FAR void *arg, FAR char *buffer, off_t offset,
+                             size_t buflen)
+{
+  FAR struct file *filep = arg;
+  FAR struct v9fs_vfs_file_s *file = filep->f_priv;
+
+  return v9fs_client_read(filep->f_inode->i_private, file->fid, buffer,
+                          offset, buflen);
+}
+
 /****************************************************************************
  * Name: v9fs_vfs_open
  ****************************************************************************/
@@ -162,6 +185,10 @@ static int v9fs_vfs_open(FAR struct file *filep, FAR const char *relpath,
 {
   FAR struct v9fs_vfs_file_s *file;
   FAR struct v9fs_client_s *client;
+#ifdef CONFIG_FS_PAGECACHE
+  uint64_t version;
+  uint64_t ino;
+#endif
   int ret;
 
   /* Sanity checks */
@@ -228,6 +255,18 @@ static int v9fs_vfs_open(FAR struct file *filep, FAR const char *relpath,
         }
     }
 
+#ifdef CONFIG_FS_PAGECACHE
+  /* Handles that cannot read still need the cache key, their writes
+   * invalidate the pages read through other handles.
+   */
+
+  pagecache_open(&file->cache, NULL, 0, 0);
+  if (v9fs_client_getversion(client, file->fid, &ino, &version) >= 0)
+    {
+      pagecache_open(&file->cache, client, ino, version);
+    }
+#endif
+
   nxmutex_init(&file->lock);
   filep->f_priv = file;
   return 0;
@@ -271,7 +310,6 @@ static ssize_t v9fs_vfs_read(FAR struct file *filep, FAR char *buffer,
                              size_t buflen)
 {
   FAR struct v9fs_vfs_file_s *file;
-  FAR struct v9fs_client_s *client;
   ssize_t ret;
 
   /* Sanity checks */
@@ -280,11 +318,15 @@ static ssize_t v9fs_vfs_read(FAR struct file *filep, FAR char *buffer,
 
   /* Recover out private data from the struct file instance */
 
-  client = filep->f_inode->i_private;
   file = filep->f_priv;
 
   nxmutex_lock(&file->lock);
-  ret = v9fs_client_read(client, file->fid, buffer, filep->f_pos, buflen);
+#ifdef CONFIG_FS_PAGECACHE
+  ret = pagecache_read(&file->cache, buffer, buflen, filep->f_pos,
+                       v9fs_vfs_fill, filep);
+#else
+  ret = v9fs_vfs_fill(filep, buffer, filep->f_pos, buflen);
+#endif
   if (ret > 0)
     {
       filep->f_pos += ret;
@@ -321,6 +363,14 @@ static ssize_t v9fs_vfs_write(FAR struct file *filep, FAR const char *buffer,
       filep->f_pos += ret;
     }
 
+#ifdef CONFIG_FS_PAGECACHE
+  /* Other handles of the file read without this lock: invalidate after
+   * the write, so that a fill which raced with it is not stored.
+   */
+
+  pagecache_invalidate(&file->cache);
+#endif
+
   nxmutex_unlock(&file->lock);
   return ret;
 }
@@ -450,6 +500,9 @@ static int v9fs_vfs_dup(FAR const struct file *oldp, FAR struct file *newp)
 
   nxmutex_init(&newfile->lock);
   newfile->fid = file->fid;
+#ifdef CONFIG_FS_PAGECACHE
+  newfile->cache = file->cache;
+#endif
   newp->f_priv = newfile;
   return ret;
 }
@@ -486,6 +539,7 @@ static int v9fs_vfs_fchstat(FAR const struct file *filep,
 {
   FAR struct v9fs_vfs_file_s *file;
   FAR struct v9fs_client_s *client;
+  int ret;
 
   /* Sanity checks */
 
@@ -496,7 +550,16 @@ static int v9fs_vfs_fchstat(FAR const struct file *filep,
   client = filep->f_inode->i_private;
   file = filep->f_priv;
 
-  return v9fs_client_chstat(client, file->fid, buf, flags);
+  ret = v9fs_client_chstat(client, file->fid, buf, flags);
+
+#ifdef CONFIG_FS_PAGECACHE
+  if ((flags & CH_STAT_SIZE) != 0)
+    {
+      pagecache_invalidate(&file->cache);
+    }
+#endif
+
+  return ret;
 }
 
 /****************************************************************************
@@ -955,6 +1018,9 @@ static int v9fs_vfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
       return ret;
     }
 
+#ifdef CONFIG_FS_PAGECACHE
+  pagecache_purge(client);
+#endif
   fs_heap_free(client);
   return ret;
 }
@@ -0,0 +1,472 @@
+/****************************************************************************
+ * fs/vfs/fs_pagecache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/list.h>
+#include <nuttx/mutex.h>
+#include <nuttx/fs/pagecache.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PAGECACHE_PAGESIZE  CONFIG_FS_PAGECACHE_PAGESIZE
+#define PAGECACHE_NHASH     (CONFIG_FS_PAGECACHE_NPAGES / 2 + 1)
+
+/* Never read more pages at once than half of the cache can hold */
+
+#define PAGECACHE_WINDOW    MAX(MIN(CONFIG_FS_PAGECACHE_READAHEAD, \
+                                    CONFIG_FS_PAGECACHE_NPAGES / 2), 1)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct pagecache_page_s
+{
+  struct list_node             lru;     /* Most recently used first */
+  FAR struct pagecache_page_s *hnext;   /* Next page in the hash bucket */
+  FAR const void              *owner;   /* NULL: the page is free */
+  uint64_t                     ino;
+  uint64_t                     version;
+  off_t                        index;   /* Page index in the file */
+  size_t                       valid;   /* Less than a page: end of file */
+  char                         data[PAGECACHE_PAGESIZE];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static mutex_t g_pagecache_lock = NXMUTEX_INITIALIZER;
+static struct list_node g_pagecache_lru =
+  LIST_INITIAL_VALUE(g_pagecache_lru);
+static FAR struct pagecache_page_s *g_pagecache_hash[PAGECACHE_NHASH];
+static size_t g_pagecache_npages;
+
+/* Bumped whenever pages are invalidated, so that a fill which raced with
+ * a write does not store the data it read before the write.
+ */
+
+static uint32_t g_pagecache_generation;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pagecache_hash
+ ****************************************************************************/
+
+static size_t pagecache_hash(FAR const void *owner, uint64_t ino,
+                             off_t index)
+{
+  uint64_t hash = (uintptr_t)owner;
+
+  hash = (hash ^ ino) * 0x9e3779b97f4a7c15ull;
+  hash = (hash ^ (uint64_t)index) * 0x9e3779b97f4a7c15ull;
+  return (size_t)(hash >> 32) % PAGECACHE_NHASH;
+}
+
+/****************************************************************************
+ * Name: pagecache_find
+ ****************************************************************************/
+
+static FAR struct pagecache_page_s *
+pagecache_find(FAR struct pagecache_file_s *pf, off_t index)
+{
+  FAR struct pagecache_page_s *page;
+
+  page = g_pagecache_hash[pagecache_hash(pf->owner, pf->ino, index)];
+  for (; page != NULL; page = page->hnext)
+    {
+      if (page->owner == pf->owner && page->ino == pf->ino &&
+          page->index == index && page->version == pf->version)
+        {
+          return page;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: pagecache_drop
+ *
+ * Description:
+ *   Remove a page from its hash bucket and make it the first one to be
+ *   reused.
+ *
+ ****************************************************************************/
+
+static void pagecache_drop(FAR struct pagecache_page_s *page)
+{
+  FAR struct pagecache_page_s **prev;
+
+  if (page->owner == NULL)
+    {
+      return;
+    }
+
+  prev = &g_pagecache_hash[pagecache_hash(page->owner, page->ino,
+                                          page->index)];
+  while (*prev != page)
+    {
+      prev = &(*prev)->hnext;
+    }
+
+  *prev       = page->hnext;
+  page->owner = NULL;
+
+  list_delete(&page->lru);
+  list_add_tail(&g_pagecache_lru, &page->lru);
+}
+
+/****************************************************************************
+ * Name: pagecache_insert
+ *
+ * Description:
+ *   Store one page of data, allocating a new page until the cache is full
+ *   and recycling the least recently used one after that.
+ *
+ ****************************************************************************/
+
+static void pagecache_insert(FAR struct pagecache_file_s *pf, off_t index,
+                             FAR const char *data, size_t valid)
+{
+  FAR struct pagecache_page_s *page;
+  size_t hash;
+
+  page = pagecache_find(pf, index);
+  if (page == NULL)
+    {
+      if (g_pagecache_npages < CONFIG_FS_PAGECACHE_NPAGES)
+        {
+          page = kmm_malloc(sizeof(struct pagecache_page_s));
+          if (page != NULL)
+            {
+              page->owner = NULL;
+              list_add_tail(&g_pagecache_lru, &page->lru);
+              g_pagecache_npages++;
+            }
+        }
+
+      if (page == NULL)
+        {
+          if (list_is_empty(&g_pagecache_lru))
+            {
+              return;
+            }
+
+          page = list_peek_tail_type(&g_pagecache_lru,
+                                     struct pagecache_page_s, lru);
+          pagecache_drop(page);
+        }
+
+      hash          = pagecache_hash(pf->owner, pf->ino, index);
+      page->owner   = pf->owner;
+      page->ino     = pf->ino;
+      page->version = pf->version;
+      page->index   = index;
+      page->hnext   = g_pagecache_hash[hash];
+      g_pagecache_hash[hash] = page;
+    }
+
+  memcpy(page->data, data, valid);
+  page->valid = valid;
+
+  list_delete(&page->lru);
+  list_add_head(&g_pagecache_lru, &page->lru);
+}
+
+/****************************************************************************
+ * Name: pagecache_fill
+ *
+ * Description:
+ *   Read npages pages starting at page index with one fill request (the
+ *   callback may return less, it is called again until the window is full
+ *   or the end of the file is reached), store them in the cache and copy
+ *   the requested part to the caller.  Called without the cache lock held
+ *   so that other files can be served while the backing store is busy.
+ *   The pages are not stored if any file was invalidated since the cache
+ *   generation gen was read.
+ *
+ ****************************************************************************/
+
+static ssize_t pagecache_fill(FAR struct pagecache_file_s *pf, off_t index,
+                              size_t npages, FAR char *buffer,
+                              size_t buflen, off_t offset, uint32_t gen,
+                              pagecache_fill_t fill, FAR void *arg)
+{
+  size_t size = npages * PAGECACHE_PAGESIZE;
+  size_t nfilled = 0;
+  size_t pgoff;
+  FAR char *data;
+  ssize_t ret;
+  size_t i;
+
+  data = kmm_malloc(size);
+  if (data == NULL)
+    {
+      return fill(arg, buffer, offset, buflen);
+    }
+
+  while (nfilled < size)
+    {
+      ret = fill(arg, data + nfilled,
+                 index * PAGECACHE_PAGESIZE + nfilled, size - nfilled);
+      if (ret < 0)
+        {
+          kmm_free(data);
+          return ret;
+        }
+      else if (ret == 0)
+        {
+          break;
+        }
+
+      nfilled += ret;
+    }
+
+  /* A short fill ends with the (possibly empty) page holding the end of
+   * the file, so reads past the end are answered from the cache as well.
+   */
+
+  if (nfilled < size)
+    {
+      npages = nfilled / PAGECACHE_PAGESIZE + 1;
+    }
+
+  nxmutex_lock(&g_pagecache_lock);
+  for (i = 0; i < npages && gen == g_pagecache_generation; i++)
+    {
+      pagecache_insert(pf, index + i, data + i * PAGECACHE_PAGESIZE,
+                       MIN(nfilled - i * PAGECACHE_PAGESIZE,
+                           PAGECACHE_PAGESIZE));
+    }
+
+  nxmutex_unlock(&g_pagecache_lock);
+
+  pgoff = offset - index * PAGECACHE_PAGESIZE;
+  ret   = pgoff < nfilled ? MIN(nfilled - pgoff, buflen) : 0;
+  memcpy(buffer, data + pgoff, ret);
+
+  kmm_free(data);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pagecache_open
+ ****************************************************************************/
+
+void pagecache_open(FAR struct pagecache_file_s *pf, FAR const void *owner,
+                    uint64_t ino, uint64_t version)
+{
+  FAR struct pagecache_page_s *page;
+  FAR struct pagecache_page_s *tmp;
+
+  pf->owner   = owner;
+  pf->ino     = ino;
+  pf->version = version;
+  pf->rapos   = 0;
+
+  if (owner == NULL)
+    {
+      return;
+    }
+
+  nxmutex_lock(&g_pagecache_lock);
+  list_for_every_entry_safe(&g_pagecache_lru, page, tmp,
+                            struct pagecache_page_s, lru)
+    {
+      if (page->owner == owner && page->ino == ino &&
+          page->version != version)
+        {
+          pagecache_drop(page);
+        }
+    }
+
+  nxmutex_unlock(&g_pagecache_lock);
+}
+
+/****************************************************************************
+ * Name: pagecache_read
+ ****************************************************************************/
+
+ssize_t pagecache_read(FAR struct pagecache_file_s *pf, FAR char *buffer,
+                       size_t buflen, off_t offset, pagecache_fill_t fill,
+                       FAR void *arg)
+{
+  FAR struct pagecache_page_s *page;
+  bool sequential = offset == pf->rapos;
+  size_t nread = 0;
+  size_t npages;
+  size_t pgoff;
+  uint32_t gen;
+  size_t i;
+  off_t index;
+  ssize_t ret;
+
+  if (pf->owner == NULL)
+    {
+      return fill(arg, buffer, offset, buflen);
+    }
+
+  nxmutex_lock(&g_pagecache_lock);
+  while (nread < buflen)
+    {
+      index = offset / PAGECACHE_PAGESIZE;
+      pgoff = offset % PAGECACHE_PAGESIZE;
+
+      page = pagecache_find(pf, index);
+      if (page != NULL)
+        {
+          if (pgoff >= page->valid)
+            {
+              break;
+            }
+
+          ret = MIN(page->valid - pgoff, buflen - nread);
+          memcpy(buffer + nread, page->data + pgoff, ret);
+
+          list_delete(&page->lru);
+          list_add_head(&g_pagecache_lru, &page->lru);
+        }
+      else
+        {
+          /* Read the pages the request still needs, or a whole read-ahead
+           * window if the file is read sequentially, up to the next page
+           * which is already cached.
+           */
+
+          npages = (pgoff + buflen - nread + PAGECACHE_PAGESIZE - 1) /
+                   PAGECACHE_PAGESIZE;
+          if (sequential)
+            {
+              npages = MAX(npages, CONFIG_FS_PAGECACHE_READAHEAD);
+            }
+
+          npages = MIN(npages, PAGECACHE_WINDOW);
+          for (i = 1; i < npages; i++)
+            {
+              if (pagecache_find(pf, index + i) != NULL)
+                {
+                  npages = i;
+                  break;
+                }
+            }
+
+          gen = g_pagecache_generation;
+          nxmutex_unlock(&g_pagecache_lock);
+          ret = pagecache_fill(pf, index, npages, buffer + nread,
+                               buflen - nread, offset, gen, fill, arg);
+          nxmutex_lock(&g_pagecache_lock);
+
+          if (ret <= 0)
+            {
+              if (nread == 0)
+                {
+                  nread = ret;
+                }
+
+              break;
+            }
+        }
+
+      nread  += ret;
+      offset += ret;
+    }
+
+  if ((ssize_t)nread > 0)
+    {
+      pf->rapos = offset;
+    }
+
+  nxmutex_unlock(&g_pagecache_lock);
+  return nread;
+}
+
+/****************************************************************************
+ * Name: pagecache_invalidate
+ ****************************************************************************/
+
+void pagecache_invalidate(FAR struct pagecache_file_s *pf)
+{
+  FAR struct pagecache_page_s *page;
+  FAR struct pagecache_page_s *tmp;
+
+  if (pf->owner == NULL)
+    {
+      return;
+    }
+
+  nxmutex_lock(&g_pagecache_lock);
+  g_pagecache_generation++;
+  list_for_every_entry_safe(&g_pagecache_lru, page, tmp,
+                            struct pagecache_page_s, lru)
+    {
+      if (page->owner == pf->owner && page->ino == pf->ino)
+        {
+          pagecache_drop(page);
+        }
+    }
+
+  nxmutex_unlock(&g_pagecache_lock);
+}
+
+/****************************************************************************
+ * Name: pagecache_purge
+ ****************************************************************************/
+
+void pagecache_purge(FAR const void *owner)
+{
+  FAR struct pagecache_page_s *page;
+  FAR struct pagecache_page_s *tmp;
+
+  nxmutex_lock(&g_pagecache_lock);
+  g_pagecache_generation++;
+  list_for_every_entry_safe(&g_pagecache_lru, page, tmp,
+                            struct pagecache_page_s, lru)
+    {
+      if (page->owner == owner)
+        {
+          pagecache_drop(page);
+        }
+    }
+
+  nxmutex_unlock(&g_pagecache_lock);
+}
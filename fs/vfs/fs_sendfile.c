@@ -25,11 +25,13 @@
 #include <nuttx/config.h>
 
 #include <sys/sendfile.h>
+#include <sys/stat.h>
 #include <stdbool.h>
 #include <errno.h>
 #include <debug.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/net/net.h>
 #include "fs_heap.h"
@@ -231,6 +233,133 @@ static ssize_t copyfile(FAR struct file *outfile, FAR struct file *infile,
   return ntransferred;
 }
 
+/****************************************************************************
+ * Name: xipfile
+ *
+ * Description:
+ *   Transfer from a source that is directly addressable in memory: a file
+ *   on a read-only XIP file system such as romfs (FIOC_XIPBASE), or a RAM
+ *   or XIP flash block device (BIOC_XIPBASE).  The data is written to the
+ *   outfile straight from its storage, without the bounce buffer of
+ *   copyfile(), in writes of at most CONFIG_SENDFILE_BUFSIZE bytes like
+ *   copyfile() so that a datagram socket sees the same datagrams.  Returns
+ *   -ENOSYS if the source is not directly addressable.
+ *
+ ****************************************************************************/
+
+static ssize_t xipfile(FAR struct file *outfile, FAR struct file *infile,
+                       FAR off_t *offset, size_t count)
+{
+  FAR struct inode *inode = infile->f_inode;
+  FAR const uint8_t *base = NULL;
+  struct stat buf;
+  size_t ntransferred;
+  ssize_t nbyteswritten;
+  off_t size;
+  off_t pos;
+  size_t nbytes;
+  int ret;
+
+  ret = file_fstat(infile, &buf);
+  if (ret < 0)
+    {
+      return -ENOSYS;
+    }
+
+  if (INODE_IS_MOUNTPT(inode) && S_ISREG(buf.st_mode))
+    {
+      /* The data of a file on a writable file system (tmpfs) can move
+       * while file_write() blocks, only read-only file systems are used
+       * in place.
+       */
+
+      if (inode->u.i_mops->write != NULL ||
+          file_ioctl(infile, FIOC_XIPBASE,
+                     (unsigned long)(uintptr_t)&base) < 0)
+        {
+          return -ENOSYS;
+        }
+    }
+  else if (S_ISBLK(buf.st_mode))
+    {
+      /* A block driver opened through its BCH proxy.  Write any sector
+       * still held in the BCH buffer back before reading the memory
+       * underneath.
+       */
+
+      ret = file_ioctl(infile, BIOC_FLUSH, 0);
+      if ((ret < 0 && ret != -ENOTTY) || buf.st_size == 0 ||
+          file_ioctl(infile, BIOC_XIPBASE,
+                     (unsigned long)(uintptr_t)&base) < 0)
+        {
+          return -ENOSYS;
+        }
+    }
+  else
+    {
+      return -ENOSYS;
+    }
+
+  size = buf.st_size;
+
+  if (base == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  pos = offset != NULL ? *offset : infile->f_pos;
+  if (pos >= size)
+    {
+      return 0;
+    }
+
+  if (count > size - pos)
+    {
+      count = size - pos;
+    }
+
+  for (ntransferred = 0; ntransferred < count; )
+    {
+      nbytes = count - ntransferred;
+      if (nbytes > CONFIG_SENDFILE_BUFSIZE)
+        {
+          nbytes = CONFIG_SENDFILE_BUFSIZE;
+        }
+
+      nbyteswritten = file_write(outfile, base + pos + ntransferred, nbytes);
+      if (nbyteswritten < 0)
+        {
+          /* EINTR only stops the transfer if nothing has been sent */
+
+          if (nbyteswritten != -EINTR || ntransferred == 0)
+            {
+              return nbyteswritten;
+            }
+
+          break;
+        }
+
+      ntransferred += nbyteswritten;
+    }
+
+  /* Update the position in the same way copyfile() does */
+
+  if (offset != NULL)
+    {
+      *offset = pos + ntransferred;
+    }
+  else
+    {
+      pos = file_seek(infile, pos + ntransferred, SEEK_SET);
+      if (pos < 0)
+        {
+          return pos;
+        }
+    }
+
+  return ntransferred;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -247,6 +376,8 @@ static ssize_t copyfile(FAR struct file *outfile, FAR struct file *infile,
 ssize_t file_sendfile(FAR struct file *outfile, FAR struct file *infile,
                       FAR off_t *offset, size_t count)
 {
+  ssize_t ret;
+
   if (count == 0)
     {
       nwarn("WARNING: sendfile count is zero\n");
@@ -265,7 +396,7 @@ ssize_t file_sendfile(FAR struct file *outfile, FAR struct file *infile,
     {
       /* Then let psock_sendfile do the work. */
 
-      int ret = psock_sendfile(psock, infile, offset, count);
+      ret = psock_sendfile(psock, infile, offset, count);
       if (ret >= 0 || ret != -ENOSYS)
         {
           return ret;
@@ -277,6 +408,17 @@ ssize_t file_sendfile(FAR struct file *outfile, FAR struct file *infile,
     }
 #endif
 
+  /* No... then try to write the source straight from memory if it is
+   * directly addressable.  This also covers sockets without a sendfile
+   * implementation of their own, e.g. UDP.
+   */
+
+  ret = xipfile(outfile, infile, offset, count);
+  if (ret != -ENOSYS)
+    {
+      return ret;
+    }
+
   /* No... then this is probably a file-to-file transfer.  The generic
    * copyfile() can handle that case.
    */
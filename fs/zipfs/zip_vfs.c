@@ -37,6 +37,12 @@
 
 #include "fs_heap.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define ZIPFS_INBUFSIZE 512
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -54,11 +60,38 @@ struct zipfs_mountpt_s
   char abspath[1];
 };
 
+#if CONFIG_ZIPFS_CHECKPOINT_INTERVAL > 0
+/* A point in a deflate stream where inflation can be restarted */
+
+struct zipfs_point_s
+{
+  off_t out;                      /* Uncompressed offset */
+  off_t in;                       /* Compressed offset of the next byte */
+  int bits;                       /* Bits of the previous byte still unused */
+  uInt wsize;                     /* Size of the window */
+  FAR unsigned char *window;      /* Last 32 KiB of output before 'out' */
+};
+#endif
+
 struct zipfs_file_s
 {
   unzFile uf;
   mutex_t lock;
   FAR char *seekbuf;
+#if CONFIG_ZIPFS_CHECKPOINT_INTERVAL > 0
+  bool inflating;                 /* Deflated data is inflated here */
+  bool eof;                       /* The end of the stream was reached */
+  struct file zfile;              /* The archive, for the compressed data */
+  z_stream strm;                  /* Raw inflate state */
+  off_t datapos;                  /* Offset of the data in the archive */
+  off_t compsize;                 /* Size of the compressed data */
+  off_t inpos;                    /* Compressed bytes read from zfile */
+  off_t outpos;                   /* Uncompressed bytes produced */
+  off_t span;                     /* Current checkpoint interval */
+  FAR unsigned char *inbuf;       /* Compressed data buffer */
+  FAR struct zipfs_point_s *points;
+  int npoints;
+#endif
   char relpath[1];
 };
 
@@ -239,6 +272,381 @@ static int zipfs_convert_result(int ziperr)
     }
 }
 
+#if CONFIG_ZIPFS_CHECKPOINT_INTERVAL > 0
+/****************************************************************************
+ * Name: zipfs_inflate_open
+ *
+ * Description:
+ *   Set up inflation by zipfs itself if the current file is deflated and
+ *   not encrypted.  On any failure the file is left to minizip.
+ *
+ ****************************************************************************/
+
+static void zipfs_inflate_open(FAR struct zipfs_mountpt_s *fs,
+                               FAR struct zipfs_file_s *fp)
+{
+  unz_file_info64 file_info;
+  int ret;
+
+  fp->inflating = false;
+  fp->points    = NULL;
+  fp->npoints   = 0;
+
+  ret = unzGetCurrentFileInfo64(fp->uf, &file_info,
+                                NULL, 0, NULL, 0, NULL, 0);
+  if (ret != UNZ_OK || file_info.compression_method != Z_DEFLATED ||
+      (file_info.flag & 1) != 0)
+    {
+      return;
+    }
+
+  fp->inbuf = fs_heap_malloc(ZIPFS_INBUFSIZE);
+  if (fp->inbuf == NULL)
+    {
+      return;
+    }
+
+  memset(&fp->strm, 0, sizeof(fp->strm));
+  if (inflateInit2(&fp->strm, -MAX_WBITS) != Z_OK)
+    {
+      goto err_with_inbuf;
+    }
+
+  fp->datapos = unzGetCurrentFileZStreamPos64(fp->uf);
+  ret = file_open(&fp->zfile, fs->abspath, O_RDONLY);
+  if (ret < 0)
+    {
+      goto err_with_strm;
+    }
+
+  if (file_seek(&fp->zfile, fp->datapos, SEEK_SET) < 0)
+    {
+      file_close(&fp->zfile);
+      goto err_with_strm;
+    }
+
+  fp->compsize  = file_info.compressed_size;
+  fp->inpos     = 0;
+  fp->outpos    = 0;
+  fp->span      = (off_t)CONFIG_ZIPFS_CHECKPOINT_INTERVAL * 1024;
+  fp->eof       = false;
+  fp->inflating = true;
+  return;
+
+err_with_strm:
+  inflateEnd(&fp->strm);
+err_with_inbuf:
+  fs_heap_free(fp->inbuf);
+}
+
+/****************************************************************************
+ * Name: zipfs_inflate_close
+ ****************************************************************************/
+
+static void zipfs_inflate_close(FAR struct zipfs_file_s *fp)
+{
+  int i;
+
+  if (!fp->inflating)
+    {
+      return;
+    }
+
+  for (i = 0; i < fp->npoints; i++)
+    {
+      fs_heap_free(fp->points[i].window);
+    }
+
+  fs_heap_free(fp->points);
+  inflateEnd(&fp->strm);
+  file_close(&fp->zfile);
+  fs_heap_free(fp->inbuf);
+}
+
+/****************************************************************************
+ * Name: zipfs_inflate_addpoint
+ *
+ * Description:
+ *   Called at a deflate block boundary.  Record a checkpoint if the output
+ *   moved at least one interval past the last one.  The index is built
+ *   lazily, as the file is read for the first time.
+ *
+ ****************************************************************************/
+
+static void zipfs_inflate_addpoint(FAR struct zipfs_file_s *fp)
+{
+  FAR struct zipfs_point_s *point;
+  off_t last;
+  int i;
+
+  last = fp->npoints > 0 ? fp->points[fp->npoints - 1].out : 0;
+  if (fp->outpos - last < fp->span)
+    {
+      return;
+    }
+
+  if (fp->points == NULL)
+    {
+      fp->points = fs_heap_zalloc(CONFIG_ZIPFS_CHECKPOINT_MAX *
+                                  sizeof(struct zipfs_point_s));
+      if (fp->points == NULL)
+        {
+          return;
+        }
+    }
+
+  if (fp->npoints == CONFIG_ZIPFS_CHECKPOINT_MAX)
+    {
+      /* The index is full, keep every other checkpoint */
+
+      for (i = 0; i < fp->npoints; i++)
+        {
+          if ((i & 1) != 0)
+            {
+              fs_heap_free(fp->points[i].window);
+            }
+          else
+            {
+              fp->points[i / 2] = fp->points[i];
+            }
+        }
+
+      fp->npoints  = (fp->npoints + 1) / 2;
+      fp->span    *= 2;
+
+      last = fp->npoints > 0 ? fp->points[fp->npoints - 1].out : 0;
+      if (fp->outpos - last < fp->span)
+        {
+          return;
+        }
+    }
+
+  point = &fp->points[fp->npoints];
+  if (inflateGetDictionary(&fp->strm, NULL, &point->wsize) != Z_OK)
+    {
+      return;
+    }
+
+  point->window = fs_heap_malloc(point->wsize);
+  if (point->window == NULL)
+    {
+      return;
+    }
+
+  inflateGetDictionary(&fp->strm, point->window, &point->wsize);
+  point->out  = fp->outpos;
+  point->in   = fp->inpos - fp->strm.avail_in;
+  point->bits = fp->strm.data_type & 7;
+  fp->npoints++;
+}
+
+/****************************************************************************
+ * Name: zipfs_inflate_read
+ ****************************************************************************/
+
+static ssize_t zipfs_inflate_read(FAR struct zipfs_file_s *fp,
+                                  FAR char *buffer, size_t buflen)
+{
+  ssize_t ret = 0;
+  uInt avail;
+
+  if (fp->eof)
+    {
+      return 0;
+    }
+
+  fp->strm.next_out  = (FAR Bytef *)buffer;
+  fp->strm.avail_out = buflen;
+
+  while (fp->strm.avail_out > 0)
+    {
+      /* Once all compressed data was read, inflate may still hold the
+       * last bits of input and output that did not fit in an earlier read.
+       */
+
+      if (fp->strm.avail_in == 0 && fp->inpos < fp->compsize)
+        {
+          ret = fp->compsize - fp->inpos;
+          if (ret > ZIPFS_INBUFSIZE)
+            {
+              ret = ZIPFS_INBUFSIZE;
+            }
+
+          ret = file_read(&fp->zfile, fp->inbuf, ret);
+          if (ret <= 0)
+            {
+              ret = ret < 0 ? ret : -EIO;
+              break;
+            }
+
+          fp->inpos         += ret;
+          fp->strm.next_in   = fp->inbuf;
+          fp->strm.avail_in  = ret;
+        }
+
+      /* Stop at every block boundary to find the checkpoints */
+
+      avail = fp->strm.avail_out;
+      ret   = inflate(&fp->strm, Z_BLOCK);
+      fp->outpos += avail - fp->strm.avail_out;
+
+      if (ret == Z_STREAM_END)
+        {
+          fp->eof = true;
+          ret     = 0;
+          break;
+        }
+      else if (ret == Z_BUF_ERROR && fp->strm.avail_in == 0 &&
+               fp->inpos == fp->compsize)
+        {
+          /* No progress is possible, the stream is truncated */
+
+          ret = -EIO;
+          break;
+        }
+      else if (ret != Z_OK)
+        {
+          ret = ret == Z_MEM_ERROR ? -ENOMEM : -EIO;
+          break;
+        }
+
+      if ((fp->strm.data_type & 128) != 0 &&
+          (fp->strm.data_type & 64) == 0)
+        {
+          zipfs_inflate_addpoint(fp);
+        }
+    }
+
+  buflen -= fp->strm.avail_out;
+  return buflen > 0 ? buflen : ret;
+}
+
+/****************************************************************************
+ * Name: zipfs_inflate_restore
+ *
+ * Description:
+ *   Restart inflation at a checkpoint, or at the beginning of the data if
+ *   point is NULL.
+ *
+ ****************************************************************************/
+
+static int zipfs_inflate_restore(FAR struct zipfs_file_s *fp,
+                                 FAR struct zipfs_point_s *point)
+{
+  unsigned char ch;
+  ssize_t ret;
+
+  if (inflateReset(&fp->strm) != Z_OK)
+    {
+      return -EIO;
+    }
+
+  fp->strm.avail_in = 0;
+  fp->eof           = false;
+  fp->inpos         = 0;
+  fp->outpos        = 0;
+
+  if (point != NULL)
+    {
+      fp->inpos  = point->in - (point->bits != 0);
+      fp->outpos = point->out;
+    }
+
+  ret = file_seek(&fp->zfile, fp->datapos + fp->inpos, SEEK_SET);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (point == NULL)
+    {
+      return OK;
+    }
+
+  /* The checkpoint may lie in the middle of a byte */
+
+  if (point->bits != 0)
+    {
+      ret = file_read(&fp->zfile, &ch, 1);
+      if (ret != 1)
+        {
+          return ret < 0 ? ret : -EIO;
+        }
+
+      fp->inpos++;
+      inflatePrime(&fp->strm, point->bits, ch >> (8 - point->bits));
+    }
+
+  if (inflateSetDictionary(&fp->strm, point->window, point->wsize) != Z_OK)
+    {
+      return -EIO;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: zipfs_inflate_seek
+ *
+ * Description:
+ *   Seek by restoring the closest checkpoint before the target, unless the
+ *   current position is closer, and inflating forward to the target.
+ *
+ ****************************************************************************/
+
+static off_t zipfs_inflate_seek(FAR struct zipfs_file_s *fp, off_t offset)
+{
+  FAR struct zipfs_point_s *point = NULL;
+  ssize_t ret;
+  int i;
+
+  for (i = 0; i < fp->npoints && fp->points[i].out <= offset; i++)
+    {
+      point = &fp->points[i];
+    }
+
+  if (offset < fp->outpos || (point != NULL && point->out > fp->outpos))
+    {
+      ret = zipfs_inflate_restore(fp, point);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  if (fp->seekbuf == NULL)
+    {
+      fp->seekbuf = fs_heap_malloc(CONFIG_ZIPFS_SEEK_BUFSIZE);
+      if (fp->seekbuf == NULL)
+        {
+          return -ENOMEM;
+        }
+    }
+
+  while (fp->outpos < offset)
+    {
+      ret = offset - fp->outpos;
+      if (ret > CONFIG_ZIPFS_SEEK_BUFSIZE)
+        {
+          ret = CONFIG_ZIPFS_SEEK_BUFSIZE;
+        }
+
+      ret = zipfs_inflate_read(fp, fp->seekbuf, ret);
+      if (ret <= 0)
+        {
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          break;
+        }
+    }
+
+  return fp->outpos;
+}
+#endif
+
 static int zipfs_open(FAR struct file *filep, FAR const char *relpath,
                       int oflags, mode_t mode)
 {
@@ -282,6 +690,9 @@ static int zipfs_open(FAR struct file *filep, FAR const char *relpath,
   if (ret == OK)
     {
       fp->seekbuf = NULL;
+#if CONFIG_ZIPFS_CHECKPOINT_INTERVAL > 0
+      zipfs_inflate_open(fs, fp);
+#endif
       strcpy(fp->relpath, relpath);
       filep->f_priv = fp;
     }
@@ -303,6 +714,9 @@ static int zipfs_close(FAR struct file *filep)
   FAR struct zipfs_file_s *fp = filep->f_priv;
   int ret;
 
+#if CONFIG_ZIPFS_CHECKPOINT_INTERVAL > 0
+  zipfs_inflate_close(fp);
+#endif
   ret = zipfs_convert_result(unzClose(fp->uf));
   nxmutex_destroy(&fp->lock);
   fs_heap_free(fp->seekbuf);
@@ -317,7 +731,18 @@ static ssize_t zipfs_read(FAR struct file *filep, FAR char *buffer,
   ssize_t ret;
 
   nxmutex_lock(&fp->lock);
-  ret = zipfs_convert_result(unzReadCurrentFile(fp->uf, buffer, buflen));
+#if CONFIG_ZIPFS_CHECKPOINT_INTERVAL > 0
+  if (fp->inflating)
+    {
+      ret = zipfs_inflate_read(fp, buffer, buflen);
+    }
+  else
+#endif
+    {
+      ret = unzReadCurrentFile(fp->uf, buffer, buflen);
+      ret = zipfs_convert_result(ret);
+    }
+
   if (ret > 0)
     {
       filep->f_pos += ret;
@@ -398,7 +823,21 @@ static off_t zipfs_seek(FAR struct file *filep, off_t offset,
     {
       goto err_with_lock;
     }
-  else if (filep->f_pos > offset)
+
+#if CONFIG_ZIPFS_CHECKPOINT_INTERVAL > 0
+  if (fp->inflating)
+    {
+      ret = zipfs_inflate_seek(fp, offset);
+      if (ret >= 0)
+        {
+          filep->f_pos = ret;
+        }
+
+      goto err_with_lock;
+    }
+#endif
+
+  if (filep->f_pos > offset)
     {
       ret = zipfs_convert_result(unzClose(fp->uf));
       if (ret < 0)
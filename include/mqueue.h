@@ -36,6 +36,12 @@
 
 #define MQ_NONBLOCK O_NONBLOCK
 
+/* Non-standard mq_attr.mq_flags value used at creation time to request a
+ * lock-free ring of fixed-size, single priority messages (CONFIG_MQ_RING).
+ */
+
+#define MQ_RING     (1 << 24)
+
 /****************************************************************************
  * Public Type Declarations
  ****************************************************************************/
@@ -87,6 +93,13 @@ int     mq_setattr(mqd_t mqdes, FAR const struct mq_attr *mq_stat,
                    FAR struct mq_attr *oldstat);
 int     mq_getattr(mqd_t mqdes, FAR struct mq_attr *mq_stat);
 
+/* Non-standard batched interfaces */
+
+ssize_t mq_send_batch(mqd_t mqdes, FAR const char *msgs, size_t msglen,
+                      size_t nmsgs);
+ssize_t mq_receive_batch(mqd_t mqdes, FAR char *msgs, size_t msglen,
+                         size_t nmsgs);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
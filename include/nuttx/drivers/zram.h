@@ -0,0 +1,96 @@
+/****************************************************************************
+ * include/nuttx/drivers/zram.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_DRIVERS_ZRAM_H
+#define __INCLUDE_NUTTX_DRIVERS_ZRAM_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef CONFIG_DRVR_ZRAM
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Returned by the BIOC_ZRAMSTATS ioctl command */
+
+struct zram_stats_s
+{
+  uint32_t nsectors;          /* Number of sectors on device */
+  uint16_t sectsize;          /* The size of one sector */
+  uint32_t ncompressed;       /* Sectors stored compressed */
+  uint32_t nhuge;             /* Sectors stored uncompressed */
+  uint32_t nsame;             /* Same-filled sectors, stored in the table */
+  size_t   compsize;          /* Bytes of data in the store */
+  size_t   memused;           /* Bytes of memory held by the store */
+  uint32_t nreads;            /* Sectors read */
+  uint32_t nwrites;           /* Sectors written */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: zram_register
+ *
+ * Description:
+ *   Register a compressed RAM disk as /dev/zramN.  Each sector is stored
+ *   LZF compressed in a memory pool, so the memory used grows with the
+ *   data written and shrinks with how well it compresses.  Sectors filled
+ *   with a repeated word take no memory beyond the sector table.  Sectors
+ *   never written read as zeroes.
+ *
+ * Input Parameters:
+ *   minor:         Selects suffix of device named /dev/zramN, N={1,2,3...}
+ *   nsectors:      Number of sectors on device
+ *   sectsize:      The size of one sector
+ *
+ * Returned Value:
+ *   Zero on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int zram_register(int minor, uint32_t nsectors, uint16_t sectsize);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_DRVR_ZRAM */
+#endif /* __INCLUDE_NUTTX_DRIVERS_ZRAM_H */
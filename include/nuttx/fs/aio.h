@@ -0,0 +1,248 @@
+/****************************************************************************
+ * include/nuttx/fs/aio.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_FS_AIO_H
+#define __INCLUDE_NUTTX_FS_AIO_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/poll.h>
+#include <stdint.h>
+
+#include <nuttx/fs/ioctl.h>
+#include <nuttx/wqueue.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Request operations */
+
+#define AIO_OP_NOP          0  /* Complete immediately with result 0 */
+#define AIO_OP_READ         1  /* pread(), read() on non-seekable files */
+#define AIO_OP_WRITE        2  /* pwrite(), write() if O_APPEND is set */
+#define AIO_OP_FSYNC        3  /* fsync() */
+
+/* Submission ring entry flags */
+
+#define AIO_SQE_LINK        (1 << 0) /* Start the next entry only after
+                                      * this one completed successfully,
+                                      * cancel it (-ECANCELED) otherwise */
+
+/* Ring device ioctl commands, see Documentation/components/filesystem/
+ * aio.rst for the usage of the rings.
+ */
+
+#define AIOC_SETUP          _AIOIOC(0x0001) /* IN:  FAR struct aio_params_s *
+                                             * OUT: Rings allocated, map
+                                             *      them with mmap() */
+#define AIOC_ENTER          _AIOIOC(0x0002) /* IN:  FAR struct aio_enter_s *
+                                             * OUT: Number of entries
+                                             *      submitted */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Submission queue entry */
+
+struct aio_sqe_s
+{
+  uint8_t   opcode;         /* AIO_OP_* */
+  uint8_t   flags;          /* AIO_SQE_* */
+  uint16_t  reserved;
+  int32_t   fd;             /* File descriptor of the submitting task */
+  off_t     offset;         /* File offset */
+  FAR void *buf;            /* Data buffer */
+  uint32_t  len;            /* Data length */
+  uint64_t  user_data;      /* Copied to the completion entry */
+};
+
+/* Completion queue entry */
+
+struct aio_cqe_s
+{
+  uint64_t  user_data;      /* From the submission entry */
+  int32_t   res;            /* Bytes transferred or a negated errno */
+  uint32_t  flags;
+};
+
+/* The rings are shared with the application, which maps them with mmap().
+ * The application produces submission entries at sq_tail and consumes
+ * completion entries at cq_head, the kernel does the opposite.  All
+ * indexes run freely and are masked with the ring size minus one.
+ *
+ *   struct aio_rings_s | struct aio_sqe_s[sq_entries] |
+ *   struct aio_cqe_s[cq_entries]
+ */
+
+struct aio_rings_s
+{
+  volatile uint32_t sq_head;     /* Written by the kernel */
+  volatile uint32_t sq_tail;     /* Written by the application */
+  uint32_t          sq_entries;  /* Power of two */
+  uint32_t          sq_off;      /* Offset of the submission entries */
+  volatile uint32_t cq_head;     /* Written by the application */
+  volatile uint32_t cq_tail;     /* Written by the kernel */
+  uint32_t          cq_entries;  /* Power of two, twice sq_entries */
+  uint32_t          cq_off;      /* Offset of the completion entries */
+  volatile uint32_t cq_overflow; /* Completions lost on a full ring */
+};
+
+/* AIOC_SETUP argument */
+
+struct aio_params_s
+{
+  uint32_t sq_entries;      /* IN: Rounded up to a power of two */
+  uint32_t cq_entries;      /* OUT */
+  size_t   size;            /* OUT: Size of the mapping */
+};
+
+/* AIOC_ENTER argument */
+
+struct aio_enter_s
+{
+  uint32_t to_submit;       /* Entries to take from the submission ring */
+  uint32_t min_complete;    /* Wait until this many completions are
+                             * available in the completion ring */
+};
+
+/* A request of the asynchronous I/O engine.  POSIX aio and the ring device
+ * submit them with aio_submit().
+ *
+ * Drivers that can perform I/O without blocking a thread implement the
+ * aio method of struct file_operations: they return OK after taking the
+ * request, and call aio_done() when it completes, possibly from interrupt
+ * context or before the method returns.  Any other return value lets the
+ * engine fall back to readiness notification (for pollable files) or to
+ * the low priority work queue.
+ */
+
+struct file;
+struct aio_request_s;
+typedef CODE void (*aio_complete_t)(FAR struct aio_request_s *req,
+                                    ssize_t result);
+
+struct aio_request_s
+{
+  /* Set by the submitter */
+
+  uint8_t          opcode;    /* AIO_OP_* */
+  uint8_t          prio;      /* Priority to run the request at */
+  FAR struct file *filep;     /* The file to operate on */
+  FAR void        *buf;       /* Data buffer */
+  size_t           nbytes;    /* Data length */
+  off_t            offset;    /* File offset */
+  aio_complete_t   complete;  /* Completion callback, thread context */
+
+  /* Private to the engine */
+
+  uint8_t          state;
+  ssize_t          result;
+  struct work_s    work;
+  struct pollfd    fds;
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+#ifdef CONFIG_FS_AIO
+
+/****************************************************************************
+ * Name: aio_submit
+ *
+ * Description:
+ *   Start an asynchronous request.  The request is handed to the aio
+ *   method of the driver, or waits for the file to become ready if it can be
+ *   polled, or runs on the low priority work queue.  req->complete is
+ *   called exactly once, always from thread context (it may be called
+ *   before aio_submit() returns).
+ *
+ * Returned Value:
+ *   Zero (OK) if the request was started; a negated errno value otherwise,
+ *   the completion callback is not called in that case.
+ *
+ ****************************************************************************/
+
+int aio_submit(FAR struct aio_request_s *req);
+
+/****************************************************************************
+ * Name: aio_done
+ *
+ * Description:
+ *   Called by a driver which accepted a request through its aio method when
+ *   the request completes.  May be called from interrupt context.
+ *
+ ****************************************************************************/
+
+void aio_done(FAR struct aio_request_s *req, ssize_t result);
+
+/****************************************************************************
+ * Name: aio_abort
+ *
+ * Description:
+ *   Try to cancel a request which has not been started yet.
+ *
+ * Returned Value:
+ *   Zero (OK) if the request was canceled, its completion callback will not
+ *   be called; -EBUSY if the request is already in progress.
+ *
+ ****************************************************************************/
+
+int aio_abort(FAR struct aio_request_s *req);
+
+#ifdef CONFIG_FS_AIO_RING
+
+/****************************************************************************
+ * Name: aio_ring_register
+ *
+ * Description:
+ *   Register the asynchronous I/O ring device, /dev/aio.  Each open of the
+ *   device creates an independent pair of rings.
+ *
+ ****************************************************************************/
+
+int aio_ring_register(void);
+#endif
+
+#endif /* CONFIG_FS_AIO */
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_FS_AIO_H */
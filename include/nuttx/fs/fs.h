@@ -178,6 +178,7 @@
 
 struct file;
 struct inode;
+struct aio_request_s;
 struct stat;
 struct statfs;
 struct pollfd;
@@ -239,6 +240,15 @@ struct file_operations
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   CODE int     (*unlink)(FAR struct inode *inode);
 #endif
+
+  /* Start an asynchronous transfer, see include/nuttx/fs/aio.h.  Only the
+   * kernel can reach this, through aio_submit().
+   */
+
+#ifdef CONFIG_FS_AIO
+  CODE int     (*aio)(FAR struct file *filep,
+                      FAR struct aio_request_s *req);
+#endif
 };
 
 /* This structure provides information about the state of a block driver */
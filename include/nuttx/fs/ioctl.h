@@ -107,6 +107,7 @@
 #define _PINCTRLBASE    (0x4000) /* Pinctrl driver ioctl commands */
 #define _PCIBASE        (0x4100) /* Pci ioctl commands */
 #define _I3CBASE        (0x4200) /* I3C driver ioctl commands */
+#define _AIOBASE        (0x4300) /* Asynchronous I/O ring ioctl commands */
 #define _WLIOCBASE      (0x8b00) /* Wireless modules ioctl network commands */
 
 /* boardctl() commands share the same number space */
@@ -232,6 +233,10 @@
 #define FIOC_XIPBASE        _FIOC(0x0015) /* IN:  uinptr_t *
                                            * OUT: Current file xip base address
                                            */
+#define FIOC_CACHESTAT      _FIOC(0x0016) /* IN:  FAR struct fs_cachestat_s *
+                                           * OUT: Statistics of the block
+                                           *      cache of the file system
+                                           */
 
 /* NuttX file system ioctl definitions **************************************/
 
@@ -346,6 +351,11 @@
                                            *      to return sector numbers.
                                            * OUT: Data return in user-provided
                                            *      buffer. */
+#define BIOC_ZRAMSTATS  _BIOC(0x0011)     /* Get compressed RAM disk statistics.
+                                           * IN:  Pointer to writable instance
+                                           *      of struct zram_stats_s.
+                                           * OUT: Data return in user-provided
+                                           *      buffer. */
 
 /* NuttX MTD driver ioctl definitions ***************************************/
 
@@ -754,6 +764,13 @@
 #define _PINCTRLIOCVALID(c) (_IOC_TYPE(c)==_PINCTRLBASE)
 #define _PINCTRLIOC(nr)     _IOC(_PINCTRLBASE,nr)
 
+/* Asynchronous I/O ring command definitions ********************************/
+
+/* see nuttx/include/fs/aio.h */
+
+#define _AIOIOCVALID(c)   (_IOC_TYPE(c)==_AIOBASE)
+#define _AIOIOC(nr)       _IOC(_AIOBASE,nr)
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -765,6 +782,16 @@ struct pipe_peek_s
   size_t size;
 };
 
+/* Returned by FIOC_CACHESTAT */
+
+struct fs_cachestat_s
+{
+  uint32_t nlines;   /* Number of cache lines */
+  uint32_t linesize; /* Size of one cache line */
+  uint32_t hits;     /* Reads served from the cache */
+  uint32_t misses;   /* Reads that went to the device */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
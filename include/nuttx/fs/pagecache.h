@@ -0,0 +1,161 @@
+/****************************************************************************
+ * include/nuttx/fs/pagecache.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_FS_PAGECACHE_H
+#define __INCLUDE_NUTTX_FS_PAGECACHE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef CONFIG_FS_PAGECACHE
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Read size bytes at a file offset from the backing store.  Returns the
+ * number of bytes read, zero at the end of the file or a negated errno.
+ */
+
+typedef CODE ssize_t (*pagecache_fill_t)(FAR void *arg, FAR char *buffer,
+                                         off_t offset, size_t size);
+
+/* The cache state of one open file.  The file system embeds it in its
+ * private open file structure.  Pages are shared between all opens of
+ * the same (owner, ino) pair as long as they see the same version.
+ */
+
+struct pagecache_file_s
+{
+  FAR const void *owner;    /* Mountpoint private data, NULL: uncached */
+  uint64_t        ino;      /* File identity within the mountpoint */
+  uint64_t        version;  /* File version seen when it was opened */
+  off_t           rapos;    /* End of the last read, for read-ahead */
+};
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pagecache_version
+ *
+ * Description:
+ *   Derive a file version from its modification time and size.
+ *
+ ****************************************************************************/
+
+static inline uint64_t pagecache_version(FAR const struct timespec *mtime,
+                                         uint64_t size)
+{
+  return ((uint64_t)mtime->tv_sec * 1000000000 + mtime->tv_nsec) ^
+         (size << 32 | size >> 32);
+}
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: pagecache_open
+ *
+ * Description:
+ *   Attach an open file to the page cache.  Cached pages of an older
+ *   version of the file are dropped, so a file changed by the host or by
+ *   the server is read again after it is reopened (close-to-open
+ *   consistency).
+ *
+ * Input Parameters:
+ *   pf      - The cache state to initialize
+ *   owner   - The mountpoint private data, NULL leaves the file uncached
+ *   ino     - A number identifying the file within the mountpoint
+ *   version - The current version of the file, see pagecache_version()
+ *
+ ****************************************************************************/
+
+void pagecache_open(FAR struct pagecache_file_s *pf, FAR const void *owner,
+                    uint64_t ino, uint64_t version);
+
+/****************************************************************************
+ * Name: pagecache_read
+ *
+ * Description:
+ *   Read from the file at the given offset, through the page cache.
+ *   Missing pages are read with the fill callback; sequential reads fetch
+ *   CONFIG_FS_PAGECACHE_READAHEAD pages with one fill request.
+ *
+ * Returned Value:
+ *   The number of bytes read, zero at the end of the file or a negated
+ *   errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t pagecache_read(FAR struct pagecache_file_s *pf, FAR char *buffer,
+                       size_t buflen, off_t offset, pagecache_fill_t fill,
+                       FAR void *arg);
+
+/****************************************************************************
+ * Name: pagecache_invalidate
+ *
+ * Description:
+ *   Drop all cached pages of a file.  Must be called whenever the file is
+ *   written or truncated through this mountpoint, after the change unless
+ *   the file system serializes reads with it: a read that fetched the old
+ *   data concurrently then does not store it.  Every open of the file,
+ *   readable or not, must pass its identity to pagecache_open() for this.
+ *
+ ****************************************************************************/
+
+void pagecache_invalidate(FAR struct pagecache_file_s *pf);
+
+/****************************************************************************
+ * Name: pagecache_purge
+ *
+ * Description:
+ *   Drop all cached pages of a mountpoint.  Called when it is unmounted.
+ *
+ ****************************************************************************/
+
+void pagecache_purge(FAR const void *owner);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_FS_PAGECACHE */
+#endif /* __INCLUDE_NUTTX_FS_PAGECACHE_H */
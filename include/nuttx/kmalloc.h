@@ -75,12 +75,26 @@ extern "C"
 #define kumm_initialize(h,s)     umm_initialize(h,s)
 #define kumm_addregion(h,s)      umm_addregion(h,s)
 
-#define kumm_calloc(n,s)         calloc(n,s)
-#define kumm_malloc(s)           malloc(s)
+#if defined(CONFIG_MM_UMM_ARENA) && defined(CONFIG_BUILD_FLAT)
+/* Memory that the kernel allocates for an application thread, such as the
+ * stacks of the threads it starts, would pin the heap arena of that thread
+ * after it exits.  Allocate it from the user heap itself.
+ */
+
+#  define kumm_calloc(n,s)       mm_calloc(USR_HEAP,n,s)
+#  define kumm_malloc(s)         mm_malloc(USR_HEAP,s)
+#  define kumm_zalloc(s)         mm_zalloc(USR_HEAP,s)
+#  define kumm_realloc(p,s)      mm_realloc(USR_HEAP,p,s)
+#  define kumm_memalign(a,s)     mm_memalign(USR_HEAP,a,s)
+#else
+#  define kumm_calloc(n,s)       calloc(n,s)
+#  define kumm_malloc(s)         malloc(s)
+#  define kumm_zalloc(s)         zalloc(s)
+#  define kumm_realloc(p,s)      realloc(p,s)
+#  define kumm_memalign(a,s)     memalign(a,s)
+#endif
+
 #define kumm_malloc_size(p)      malloc_size(p)
-#define kumm_zalloc(s)           zalloc(s)
-#define kumm_realloc(p,s)        realloc(p,s)
-#define kumm_memalign(a,s)       memalign(a,s)
 #define kumm_free(p)             free(p)
 #define kumm_mallinfo()          mallinfo()
 
@@ -95,12 +109,12 @@ extern "C"
 #  define kmm_initialize(h,s)    /* Initialization done by kumm_initialize */
 #  define kmm_addregion(h,s)     umm_addregion(h,s)
 
-#  define kmm_calloc(n,s)        calloc(n,s)
-#  define kmm_malloc(s)          malloc(s)
+#  define kmm_calloc(n,s)        kumm_calloc(n,s)
+#  define kmm_malloc(s)          kumm_malloc(s)
 #  define kmm_malloc_size(p)     malloc_size(p)
-#  define kmm_zalloc(s)          zalloc(s)
-#  define kmm_realloc(p,s)       realloc(p,s)
-#  define kmm_memalign(a,s)      memalign(a,s)
+#  define kmm_zalloc(s)          kumm_zalloc(s)
+#  define kmm_realloc(p,s)       kumm_realloc(p,s)
+#  define kmm_memalign(a,s)      kumm_memalign(a,s)
 #  define kmm_free(p)            free(p)
 #  define kmm_mallinfo()         mallinfo()
 #  define kmm_heapmember(p)      umm_heapmember(p)
@@ -147,6 +147,7 @@ typedef CODE int (*mod_initializer_t)(FAR struct mod_info_s *modinfo);
  */
 
 struct module_s;
+struct modlib_symhash_s;
 typedef CODE int (*mod_callback_t)(FAR struct module_s *modp, FAR void *arg);
 
 /* This describes the file to be loaded. */
@@ -187,6 +188,9 @@ struct module_s
   uint16_t  ninit;                       /* Number of entries in .init_array */
   uintptr_t finiarr;                     /* .fini_array */
   uint16_t  nfini;                       /* Number of entries in .fini_array */
+#ifdef CONFIG_MODLIB_SYMHASH
+  FAR struct modlib_symhash_s *symhash;  /* Hash index of the exports */
+#endif
 };
 
 /* This struct provides a description of the currently loaded instantiation
@@ -221,6 +225,9 @@ struct mod_loadinfo_s
   FAR Elf_Shdr *shdr;        /* Buffered module section headers */
   FAR void     *exported;    /* Module exports */
   FAR uint8_t  *iobuffer;    /* File I/O buffer */
+#ifdef CONFIG_MODLIB_XIPIMAGE
+  FAR const uint8_t *image;  /* Whole file if directly addressable */
+#endif
   uintptr_t     datasec;     /* ET_DYN - data area start from Phdr */
   uintptr_t     segpad;      /* Padding between text and data */
   uintptr_t     initarr;     /* .init_array */
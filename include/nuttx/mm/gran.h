@@ -200,6 +200,27 @@ FAR void *gran_reserve(GRAN_HANDLE handle, uintptr_t start, size_t size);
 
 FAR void *gran_alloc(GRAN_HANDLE handle, size_t size);
 
+/****************************************************************************
+ * Name: gran_alloc_align
+ *
+ * Description:
+ *   Allocate memory from the granule heap at an address aligned to align.
+ *   The granules before and after the aligned region are returned to the
+ *   heap, so the memory is freed with gran_free() like any other.
+ *
+ * Input Parameters:
+ *   handle - The handle previously returned by gran_initialize
+ *   size   - The size of the memory region to allocate.
+ *   align  - The alignment, a power of two.
+ *
+ * Returned Value:
+ *   On success, a non-NULL pointer to the allocated memory is returned;
+ *   NULL is returned on failure.
+ *
+ ****************************************************************************/
+
+FAR void *gran_alloc_align(GRAN_HANDLE handle, size_t size, size_t align);
+
 /****************************************************************************
  * Name: gran_free
  *
@@ -28,10 +28,11 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
-#include <nuttx/queue.h>
 #include <nuttx/mutex.h>
 #include <nuttx/mm/gran.h>
 
+#include <sys/tree.h>
+
 /****************************************************************************
  * Forward declarations
  ****************************************************************************/
@@ -42,11 +43,12 @@ struct task_group_s;
  * Public Types
  ****************************************************************************/
 
-/* A memory mapping list item */
+/* A memory mapping tree item */
 
 struct mm_map_entry_s
 {
-  FAR struct mm_map_entry_s *flink;  /* this is used as sq_entry_t */
+  RB_ENTRY(mm_map_entry_s) node;     /* Node in the tree sorted by vaddr */
+  uintptr_t maxend;                  /* Highest end address in the subtree */
   FAR void *vaddr;
   size_t length;
   off_t offset;
@@ -76,10 +78,12 @@ struct mm_map_entry_s
 
 /* memory mapping structure for the task group */
 
+RB_HEAD(mm_map_tree_s, mm_map_entry_s);
+
 struct mm_map_s
 {
-  sq_queue_t mm_map_sq;         /* mappings list */
-  size_t map_count;             /* mappings list length */
+  struct mm_map_tree_s mm_map_tree; /* mappings interval tree */
+  size_t map_count;             /* number of mappings */
 
 #ifdef CONFIG_ARCH_VMA_MAPPING
   GRAN_HANDLE mm_map_vpages;    /* SHM virtual zone allocator */
@@ -244,7 +248,7 @@ int vm_unmap_region(FAR void *vaddr, size_t size);
  * Name: mm_map_add
  *
  * Description:
- *   Adds a virtual memory area into the list of mappings
+ *   Adds a virtual memory area into the tree of mappings
  *
  * Input Parameters:
  *   mm    - A pointer to mm_map_s, which describes the virtual memory area
@@ -264,9 +268,9 @@ int mm_map_add(FAR struct mm_map_s *mm, FAR struct mm_map_entry_s *entry);
  * Name: mm_map_next
  *
  * Description:
- *   Returns the next mapping in the list, following the argument.
- *   Can be used to iterate through all the mappings. Returns the first
- *   mapping when the argument "entry" is NULL.
+ *   Returns the mapping following the argument in the order of virtual
+ *   addresses.  Can be used to iterate through all the mappings. Returns
+ *   the first mapping when the argument "entry" is NULL.
  *
  * Input Parameters:
  *   mm    - A pointer to mm_map_s, which describes the virtual memory area
@@ -285,7 +289,8 @@ FAR struct mm_map_entry_s *mm_map_next(FAR struct mm_map_s *mm,
  * Name: mm_map_find
  *
  * Description:
- *   Find the first mapping matching address and length
+ *   Find the mapping with the lowest address that contains the whole
+ *   range given by address and length
  *
  * Input Parameters:
  *   mm     - A pointer to mm_map_s, which describes the virtual memory area
@@ -305,11 +310,11 @@ FAR struct mm_map_entry_s *mm_map_find(FAR struct mm_map_s *mm,
  * Name: mm_map_remove
  *
  * Description:
- *   Removes a virtual memory area from the list of mappings
+ *   Removes a virtual memory area from the tree of mappings
  *   Sets the given pointer argument to NULL after successful removal
  *
  * Input Parameters:
- *   mm      - Pointer to the list of entries, from which the entry is
+ *   mm      - Pointer to the tree of entries, from which the entry is
  *             removed. If passed mm is NULL, the function doesn't do
  *             anything, but just returns OK.
  *
@@ -36,6 +36,7 @@
 #include <nuttx/fs/procfs.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -77,6 +78,8 @@ typedef CODE size_t (*mempool_multiple_alloc_size_t)(FAR void *arg,
 typedef CODE void (mempool_multiple_foreach_t)(FAR struct mempool_s *pool,
                                                FAR void *arg);
 
+typedef CODE void (*mempool_ctor_t)(FAR void *obj, FAR void *arg);
+
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL)
 struct mempool_procfs_entry_s
 {
@@ -121,6 +124,37 @@ struct mempool_s
 #endif
 };
 
+#ifdef CONFIG_MM_MEMPOOL_CACHE
+/* This structure describes the objects a CPU keeps in front of the pool */
+
+struct mempool_magazine_s
+{
+  spinlock_t lock;  /* Only contended by mempool_cache_reclaim() */
+  size_t     count; /* The number of objects in objs[] */
+  FAR void  *objs[CONFIG_MM_MEMPOOL_CACHE_MAGAZINE];
+};
+
+/* This structure describes an object cache.  The pool gets its memory
+ * from the kernel heap unless the user sets pool.alloc and pool.free
+ * before mempool_cache_init().
+ */
+
+struct mempool_cache_s
+{
+  struct mempool_s pool;  /* The pool the objects come from */
+  mempool_ctor_t   ctor;  /* Run on objects taken from the pool, or NULL */
+  FAR void        *arg;   /* The argument of ctor */
+
+  /* Private data for object cache */
+
+  struct mempool_magazine_s mag[CONFIG_SMP_NCPUS];
+#if defined(CONFIG_MM_MEMPOOL_CACHE_RECLAIM_DELAY) && \
+    CONFIG_MM_MEMPOOL_CACHE_RECLAIM_DELAY > 0
+  struct work_s    work;  /* Deferred reclaim of idle expansions */
+#endif
+};
+#endif
+
 #if CONFIG_MM_BACKTRACE >= 0
 struct mempool_backtrace_s
 {
@@ -259,6 +293,23 @@ void mempool_memdump(FAR struct mempool_s *pool,
 
 int mempool_deinit(FAR struct mempool_s *pool);
 
+/****************************************************************************
+ * Name: mempool_reclaim
+ *
+ * Description:
+ *   Return the expansion chunks of the pool whose blocks are all free to
+ *   the allocator.  The cost grows with the number of chunks times the
+ *   number of free blocks, so call it lazily, not on every release.
+ *
+ * Input Parameters:
+ *   pool    - Address of the memory pool to be used.
+ *
+ * Returned Value:
+ *   The number of bytes released.
+ ****************************************************************************/
+
+size_t mempool_reclaim(FAR struct mempool_s *pool);
+
 /****************************************************************************
  * Name: mempool_info_task
  *
@@ -277,6 +328,98 @@ struct mallinfo_task
 mempool_info_task(FAR struct mempool_s *pool,
                   FAR const struct malltask *task);
 
+/****************************************************************************
+ * Name: mempool_cache_init
+ *
+ * Description:
+ *   Initialize an object cache.  Every CPU keeps up to
+ *   CONFIG_MM_MEMPOOL_CACHE_MAGAZINE freed objects in a magazine and
+ *   allocates from it first, so that the pool lock is only taken when the
+ *   magazine is empty or full.
+ *
+ * Input Parameters:
+ *   cache   - Address of the object cache to be used.
+ *   name    - The name of the object cache.
+ *   size    - The size of an object.
+ *   nexpand - The number of objects the pool is expanded by at a time.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_MEMPOOL_CACHE
+int mempool_cache_init(FAR struct mempool_cache_s *cache,
+                       FAR const char *name, size_t size, size_t nexpand);
+
+/****************************************************************************
+ * Name: mempool_cache_alloc
+ *
+ * Description:
+ *   Allocate an object from the cache.  The constructor only runs on
+ *   objects taken from the pool, so objects must be freed in a state the
+ *   constructor would produce.
+ *
+ * Input Parameters:
+ *   cache - Address of the object cache to be used.
+ *
+ * Returned Value:
+ *   The pointer to the allocated object on success; NULL on any failure.
+ *
+ ****************************************************************************/
+
+FAR void *mempool_cache_alloc(FAR struct mempool_cache_s *cache);
+
+/****************************************************************************
+ * Name: mempool_cache_free
+ *
+ * Description:
+ *   Free an object to the cache.
+ *
+ * Input Parameters:
+ *   cache - Address of the object cache to be used.
+ *   obj   - The pointer of the object.
+ *
+ ****************************************************************************/
+
+void mempool_cache_free(FAR struct mempool_cache_s *cache, FAR void *obj);
+
+/****************************************************************************
+ * Name: mempool_cache_reclaim
+ *
+ * Description:
+ *   Return the objects of all magazines to the pool, then the expansion
+ *   chunks of the pool that hold no object in use to the allocator.  With
+ *   CONFIG_MM_MEMPOOL_CACHE_RECLAIM_DELAY, the cache also reclaims idle
+ *   chunks by itself some time after objects were returned to the pool.
+ *
+ * Input Parameters:
+ *   cache - Address of the object cache to be used.
+ *
+ * Returned Value:
+ *   The number of bytes released.
+ *
+ ****************************************************************************/
+
+size_t mempool_cache_reclaim(FAR struct mempool_cache_s *cache);
+
+/****************************************************************************
+ * Name: mempool_cache_deinit
+ *
+ * Description:
+ *   Deallocate an object cache.
+ *
+ * Input Parameters:
+ *   cache - Address of the object cache to be used.
+ *
+ * Returned Value:
+ *   Zero on success; -EBUSY if objects are still in use.
+ *
+ ****************************************************************************/
+
+int mempool_cache_deinit(FAR struct mempool_cache_s *cache);
+#endif
+
 /****************************************************************************
  * Name: mempool_procfs_register
  *
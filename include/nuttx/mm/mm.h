@@ -160,6 +160,12 @@
 #define MM_ALLOC_MAGIC   0xaa
 #define MM_FREE_MAGIC    0x55
 
+/* The size classes of the fragmentation report: class n holds the blocks
+ * of 2^n up to 2^(n+1) - 1 bytes, the last class all larger blocks.
+ */
+
+#define MM_FRAG_NCLASSES 32
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -176,6 +182,38 @@ struct mempool_init_s
   size_t            dict_expendsize;
 };
 
+#if CONFIG_MM_BACKTRACE > 0
+/* The allocated blocks of one allocation site, that is the first caller
+ * recorded in the backtrace of the blocks.
+ */
+
+struct mm_fragsite_s
+{
+  FAR void     *site;     /* The allocation site, NULL if not recorded */
+  size_t        nblocks;  /* Number of allocated blocks */
+  size_t        size;     /* Total size of the blocks */
+  size_t        npinning; /* Blocks next to a free block */
+  unsigned long seqmin;   /* Sequence number of the oldest block */
+};
+#endif
+
+/* The fragmentation report of a heap, see mm_fraginfo() */
+
+struct mm_fraginfo_s
+{
+  size_t nfree[MM_FRAG_NCLASSES];   /* Free blocks of each size class */
+  size_t free[MM_FRAG_NCLASSES];    /* Free bytes of each size class */
+  size_t nused[MM_FRAG_NCLASSES];   /* Allocated blocks of each size class */
+  size_t used[MM_FRAG_NCLASSES];    /* Allocated bytes of each size class */
+  size_t mxfree[CONFIG_MM_REGIONS]; /* Largest free block of each region */
+  int    nregions;                  /* Number of regions */
+#if CONFIG_MM_BACKTRACE > 0
+  FAR struct mm_fragsite_s *sites;  /* Table of sites, provided by caller */
+  size_t nsites;                    /* Number of entries in sites */
+  size_t nlost;                     /* Blocks not counted, sites is full */
+#endif
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -390,6 +428,17 @@ void mm_extend(FAR struct mm_heap_s *heap, FAR void *mem, size_t size,
 
 void umm_extend(FAR void *mem, size_t size, int region);
 
+/* Functions contained in umm_arena.c ***************************************/
+
+/* The user heap, and so its arenas, only exist on the user side */
+
+#if defined(CONFIG_MM_UMM_ARENA) && \
+    (defined(CONFIG_BUILD_FLAT) || !defined(__KERNEL__))
+void umm_arena_release(void);
+#else
+#  define umm_arena_release()
+#endif
+
 /* Functions contained in kmm_extend.c **************************************/
 
 #ifdef CONFIG_MM_KERNEL_HEAP
@@ -405,6 +454,11 @@ struct mallinfo_task mm_mallinfo_task(FAR struct mm_heap_s *heap,
 size_t mm_heapfree(FAR struct mm_heap_s *heap);
 size_t mm_heapfree_largest(FAR struct mm_heap_s *heap);
 
+/* Functions contained in mm_fraginfo.c *************************************/
+
+void mm_fraginfo(FAR struct mm_heap_s *heap,
+                 FAR struct mm_fraginfo_s *info);
+
 /* Functions contained in kmm_mallinfo.c ************************************/
 
 #ifdef CONFIG_MM_KERNEL_HEAP
@@ -32,6 +32,9 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/signal.h>
 #include <nuttx/list.h>
+#ifdef CONFIG_MQ_RING
+#  include <nuttx/atomic.h>
+#endif
 
 #include <sys/types.h>
 #include <stdint.h>
@@ -108,6 +111,30 @@ struct mqueue_cmn_s
   int16_t nwaitnotempty;      /* Number tasks waiting for not empty */
 };
 
+/* This structure describes the lock-free ring of a MQ_RING message queue.
+ * Each slot starts with a sequence number: a slot at position pos may be
+ * written when seq == pos and may be read when seq == pos + 1.
+ */
+
+#ifdef CONFIG_MQ_RING
+struct mqueue_slot_s
+{
+  atomic_uint seq;            /* Slot sequence number */
+  char data[1];               /* Message data */
+};
+
+struct mqueue_ring_s
+{
+  atomic_uint head;           /* Next position to be written */
+  atomic_uint tail;           /* Next position to be read */
+  uint16_t slotsize;          /* Size of one slot in bytes */
+  char slots[1];              /* maxmsgs slots of slotsize bytes */
+};
+
+#  define MQ_RING_SLOT(r,i) \
+     ((FAR struct mqueue_slot_s *)&(r)->slots[(size_t)(i) * (r)->slotsize])
+#endif
+
 /* This structure defines a message queue */
 
 struct mqueue_inode_s
@@ -128,8 +155,40 @@ struct mqueue_inode_s
   struct sigwork_s ntwork;    /* Notification work */
 #endif
   FAR struct pollfd *fds[CONFIG_FS_MQUEUE_NPOLLWAITERS];
+#ifdef CONFIG_MQ_RING
+  FAR struct mqueue_ring_s *ring; /* Lock-free ring, NULL if prioritized */
+#endif
 };
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmq_nmsgs
+ *
+ * Description:
+ *   Return the number of messages in the message queue.  The count of a
+ *   ring queue is a snapshot that may change as soon as it is returned.
+ *
+ ****************************************************************************/
+
+static inline int nxmq_nmsgs(FAR struct mqueue_inode_s *msgq)
+{
+#ifdef CONFIG_MQ_RING
+  if (msgq->ring != NULL)
+    {
+      unsigned int tail = atomic_load(&msgq->ring->tail);
+      unsigned int head = atomic_load(&msgq->ring->head);
+      int nmsgs = (int)(head - tail);
+
+      return nmsgs < 0 ? 0 : nmsgs > msgq->maxmsgs ? msgq->maxmsgs : nmsgs;
+    }
+#endif
+
+  return msgq->nmsgs;
+}
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -793,6 +852,68 @@ int file_mq_setattr(FAR struct file *mq, FAR const struct mq_attr *mq_stat,
 
 int file_mq_getattr(FAR struct file *mq, FAR struct mq_attr *mq_stat);
 
+/****************************************************************************
+ * Name: file_mq_send_batch/nxmq_send_batch
+ *
+ * Description:
+ *   Add up to nmsgs messages of msglen bytes each, stored back to back in
+ *   msgs, to the message queue.  The call blocks (unless O_NONBLOCK is set)
+ *   only until the first message can be queued and then queues as many of
+ *   the remaining messages as fit without blocking again.  All messages
+ *   are sent with priority zero.
+ *
+ *   These are internal OS interfaces.  They are functionally equivalent to
+ *   mq_send_batch() except that they are not cancellation points and do
+ *   not modify the errno value.
+ *
+ * Input Parameters:
+ *   mq/mqdes - Message queue descriptor
+ *   msgs     - Messages to send
+ *   msglen   - The length of each message in bytes
+ *   nmsgs    - The number of messages in msgs
+ *
+ * Returned Value:
+ *   The number of messages sent on success.  A negated errno value is
+ *   returned on failure (see mq_send() for the list of valid errors).
+ *
+ ****************************************************************************/
+
+ssize_t file_mq_send_batch(FAR struct file *mq, FAR const char *msgs,
+                           size_t msglen, size_t nmsgs);
+ssize_t nxmq_send_batch(mqd_t mqdes, FAR const char *msgs, size_t msglen,
+                        size_t nmsgs);
+
+/****************************************************************************
+ * Name: file_mq_receive_batch/nxmq_receive_batch
+ *
+ * Description:
+ *   Receive up to nmsgs messages into msgs, one message every msglen
+ *   bytes.  The call blocks (unless O_NONBLOCK is set) only until the first
+ *   message is available and then takes as many queued messages as are
+ *   available without blocking again.
+ *
+ *   These are internal OS interfaces.  They are functionally equivalent to
+ *   mq_receive_batch() except that they are not cancellation points and do
+ *   not modify the errno value.
+ *
+ * Input Parameters:
+ *   mq/mqdes - Message queue descriptor
+ *   msgs     - Buffer to receive the messages
+ *   msglen   - The size of one message buffer; must not be less than the
+ *              maximum message size of the queue
+ *   nmsgs    - The number of message buffers in msgs
+ *
+ * Returned Value:
+ *   The number of messages received on success.  A negated errno value is
+ *   returned on failure (see mq_receive() for the list of valid errors).
+ *
+ ****************************************************************************/
+
+ssize_t file_mq_receive_batch(FAR struct file *mq, FAR char *msgs,
+                              size_t msglen, size_t nmsgs);
+ssize_t nxmq_receive_batch(mqd_t mqdes, FAR char *msgs, size_t msglen,
+                           size_t nmsgs);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
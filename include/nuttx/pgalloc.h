@@ -79,6 +79,16 @@
 #define MM_NPAGES(s)      (((uintptr_t)(s) + MM_PGMASK) >> MM_PGSHIFT)
 #define MM_ISALIGNED(a)   (((uintptr_t)(a) & MM_PGMASK) == 0)
 
+/* Large pages: physically contiguous and aligned runs of pages that the MMU
+ * can map with one TLB entry.
+ */
+
+#ifdef CONFIG_MM_PGALLOC_LARGEPAGE
+#  define MM_LGPGSIZE     CONFIG_MM_LGPGSIZE
+#  define MM_LGPGMASK     (MM_LGPGSIZE - 1)
+#  define MM_LGPGNPAGES   (MM_LGPGSIZE >> MM_PGSHIFT)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -166,6 +176,27 @@ void mm_pgreserve(uintptr_t start, size_t size);
 
 uintptr_t mm_pgalloc(unsigned int npages);
 
+/****************************************************************************
+ * Name: mm_pgalloc_large
+ *
+ * Description:
+ *   Allocate physically contiguous page memory from the page memory pool.
+ *   If the allocation spans at least one large page, it is aligned to
+ *   MM_LGPGSIZE.  The pages may be freed one at a time with mm_pgfree().
+ *
+ * Input Parameters:
+ *   npages - The number of pages to allocate, each of size CONFIG_MM_PGSIZE.
+ *
+ * Returned Value:
+ *   On success, a non-zero, physical address of the allocated page memory
+ *   is returned.  Zero is returned if there is no such contiguous memory.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_PGALLOC_LARGEPAGE
+uintptr_t mm_pgalloc_large(unsigned int npages);
+#endif
+
 /****************************************************************************
  * Name: mm_pgfree
  *
@@ -100,6 +100,12 @@
 #  define CONFIG_SCHED_CRITMONITOR_MAXTIME_WDOG -1
 #endif
 
+/* Scheduling latency histograms.  Bucket n counts the samples that took
+ * less than 2^n microseconds, the last bucket counts all longer samples.
+ */
+
+#define SCHED_LATENCY_NBUCKETS     16
+
 /* Task Management Definitions **********************************************/
 
 /* Special task IDS.  Any negative PID is invalid. */
@@ -573,6 +579,30 @@ struct task_group_s
   struct mm_map_s tg_mm_map;        /* Task group virtual memory mappings   */
 };
 
+/* struct sched_latency_s ***************************************************/
+
+#ifdef CONFIG_SCHED_LATENCY
+
+/* The kinds of scheduling latency that are measured */
+
+enum sched_latency_e
+{
+  SCHED_LATENCY_WAKEUP = 0,         /* Wakeup to running                    */
+  SCHED_LATENCY_RUNQUEUE,           /* Preempted to running again           */
+  SCHED_LATENCY_IRQ,                /* Interrupt entry to woken thread run  */
+  SCHED_LATENCY_NTYPES
+};
+
+/* One latency histogram, all times are in microseconds */
+
+struct sched_latency_s
+{
+  uint32_t count;                   /* Number of samples                    */
+  uint32_t max;                     /* Longest sample                       */
+  uint32_t bucket[SCHED_LATENCY_NBUCKETS];
+};
+#endif
+
 /* struct tcb_s *************************************************************/
 
 /* This is the common part of the task control block (TCB).
@@ -715,6 +745,15 @@ struct tcb_s
   void   *crit_max_caller;               /* Caller of max critical section  */
 #endif
 
+  /* Scheduling latency support *********************************************/
+
+#ifdef CONFIG_SCHED_LATENCY
+  clock_t lat_start;                     /* Time thread became ready to run */
+  clock_t lat_irq;                       /* Entry time of the waking IRQ    */
+  uint8_t lat_pending;                   /* Bit set of pending samples      */
+  struct sched_latency_s latency[SCHED_LATENCY_NTYPES];
+#endif
+
   /* State save areas *******************************************************/
 
   /* The form and content of these fields are platform-specific.            */
@@ -874,6 +913,13 @@ EXTERN clock_t g_premp_max[CONFIG_SMP_NCPUS];
 EXTERN clock_t g_crit_max[CONFIG_SMP_NCPUS];
 #endif /* CONFIG_SCHED_CRITMONITOR_MAXTIME_CSECTION >= 0 */
 
+/* Per-CPU scheduling latency histograms */
+
+#ifdef CONFIG_SCHED_LATENCY
+EXTERN struct sched_latency_s
+g_sched_latency[CONFIG_SMP_NCPUS][SCHED_LATENCY_NTYPES];
+#endif
+
 /* g_running_tasks[] holds a references to the running task for each CPU.
  * It is valid only when up_interrupt_context() returns true.
  */
@@ -941,6 +987,34 @@ void nxsched_foreach(nxsched_foreach_t handler, FAR void *arg);
 
 FAR struct tcb_s *nxsched_get_tcb(pid_t pid);
 
+/****************************************************************************
+ * Name: nxsched_reset_latency
+ *
+ * Description:
+ *   Clear the scheduling latency histograms of one thread or, if tcb is
+ *   NULL, the histograms of all CPUs and all threads.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LATENCY
+void nxsched_reset_latency(FAR struct tcb_s *tcb);
+#endif
+
+/****************************************************************************
+ * Name: nxsched_profile_sample
+ *
+ * Description:
+ *   Record the call stack of the thread running on this CPU in the
+ *   /proc/profile table, if the profiler is started.  Called from the
+ *   profiler timer and, optionally, from other interrupt driven sample
+ *   sources such as a PMU counter overflow.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_PROFILE_STACKS
+void nxsched_profile_sample(void);
+#endif
+
 /****************************************************************************
  * Name:  nxsched_releasepid
  *
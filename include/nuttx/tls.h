@@ -149,6 +149,10 @@ struct task_info_s
 #ifdef CONFIG_PTHREAD_ATFORK
   struct list_node ta_atfork; /* Holds the pthread_atfork_s list */
 #endif
+
+#ifdef CONFIG_MM_UMM_ARENA_TASK
+  FAR void       *ta_arena;  /* User heap arena of the task */
+#endif
 };
 
 /* struct tls_cleanup_s *****************************************************/
@@ -223,6 +227,10 @@ struct tls_info_s
 
   uint16_t tl_size;                    /* Actual size with alignments */
   int tl_errno;                        /* Per-thread error number */
+
+#ifdef CONFIG_MM_UMM_ARENA_THREAD
+  FAR void *tl_arena;                  /* User heap arena of the thread */
+#endif
 };
 
 /****************************************************************************
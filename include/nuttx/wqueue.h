@@ -177,6 +177,20 @@
 
 #endif /* CONFIG_SCHED_LPWORK */
 
+/* Per-CPU kernel work queue configuration **********************************/
+
+#ifdef CONFIG_SCHED_PCPUWORK
+
+#  ifndef CONFIG_SCHED_PCPUWORKPRIORITY
+#    define CONFIG_SCHED_PCPUWORKPRIORITY 192
+#  endif
+
+#  ifndef CONFIG_SCHED_PCPUWORKSTACKSIZE
+#    define CONFIG_SCHED_PCPUWORKSTACKSIZE CONFIG_IDLETHREAD_STACKSIZE
+#  endif
+
+#endif /* CONFIG_SCHED_PCPUWORK */
+
 /* User space work queue configuration **************************************/
 
 #ifdef CONFIG_LIBC_USRWORK
@@ -201,6 +215,10 @@
  *     used for any purpose.  if CONFIG_SCHED_LPWORK is not defined, then
  *     there is only one kernel work queue and LPWORK == HPWORK.
  *
+ *   PCPUWORK: This is the ID of the per-CPU work queues.  Work is placed
+ *     on the queue of the CPU that queues it.  If CONFIG_SCHED_PCPUWORK is
+ *     not defined, then PCPUWORK == HPWORK.
+ *
  * User Work Queue:
  *   USRWORK:  In the kernel phase a a kernel build, there should be no
  *     references to user-space work queues.  That would be an error.
@@ -214,6 +232,7 @@
 #  define USRWORK  2          /* User mode work queue */
 #  define HPWORK   USRWORK    /* Redirect kernel-mode references */
 #  define LPWORK   USRWORK
+#  define PCPUWORK USRWORK
 
 #else
 /* Kernel mode */
@@ -225,6 +244,11 @@
 #    define LPWORK HPWORK     /* Redirect low-priority references */
 #  endif
 #  define USRWORK  LPWORK     /* Redirect user-mode references */
+#  ifdef CONFIG_SCHED_PCPUWORK
+#    define PCPUWORK (LPWORK+1) /* Per-CPU, kernel-mode work queues */
+#  else
+#    define PCPUWORK HPWORK   /* Redirect per-CPU references */
+#  endif
 
 #endif /* CONFIG_LIBC_USRWORK && !__KERNEL__ */
 
@@ -261,6 +285,9 @@ struct work_s
   worker_t  worker;              /* Work callback */
   FAR void *arg;                 /* Callback argument */
   FAR struct kwork_wqueue_s *wq; /* Work queue */
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+  clock_t   ready;               /* perf time the work became ready */
+#endif
 };
 
 /* This is an enumeration of the various events that may be
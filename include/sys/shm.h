@@ -44,7 +44,12 @@
 
 #define SHM_R       0x03 /* or S_IRUGO */
 #define SHM_W       0x04 /* or S_IWUGO */
-#define SHM_HUGETLB 0x05 /* segment will use huge TLB pages */
+
+/* Segment will use huge TLB pages.  Not a permission bit, nor one of the
+ * IPC_* flags of sys/ipc.h.
+ */
+
+#define SHM_HUGETLB 0x1000
 
 /* Segment low boundary address multiple */
 
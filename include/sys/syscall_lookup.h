@@ -344,7 +344,9 @@ SYSCALL_LOOKUP(munmap,                     2)
   SYSCALL_LOOKUP(mq_notify,                2)
   SYSCALL_LOOKUP(mq_open,                  4)
   SYSCALL_LOOKUP(mq_receive,               4)
+  SYSCALL_LOOKUP(mq_receive_batch,         4)
   SYSCALL_LOOKUP(mq_send,                  4)
+  SYSCALL_LOOKUP(mq_send_batch,            4)
   SYSCALL_LOOKUP(mq_setattr,               3)
   SYSCALL_LOOKUP(mq_timedreceive,          5)
   SYSCALL_LOOKUP(mq_timedsend,             5)
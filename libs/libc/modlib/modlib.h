@@ -29,6 +29,19 @@
 
 #include <nuttx/addrenv.h>
 #include <nuttx/lib/modlib.h>
+#include <nuttx/symtab.h>
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef CONFIG_MODLIB_SYMHASH
+/* Hash index of the base code symbol table, kept across module loads and
+ * released when the table is replaced.  Protected by the registry lock.
+ */
+
+extern FAR struct modlib_symhash_s *g_modlib_exporthash;
+#endif
 
 /****************************************************************************
  * Public Function Prototypes
@@ -165,6 +178,44 @@ void *modlib_findglobal(FAR struct module_s *modp,
                         FAR Elf_Shdr *shdr,
                         FAR Elf_Sym *sym);
 
+/****************************************************************************
+ * Name: modlib_findexport
+ *
+ * Description:
+ *   Find the symbol with the matching name in an exported symbol table.
+ *   With CONFIG_MODLIB_SYMHASH the lookup goes through a hash index that
+ *   is kept at *hashp and reused until the table changes; otherwise this
+ *   is symtab_findbyname().
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry if an entry with the matching
+ *   name is found; NULL is returned if the entry is not found.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODLIB_SYMHASH
+FAR const struct symtab_s *
+modlib_findexport(FAR struct modlib_symhash_s **hashp,
+                  FAR const struct symtab_s *symtab,
+                  FAR const char *name, int nsyms);
+#else
+#  define modlib_findexport(h,s,n,c) symtab_findbyname(s,n,c)
+#endif
+
+/****************************************************************************
+ * Name: modlib_freeexport
+ *
+ * Description:
+ *   Release the hash index kept at *hashp by modlib_findexport().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODLIB_SYMHASH
+void modlib_freeexport(FAR struct modlib_symhash_s **hashp);
+#else
+#  define modlib_freeexport(h)
+#endif
+
 /****************************************************************************
  * Name: modlib_loadhdrs
  *
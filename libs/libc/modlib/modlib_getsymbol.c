@@ -30,6 +30,8 @@
 #include <nuttx/lib/modlib.h>
 #include <nuttx/symtab.h>
 
+#include "modlib/modlib.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -93,7 +95,7 @@ FAR const void *modlib_getsymbol(FAR void *handle, FAR const char *name)
 
   /* Search the symbol table for the matching symbol */
 
-  symbol = symtab_findbyname(modp->modinfo.exports, name,
+  symbol = modlib_findexport(&modp->symhash, modp->modinfo.exports, name,
                              modp->modinfo.nexports);
 
   modlib_registry_unlock();
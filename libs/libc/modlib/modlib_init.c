@@ -26,8 +26,10 @@
 
 #include <nuttx/config.h>
 
+#include <sys/ioctl.h>
 #include <sys/stat.h>
 
+#include <inttypes.h>
 #include <stdint.h>
 #include <string.h>
 #include <fcntl.h>
@@ -35,6 +37,7 @@
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/lib/modlib.h>
 
 #include "modlib/modlib.h"
@@ -79,6 +82,29 @@ static inline int modlib_fileinfo(FAR struct mod_loadinfo_s *loadinfo)
   return OK;
 }
 
+/****************************************************************************
+ * Name: modlib_fileimage
+ *
+ * Description:
+ *  Get the memory address of the whole ELF file if the file system can
+ *  provide it, so that modlib_read() can copy from memory.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODLIB_XIPIMAGE
+static void modlib_fileimage(FAR struct mod_loadinfo_s *loadinfo)
+{
+  uintptr_t base;
+
+  if (ioctl(loadinfo->filfd, FIOC_XIPBASE, (unsigned long)&base) >= 0 &&
+      base != 0)
+    {
+      binfo("ELF image at %" PRIxPTR "\n", base);
+      loadinfo->image = (FAR const uint8_t *)base;
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -126,6 +152,10 @@ int modlib_initialize(FAR const char *filename,
       return ret;
     }
 
+#ifdef CONFIG_MODLIB_XIPIMAGE
+  modlib_fileimage(loadinfo);
+#endif
+
   /* Read the ELF ehdr from offset 0 */
 
   ret = modlib_read(loadinfo, (FAR uint8_t *)&loadinfo->ehdr,
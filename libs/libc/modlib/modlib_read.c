@@ -84,6 +84,24 @@ int modlib_read(FAR struct mod_loadinfo_s *loadinfo, FAR uint8_t *buffer,
 
   binfo("Read %zu bytes from offset %" PRIdOFF "\n", readsize, offset);
 
+#ifdef CONFIG_MODLIB_XIPIMAGE
+  /* Copy directly from the file if it lies in memory */
+
+  if (loadinfo->image != NULL)
+    {
+      if (offset < 0 || offset > loadinfo->filelen ||
+          readsize > loadinfo->filelen - offset)
+        {
+          berr("ERROR: Unexpected end of file\n");
+          return -ENODATA;
+        }
+
+      memcpy(buffer, loadinfo->image + offset, readsize);
+      modlib_dumpreaddata(buffer, readsize);
+      return OK;
+    }
+#endif
+
   /* Loop until all of the requested data has been read. */
 
   /* Seek to the read position */
@@ -31,6 +31,8 @@
 #include <nuttx/lib/lib.h>
 #include <nuttx/lib/modlib.h>
 
+#include "modlib/modlib.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -93,6 +95,10 @@ int modlib_uninit(FAR struct module_s *modp)
 #endif
     }
 
+  /* Release the hash index of the exports */
+
+  modlib_freeexport(&modp->symhash);
+
   /* Release resources held by the module */
 
   if (modp->textalloc != NULL || modp->dataalloc != NULL)
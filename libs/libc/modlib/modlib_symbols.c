@@ -80,7 +80,8 @@ extern int nglobals;
  * Name: modlib_symname
  *
  * Description:
- *   Get the symbol name in loadinfo->iobuffer[].
+ *   Get the symbol name.  It is returned in place if the file lies in
+ *   memory, otherwise it is read into loadinfo->iobuffer[].
  *
  * Returned Value:
  *   0 (OK) is returned on success and a negated errno is returned on
@@ -93,7 +94,8 @@ extern int nglobals;
  ****************************************************************************/
 
 static int modlib_symname(FAR struct mod_loadinfo_s *loadinfo,
-                          FAR const Elf_Sym *sym, Elf_Off sh_offset)
+                          FAR const Elf_Sym *sym, Elf_Off sh_offset,
+                          FAR const char **name)
 {
   FAR uint8_t *buffer;
   off_t  offset;
@@ -111,6 +113,24 @@ static int modlib_symname(FAR struct mod_loadinfo_s *loadinfo,
       return -ESRCH;
     }
 
+  offset = sh_offset + sym->st_name;
+
+#ifdef CONFIG_MODLIB_XIPIMAGE
+  if (loadinfo->image != NULL)
+    {
+      if (offset >= loadinfo->filelen ||
+          memchr(loadinfo->image + offset, '\0',
+                 loadinfo->filelen - offset) == NULL)
+        {
+          berr("ERROR: At end of file\n");
+          return -EINVAL;
+        }
+
+      *name = (FAR const char *)loadinfo->image + offset;
+      return OK;
+    }
+#endif
+
   /* Allocate an I/O buffer.  This buffer is used by mod_symname() to
    * accumulate the variable length symbol name.
    */
@@ -122,8 +142,6 @@ static int modlib_symname(FAR struct mod_loadinfo_s *loadinfo,
       return -ENOMEM;
     }
 
-  offset = sh_offset + sym->st_name;
-
   /* Loop until we get the entire symbol name into memory */
 
   bytesread = 0;
@@ -162,6 +180,7 @@ static int modlib_symname(FAR struct mod_loadinfo_s *loadinfo,
         {
           /* Yes, the buffer contains a NUL terminator. */
 
+          *name = (FAR const char *)loadinfo->iobuffer;
           return OK;
         }
 
@@ -203,7 +222,8 @@ static int modlib_symcallback(FAR struct module_s *modp, FAR void *arg)
 
   /* Check if this module exports a symbol of that name */
 
-  exportinfo->symbol = symtab_findbyname(modp->modinfo.exports,
+  exportinfo->symbol = modlib_findexport(&modp->symhash,
+                                         modp->modinfo.exports,
                                          exportinfo->name,
                                          modp->modinfo.nexports);
 
@@ -344,6 +364,7 @@ int modlib_symvalue(FAR struct module_s *modp,
 {
   FAR const struct symtab_s *symbol;
   struct mod_exportinfo_s exportinfo;
+  FAR const char *name;
   uintptr_t secbase;
   int ret;
 
@@ -369,7 +390,7 @@ int modlib_symvalue(FAR struct module_s *modp,
       {
         /* Get the name of the undefined symbol */
 
-        ret = modlib_symname(loadinfo, sym, sh_offset);
+        ret = modlib_symname(loadinfo, sym, sh_offset, &name);
         if (ret < 0)
           {
             /* There are a few relocations for a few architectures that do
@@ -388,7 +409,7 @@ int modlib_symvalue(FAR struct module_s *modp,
          * recently installed will take precedence.
          */
 
-        exportinfo.name   = (FAR const char *)loadinfo->iobuffer;
+        exportinfo.name   = name;
         exportinfo.modp   = modp;
         exportinfo.symbol = NULL;
 
@@ -408,8 +429,10 @@ int modlib_symvalue(FAR struct module_s *modp,
 
         if (symbol == NULL)
           {
-            symbol = symtab_findbyname(exports, exportinfo.name,
-                                       nexports);
+            modlib_registry_lock();
+            symbol = modlib_findexport(&g_modlib_exporthash, exports,
+                                       exportinfo.name, nexports);
+            modlib_registry_unlock();
           }
 
         /* Was the symbol found from any exporter? */
@@ -417,7 +440,7 @@ int modlib_symvalue(FAR struct module_s *modp,
         if (symbol == NULL)
           {
             berr("ERROR: SHN_UNDEF: Exported symbol \"%s\" not found\n",
-                 loadinfo->iobuffer);
+                 name);
             return -ENOENT;
           }
 
@@ -427,7 +450,7 @@ int modlib_symvalue(FAR struct module_s *modp,
 
         binfo("SHN_UNDEF: name=%s "
               "%08" PRIxPTR "+%08" PRIxPTR "=%08" PRIxPTR "\n",
-              loadinfo->iobuffer,
+              name,
               (uintptr_t)sym->st_value, (uintptr_t)symbol->sym_value,
               (uintptr_t)(sym->st_value + (uintptr_t)symbol->sym_value));
 
@@ -483,6 +506,7 @@ int modlib_insertsymtab(FAR struct module_s *modp,
 {
   FAR struct symtab_s *symbol;
   FAR Elf_Shdr *strtab = &loadinfo->shdr[shdr->sh_link];
+  FAR const char *name;
   int ret = 0;
   int i;
   int j;
@@ -526,7 +550,8 @@ int modlib_insertsymtab(FAR struct module_s *modp,
                   ELF_ST_TYPE(sym[i].st_info) != STT_NOTYPE &&
                   ELF_ST_VISIBILITY(sym[i].st_other) == STV_DEFAULT)
                 {
-                  ret = modlib_symname(loadinfo, &sym[i], strtab->sh_offset);
+                  ret = modlib_symname(loadinfo, &sym[i], strtab->sh_offset,
+                                       &name);
                   if (ret < 0)
                     {
                       lib_free((FAR void *)modp->modinfo.exports);
@@ -534,8 +559,7 @@ int modlib_insertsymtab(FAR struct module_s *modp,
                       return ret;
                     }
 
-                  symbol[j].sym_name =
-                      strdup((FAR char *)loadinfo->iobuffer);
+                  symbol[j].sym_name = strdup(name);
                   symbol[j].sym_value =
                       (FAR const void *)(uintptr_t)sym[i].st_value;
                   j++;
@@ -591,17 +615,18 @@ void *modlib_findglobal(FAR struct module_s *modp,
                         FAR Elf_Shdr *shdr, FAR Elf_Sym *sym)
 {
   FAR Elf_Shdr *strtab = &loadinfo->shdr[shdr->sh_link];
+  FAR const char *name;
   int ret;
   struct eptable_s key;
   FAR struct eptable_s *res;
 
-  ret = modlib_symname(loadinfo, sym, strtab->sh_offset);
+  ret = modlib_symname(loadinfo, sym, strtab->sh_offset, &name);
   if (ret < 0)
     {
       return NULL;
     }
 
-  key.epname = loadinfo->iobuffer;
+  key.epname = (FAR uint8_t *)name;
   res = bsearch(&key, global_table, nglobals,
                 sizeof(struct eptable_s), findep);
   if (res != NULL)
@@ -630,6 +655,8 @@ void modlib_freesymtab(FAR struct module_s *modp)
   FAR const struct symtab_s *symbol;
   int i;
 
+  modlib_freeexport(&modp->symhash);
+
   if ((symbol = modp->modinfo.exports) != NULL)
     {
       for (i = 0; i < modp->modinfo.nexports; i++)
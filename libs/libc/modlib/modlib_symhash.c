@@ -0,0 +1,217 @@
+/****************************************************************************
+ * libs/libc/modlib/modlib_symhash.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <inttypes.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/symtab.h>
+#include <nuttx/lib/modlib.h>
+
+#include "libc.h"
+#include "modlib/modlib.h"
+
+#ifdef CONFIG_MODLIB_SYMHASH
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A chained hash index over a symbol table.  The bucket and chain arrays
+ * and the full hash of each symbol follow the header in one allocation.
+ */
+
+struct modlib_symhash_s
+{
+  FAR const struct symtab_s *symtab; /* The indexed symbol table */
+  int       nsyms;                   /* Number of symbols in symtab */
+  uint32_t  mask;                    /* Number of buckets - 1 */
+  FAR int  *bucket;                  /* First symbol of each bucket or -1 */
+  FAR int  *chain;                   /* Next symbol in the bucket or -1 */
+  FAR uint32_t *hash;                /* Hash of each symbol */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: modlib_hashname
+ *
+ * Description:
+ *   The DJB hash used by DT_GNU_HASH.
+ *
+ ****************************************************************************/
+
+static uint32_t modlib_hashname(FAR const char *name)
+{
+  uint32_t h = 5381;
+
+  while (*name != '\0')
+    {
+      h = (h << 5) + h + (uint8_t)*name++;
+    }
+
+  return h;
+}
+
+/****************************************************************************
+ * Name: modlib_symhash_build
+ *
+ * Description:
+ *   Build a hash index over the symbol table.
+ *
+ ****************************************************************************/
+
+static FAR struct modlib_symhash_s *
+modlib_symhash_build(FAR const struct symtab_s *symtab, int nsyms)
+{
+  FAR struct modlib_symhash_s *index;
+  uint32_t nbuckets = 1;
+  uint32_t slot;
+  int i;
+
+  /* Aim for two symbols per bucket */
+
+  while (nbuckets < (uint32_t)nsyms / 2)
+    {
+      nbuckets <<= 1;
+    }
+
+  index = lib_malloc(sizeof(*index) + nbuckets * sizeof(int) +
+                     nsyms * (sizeof(int) + sizeof(uint32_t)));
+  if (index == NULL)
+    {
+      return NULL;
+    }
+
+  index->symtab = symtab;
+  index->nsyms  = nsyms;
+  index->mask   = nbuckets - 1;
+  index->bucket = (FAR int *)(index + 1);
+  index->chain  = index->bucket + nbuckets;
+  index->hash   = (FAR uint32_t *)(index->chain + nsyms);
+
+  memset(index->bucket, 0xff, nbuckets * sizeof(int));
+
+  /* Insert backwards so that each chain is in table order and the first
+   * of several symbols with the same name wins, like the linear search.
+   */
+
+  for (i = nsyms - 1; i >= 0; i--)
+    {
+      index->hash[i]      = modlib_hashname(symtab[i].sym_name);
+      slot                = index->hash[i] & index->mask;
+      index->chain[i]     = index->bucket[slot];
+      index->bucket[slot] = i;
+    }
+
+  binfo("Hashed %d symbols into %" PRIu32 " buckets\n", nsyms, nbuckets);
+  return index;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: modlib_findexport
+ *
+ * Description:
+ *   Find the symbol with the matching name through the hash index at
+ *   *hashp, building or rebuilding the index when it does not describe
+ *   symtab.  The index then persists across module loads until it is
+ *   released with modlib_freeexport().  If there is no memory for the
+ *   index, this falls back to symtab_findbyname().
+ *
+ * Assumptions:
+ *   The caller holds the lock on the module registry.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *
+modlib_findexport(FAR struct modlib_symhash_s **hashp,
+                  FAR const struct symtab_s *symtab,
+                  FAR const char *name, int nsyms)
+{
+  FAR struct modlib_symhash_s *index = *hashp;
+  uint32_t h;
+  int i;
+
+  if (symtab == NULL || nsyms <= 0)
+    {
+      return NULL;
+    }
+
+  if (index == NULL || index->symtab != symtab || index->nsyms != nsyms)
+    {
+      modlib_freeexport(hashp);
+      index = *hashp = modlib_symhash_build(symtab, nsyms);
+      if (index == NULL)
+        {
+          return symtab_findbyname(symtab, name, nsyms);
+        }
+    }
+
+#ifdef CONFIG_SYMTAB_DECORATED
+  if (name[0] == '_')
+    {
+      name++;
+    }
+#endif
+
+  h = modlib_hashname(name);
+  for (i = index->bucket[h & index->mask]; i >= 0; i = index->chain[i])
+    {
+      if (index->hash[i] == h && strcmp(name, symtab[i].sym_name) == 0)
+        {
+          return &symtab[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: modlib_freeexport
+ *
+ * Description:
+ *   Release the hash index at *hashp.
+ *
+ ****************************************************************************/
+
+void modlib_freeexport(FAR struct modlib_symhash_s **hashp)
+{
+  if (*hashp != NULL)
+    {
+      lib_free(*hashp);
+      *hashp = NULL;
+    }
+}
+
+#endif /* CONFIG_MODLIB_SYMHASH */
@@ -32,6 +32,8 @@
 #include <nuttx/lib/modlib.h>
 #include <nuttx/symtab.h>
 
+#include "modlib/modlib.h"
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -59,6 +61,10 @@ extern const struct symtab_s CONFIG_MODLIB_SYMTAB_ARRAY[];
 extern int CONFIG_MODLIB_NSYMBOLS_VAR;
 #endif
 
+#ifdef CONFIG_MODLIB_SYMHASH
+FAR struct modlib_symhash_s *g_modlib_exporthash;
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -128,5 +134,11 @@ void modlib_setsymtab(FAR const struct symtab_s *symtab, int nsymbols)
   modlib_registry_lock();
   g_modlib_symtab   = symtab;
   g_modlib_nsymbols = nsymbols;
+
+  /* The table may have been rebuilt in place, so the index can not be
+   * told stale by its address and size.
+   */
+
+  modlib_freeexport(&g_modlib_exporthash);
   modlib_registry_unlock();
 }
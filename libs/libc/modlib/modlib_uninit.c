@@ -64,6 +64,9 @@ int modlib_uninitialize(FAR struct mod_loadinfo_s *loadinfo)
     {
       _NX_CLOSE(loadinfo->filfd);
       loadinfo->filfd = -1;
+#ifdef CONFIG_MODLIB_XIPIMAGE
+      loadinfo->image = NULL;
+#endif
     }
 
   return OK;
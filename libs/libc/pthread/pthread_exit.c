@@ -30,6 +30,7 @@
 #include <debug.h>
 #include <sched.h>
 
+#include <nuttx/mm/mm.h>
 #include <nuttx/pthread.h>
 #include <nuttx/tls.h>
 
@@ -68,6 +69,10 @@ void pthread_exit(FAR void *exit_value)
   tls_destruct();
 #endif
 
+#ifdef CONFIG_MM_UMM_ARENA_THREAD
+  umm_arena_release();
+#endif
+
   nx_pthread_exit(exit_value);
   PANIC();
 }
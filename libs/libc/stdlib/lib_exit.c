@@ -33,6 +33,7 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#include <nuttx/mm/mm.h>
 #include <nuttx/tls.h>
 #include <nuttx/pthread.h>
 
@@ -121,6 +122,10 @@ void exit(int status)
   fflush(NULL);
 #endif
 
+  /* Give up the heap arena after all exit functions have freed memory */
+
+  umm_arena_release();
+
   /* Then perform the exit */
 
   _exit(status);
@@ -31,6 +31,7 @@
 
 #include <assert.h>
 #include <stdint.h>
+#include <string.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -51,6 +52,18 @@
 #define KASAN_REGION_SIZE(size) \
   (sizeof(struct kasan_region_s) + KASAN_SHADOW_SIZE(size))
 
+/* The address range spanned by the regions is divided into KASAN_DIR_SIZE
+ * power of two sized chunks.  Each chunk records the first region that
+ * ends after the chunk start, so a lookup starts right at the region that
+ * may contain the address instead of scanning all of them.
+ */
+
+#define KASAN_DIR_SIZE 256
+
+#if CONFIG_MM_KASAN_REGIONS > UINT8_MAX
+#  error "CONFIG_MM_KASAN_REGIONS does not fit the lookup directory"
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -70,6 +83,11 @@ static FAR struct kasan_region_s *g_region[CONFIG_MM_KASAN_REGIONS];
 static size_t g_region_count;
 static spinlock_t g_lock;
 
+static uint8_t g_dir[KASAN_DIR_SIZE];
+static uintptr_t g_dir_base;
+static uintptr_t g_dir_span;
+static unsigned int g_dir_shift;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -81,9 +99,19 @@ kasan_mem_to_shadow(FAR const void *ptr, size_t size,
   uintptr_t addr = (uintptr_t)ptr;
   size_t i;
 
-  for (i = 0; i < g_region_count; i++)
+  if (addr - g_dir_base >= g_dir_span)
+    {
+      return NULL;
+    }
+
+  /* The regions are sorted, so only the one the chunk points to and
+   * possibly its successors in the same chunk need to be tested.
+   */
+
+  for (i = g_dir[(addr - g_dir_base) >> g_dir_shift];
+       i < g_region_count && addr >= g_region[i]->begin; i++)
     {
-      if (addr >= g_region[i]->begin && addr < g_region[i]->end)
+      if (addr < g_region[i]->end)
         {
           DEBUGASSERT(addr + size <= g_region[i]->end);
           addr -= g_region[i]->begin;
@@ -96,6 +124,39 @@ kasan_mem_to_shadow(FAR const void *ptr, size_t size,
   return NULL;
 }
 
+static void kasan_update_dir(void)
+{
+  uintptr_t chunk;
+  size_t i;
+  size_t j;
+
+  if (g_region_count == 0)
+    {
+      g_dir_span = 0;
+      return;
+    }
+
+  g_dir_base  = g_region[0]->begin;
+  g_dir_span  = g_region[g_region_count - 1]->end - g_dir_base;
+  g_dir_shift = 0;
+
+  while ((g_dir_span - 1) >> g_dir_shift >= KASAN_DIR_SIZE)
+    {
+      g_dir_shift++;
+    }
+
+  for (i = 0, j = 0; i < KASAN_DIR_SIZE; i++)
+    {
+      chunk = g_dir_base + ((uintptr_t)i << g_dir_shift);
+      while (j < g_region_count && g_region[j]->end <= chunk)
+        {
+          j++;
+        }
+
+      g_dir[i] = j;
+    }
+}
+
 static inline_function bool
 kasan_is_poisoned(FAR const void *addr, size_t size)
 {
@@ -110,15 +171,24 @@ kasan_is_poisoned(FAR const void *addr, size_t size)
       return kasan_global_is_poisoned(addr, size);
     }
 
-  if (size <= KASAN_SHADOW_SCALE)
+  /* Number of shadow bits covering the access, it may start and end in
+   * the middle of a granule.
+   */
+
+  size = ((uintptr_t)addr % KASAN_SHADOW_SCALE + size +
+          KASAN_SHADOW_SCALE - 1) / KASAN_SHADOW_SCALE;
+
+  /* All accesses of up to 16 bytes, unless they straddle shadow words,
+   * and most smaller ranges are checked with a single shadow word.
+   */
+
+  if (bit + size <= KASAN_BITS_PER_WORD)
     {
-      return ((*p >> bit) & 1);
+      return (*p >> bit) & (UINTPTR_MAX >> (KASAN_BITS_PER_WORD - size));
     }
 
   nbit = KASAN_BITS_PER_WORD - bit % KASAN_BITS_PER_WORD;
   mask = KASAN_FIRST_WORD_MASK(bit);
-  size = ALIGN_UP(size, KASAN_SHADOW_SCALE);
-  size /= KASAN_SHADOW_SCALE;
 
   while (size >= nbit)
     {
@@ -166,7 +236,7 @@ static void kasan_set_poison(FAR const void *addr, size_t size,
   size /= KASAN_SHADOW_SCALE;
 
   flags = spin_lock_irqsave(&g_lock);
-  while (size >= nbit)
+  if (size >= nbit)
     {
       if (poisoned)
         {
@@ -179,9 +249,16 @@ static void kasan_set_poison(FAR const void *addr, size_t size,
 
       bit  += nbit;
       size -= nbit;
+      mask  = UINTPTR_MAX;
 
-      nbit = KASAN_BITS_PER_WORD;
-      mask = UINTPTR_MAX;
+      /* Fill the whole shadow words at once */
+
+      nbit = size / KASAN_BITS_PER_WORD;
+      memset(p, poisoned ? 0xff : 0, nbit * KASAN_BYTES_PER_WORD);
+
+      p    += nbit;
+      bit  += nbit * KASAN_BITS_PER_WORD;
+      size -= nbit * KASAN_BITS_PER_WORD;
     }
 
   if (size)
@@ -224,6 +301,7 @@ void kasan_register(FAR void *addr, FAR size_t *size)
 {
   FAR struct kasan_region_s *region;
   irqstate_t flags;
+  size_t i;
 
   region = (FAR struct kasan_region_s *)
     ((FAR char *)addr + *size - KASAN_REGION_SIZE(*size));
@@ -233,8 +311,23 @@ void kasan_register(FAR void *addr, FAR size_t *size)
 
   flags = spin_lock_irqsave(&g_lock);
 
-  DEBUGASSERT(g_region_count <= CONFIG_MM_KASAN_REGIONS);
-  g_region[g_region_count++] = region;
+  DEBUGASSERT(g_region_count < CONFIG_MM_KASAN_REGIONS);
+
+  /* Keep the regions sorted by address for the lookup directory */
+
+  for (i = g_region_count; i > 0; i--)
+    {
+      if (g_region[i - 1]->begin < region->begin)
+        {
+          break;
+        }
+
+      g_region[i] = g_region[i - 1];
+    }
+
+  g_region[i] = region;
+  g_region_count++;
+  kasan_update_dir();
 
   spin_unlock_irqrestore(&g_lock, flags);
 
@@ -256,6 +349,7 @@ void kasan_unregister(FAR void *addr)
           g_region_count--;
           memmove(&g_region[i], &g_region[i + 1],
                   (g_region_count - i) * sizeof(g_region[0]));
+          kasan_update_dir();
           break;
         }
     }
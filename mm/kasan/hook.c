@@ -31,6 +31,7 @@
 #include <execinfo.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #ifdef CONFIG_MM_KASAN_GLOBAL
 #  include "global.c"
@@ -398,6 +399,28 @@ void __asan_storeN(FAR void *addr, size_t size)
   kasan_check_report(addr, size, true, return_address(0));
 }
 
+/* Memory intrinsics are checked as one range each instead of per access */
+
+FAR void *__asan_memcpy(FAR void *dest, FAR const void *src, size_t n)
+{
+  kasan_check_report(src, n, false, return_address(0));
+  kasan_check_report(dest, n, true, return_address(0));
+  return memcpy(dest, src, n);
+}
+
+FAR void *__asan_memmove(FAR void *dest, FAR const void *src, size_t n)
+{
+  kasan_check_report(src, n, false, return_address(0));
+  kasan_check_report(dest, n, true, return_address(0));
+  return memmove(dest, src, n);
+}
+
+FAR void *__asan_memset(FAR void *s, int c, size_t n)
+{
+  kasan_check_report(s, n, true, return_address(0));
+  return memset(s, c, n);
+}
+
 /* Generic KASan will instrument the following functions */
 
 DEFINE_ASAN_LOAD_STORE(1)
@@ -38,20 +38,134 @@
 
 #if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Each node caches the highest end address in its subtree, which lets
+ * lookups skip the subtrees that can't contain the range.  The tree code
+ * calls RB_AUGMENT on the nodes it rotates.
+ */
+
+#undef  RB_AUGMENT
+#define RB_AUGMENT(x) mm_map_augment(x)
+
+#define MM_MAP_END(e) ((uintptr_t)(e)->vaddr + (e)->length)
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void mm_map_augment(FAR struct mm_map_entry_s *entry);
+static int mm_map_compare(FAR const struct mm_map_entry_s *a,
+                          FAR const struct mm_map_entry_s *b);
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
-static bool in_range(FAR const void *start, size_t length,
-                     FAR const void *range_start, size_t range_length)
+RB_GENERATE_STATIC(mm_map_tree_s, mm_map_entry_s, node, mm_map_compare);
+
+static int mm_map_compare(FAR const struct mm_map_entry_s *a,
+                          FAR const struct mm_map_entry_s *b)
+{
+  /* Mappings may share an address, e.g. the same shared memory object
+   * mapped twice in the flat build.  Order them by the entry address then.
+   */
+
+  if (a->vaddr != b->vaddr)
+    {
+      return (uintptr_t)a->vaddr < (uintptr_t)b->vaddr ? -1 : 1;
+    }
+
+  if (a != b)
+    {
+      return (uintptr_t)a < (uintptr_t)b ? -1 : 1;
+    }
+
+  return 0;
+}
+
+static void mm_map_augment(FAR struct mm_map_entry_s *entry)
+{
+  FAR struct mm_map_entry_s *child;
+  uintptr_t maxend = MM_MAP_END(entry);
+
+  child = RB_LEFT(entry, node);
+  if (child != NULL && child->maxend > maxend)
+    {
+      maxend = child->maxend;
+    }
+
+  child = RB_RIGHT(entry, node);
+  if (child != NULL && child->maxend > maxend)
+    {
+      maxend = child->maxend;
+    }
+
+  entry->maxend = maxend;
+}
+
+/* Recalculate the subtree end of the entry and all of its ancestors */
+
+static void mm_map_augment_path(FAR struct mm_map_entry_s *entry)
+{
+  for (; entry != NULL; entry = RB_PARENT(entry, node))
+    {
+      mm_map_augment(entry);
+    }
+}
+
+static void mm_map_insert(FAR struct mm_map_s *mm,
+                          FAR struct mm_map_entry_s *entry)
+{
+  RB_INSERT(mm_map_tree_s, &mm->mm_map_tree, entry);
+  mm_map_augment_path(entry);
+  mm->map_count++;
+}
+
+static void mm_map_unlink(FAR struct mm_map_s *mm,
+                          FAR struct mm_map_entry_s *entry)
 {
-  FAR const char *u_start = (FAR const char *)start;
-  FAR const char *u_end = u_start + length;
-  FAR const char *r_start = (FAR const char *)range_start;
-  FAR const char *r_end = r_start + range_length;
+  FAR struct mm_map_entry_s *parent = RB_PARENT(entry, node);
 
-  return (u_start >= r_start && u_start < r_end && /* Start is in range. */
-          u_end >= r_start && u_end <= r_end);     /* End is in range. */
+  RB_REMOVE(mm_map_tree_s, &mm->mm_map_tree, entry);
+  mm_map_augment_path(parent);
+  mm->map_count--;
+}
+
+/* Find the lowest mapping in the subtree containing [start, end) */
+
+static FAR struct mm_map_entry_s *
+mm_map_search(FAR struct mm_map_entry_s *entry, uintptr_t start,
+              uintptr_t end)
+{
+  FAR struct mm_map_entry_s *found;
+
+  while (entry != NULL && entry->maxend >= end)
+    {
+      found = mm_map_search(RB_LEFT(entry, node), start, end);
+      if (found != NULL)
+        {
+          return found;
+        }
+
+      /* Everything to the right starts after this entry */
+
+      if ((uintptr_t)entry->vaddr > start)
+        {
+          break;
+        }
+
+      if (MM_MAP_END(entry) >= end && MM_MAP_END(entry) > start)
+        {
+          return entry;
+        }
+
+      entry = RB_RIGHT(entry, node);
+    }
+
+  return NULL;
 }
 
 /****************************************************************************
@@ -111,7 +225,7 @@ void mm_map_unlock(void)
 
 void mm_map_initialize(FAR struct mm_map_s *mm, bool kernel)
 {
-  sq_init(&mm->mm_map_sq);
+  RB_INIT(&mm->mm_map_tree);
   nxrmutex_init(&mm->mm_map_mutex);
   mm->map_count = 0;
 
@@ -146,8 +260,10 @@ void mm_map_destroy(FAR struct mm_map_s *mm)
 {
   FAR struct mm_map_entry_s *entry;
 
-  while ((entry = (FAR struct mm_map_entry_s *)sq_remfirst(&mm->mm_map_sq)))
+  while ((entry = RB_MIN(mm_map_tree_s, &mm->mm_map_tree)) != NULL)
     {
+      mm_map_unlink(mm, entry);
+
       /* Pass null as group argument to indicate that actual MMU mappings
        * must not be touched. The process is being deleted and we don't
        * know in which context we are. Only kernel memory allocations
@@ -168,8 +284,6 @@ void mm_map_destroy(FAR struct mm_map_s *mm)
             }
         }
 
-      mm->map_count--;
-
       kmm_free(entry);
     }
 
@@ -191,7 +305,7 @@ void mm_map_destroy(FAR struct mm_map_s *mm)
  * Name: mm_map_add
  *
  * Description:
- *   Add a mapping to task group's mm_map list
+ *   Add a mapping to task group's mm_map tree
  *
  ****************************************************************************/
 
@@ -205,7 +319,7 @@ int mm_map_add(FAR struct mm_map_s *mm, FAR struct mm_map_entry_s *entry)
       return -EINVAL;
     }
 
-  /* Copy the provided mapping and add to the list */
+  /* Copy the provided mapping and add to the tree */
 
   new_entry = kmm_malloc(sizeof(struct mm_map_entry_s));
   if (!new_entry)
@@ -222,8 +336,7 @@ int mm_map_add(FAR struct mm_map_s *mm, FAR struct mm_map_entry_s *entry)
       return ret;
     }
 
-  mm->map_count++;
-  sq_addfirst((sq_entry_t *)new_entry, &mm->mm_map_sq);
+  mm_map_insert(mm, new_entry);
   nxrmutex_unlock(&mm->mm_map_mutex);
 
   return OK;
@@ -233,7 +346,7 @@ int mm_map_add(FAR struct mm_map_s *mm, FAR struct mm_map_entry_s *entry)
  * Name: mm_map_next
  *
  * Description:
- *   Returns the next mapping in the list.
+ *   Returns the next mapping in the tree.
  *
  ****************************************************************************/
 
@@ -246,12 +359,12 @@ FAR struct mm_map_entry_s *mm_map_next(FAR struct mm_map_s *mm,
     {
       if (entry == NULL)
         {
-          next_entry = (struct mm_map_entry_s *)sq_peek(&mm->mm_map_sq);
+          next_entry = RB_MIN(mm_map_tree_s, &mm->mm_map_tree);
         }
       else
         {
-          next_entry = (struct mm_map_entry_s *)
-            sq_next(((sq_entry_t *)entry));
+          next_entry = RB_NEXT(mm_map_tree_s, &mm->mm_map_tree,
+                               (FAR struct mm_map_entry_s *)entry);
         }
 
       nxrmutex_unlock(&mm->mm_map_mutex);
@@ -264,7 +377,7 @@ FAR struct mm_map_entry_s *mm_map_next(FAR struct mm_map_s *mm,
  * Name: mm_map_find
  *
  * Description:
- *   Find the first mapping containing the range from the task group's list
+ *   Find the first mapping containing the range from the task group's tree
  *
  ****************************************************************************/
 
@@ -276,15 +389,9 @@ FAR struct mm_map_entry_s *mm_map_find(FAR struct mm_map_s *mm,
 
   if (nxrmutex_lock(&mm->mm_map_mutex) == OK)
     {
-      found_entry = (struct mm_map_entry_s *)sq_peek(&mm->mm_map_sq);
-
-      while (found_entry && !in_range(vaddr, length,
-                                      found_entry->vaddr,
-                                      found_entry->length))
-        {
-          found_entry = (struct mm_map_entry_s *)
-            sq_next(((sq_entry_t *)found_entry));
-        }
+      found_entry = mm_map_search(RB_ROOT(&mm->mm_map_tree),
+                                  (uintptr_t)vaddr,
+                                  (uintptr_t)vaddr + length);
 
       nxrmutex_unlock(&mm->mm_map_mutex);
     }
@@ -296,15 +403,14 @@ FAR struct mm_map_entry_s *mm_map_find(FAR struct mm_map_s *mm,
  * Name: mm_map_remove
  *
  * Description:
- *   Remove a mapping from the task  group's list
+ *   Remove a mapping from the task  group's tree
  *
  ****************************************************************************/
 
 int mm_map_remove(FAR struct mm_map_s *mm,
                   FAR struct mm_map_entry_s *entry)
 {
-  FAR struct mm_map_entry_s *prev_entry;
-  FAR struct mm_map_entry_s *removed_entry = NULL;
+  FAR struct mm_map_entry_s *removed_entry;
   int ret;
 
   if (!mm || !entry)
@@ -318,40 +424,12 @@ int mm_map_remove(FAR struct mm_map_s *mm,
       return ret;
     }
 
-  prev_entry = (struct mm_map_entry_s *)sq_peek(&mm->mm_map_sq);
-
-  /* Check if the list was empty */
-
-  if (!prev_entry)
-    {
-      nxrmutex_unlock(&mm->mm_map_mutex);
-      return -ENOENT;
-    }
-
-  /* Check if removing the first item */
+  /* Make sure that the entry belongs to this tree */
 
-  if (entry == prev_entry)
-    {
-      sq_remfirst(&mm->mm_map_sq);
-      mm->map_count--;
-      removed_entry = prev_entry;
-    }
-  else
+  removed_entry = RB_FIND(mm_map_tree_s, &mm->mm_map_tree, entry);
+  if (removed_entry)
     {
-      /* Loop through the remaining items to find the one to be removed */
-
-      while ((removed_entry = (struct mm_map_entry_s *)
-              sq_next(((sq_entry_t *)prev_entry))))
-        {
-          if (entry == removed_entry)
-            {
-              sq_remafter((sq_entry_t *)prev_entry, &mm->mm_map_sq);
-              mm->map_count--;
-              break;
-            }
-
-          prev_entry = removed_entry;
-        }
+      mm_map_unlink(mm, removed_entry);
     }
 
   nxrmutex_unlock(&mm->mm_map_mutex);
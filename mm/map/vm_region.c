@@ -62,7 +62,21 @@ FAR void *vm_alloc_region(FAR struct mm_map_s *mm, FAR void *vaddr,
     {
       if (vaddr == NULL)
         {
-          ret = gran_alloc(mm->mm_map_vpages, size);
+#ifdef CONFIG_MM_PGALLOC_LARGEPAGE
+          /* Keep the virtual and physical large pages congruent.  The
+           * alignment is only a hint, so fall back to any free range.
+           */
+
+          if (size >= MM_LGPGSIZE)
+            {
+              ret = gran_alloc_align(mm->mm_map_vpages, size, MM_LGPGSIZE);
+            }
+
+          if (ret == NULL)
+#endif
+            {
+              ret = gran_alloc(mm->mm_map_vpages, size);
+            }
         }
       else
         {
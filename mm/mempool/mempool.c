@@ -98,6 +98,36 @@ static inline void mempool_add_queue(FAR struct mempool_s *pool,
     }
 }
 
+/* Remove the free blocks that lie in [start, end) from a free queue */
+
+static void mempool_remove_range(FAR sq_queue_t *queue,
+                                 FAR const char *start, FAR const char *end)
+{
+  FAR sq_entry_t *prev = NULL;
+  FAR sq_entry_t *blk;
+  FAR sq_entry_t *next;
+
+  for (blk = sq_peek(queue); blk != NULL; blk = next)
+    {
+      next = sq_next(blk);
+      if ((FAR char *)blk >= start && (FAR char *)blk < end)
+        {
+          if (prev == NULL)
+            {
+              sq_remfirst(queue);
+            }
+          else
+            {
+              sq_remafter(prev, queue);
+            }
+        }
+      else
+        {
+          prev = blk;
+        }
+    }
+}
+
 #if CONFIG_MM_BACKTRACE >= 0
 static inline void mempool_add_backtrace(FAR struct mempool_s *pool,
                                          FAR struct mempool_backtrace_s *buf)
@@ -658,3 +688,112 @@ int mempool_deinit(FAR struct mempool_s *pool)
 
   return 0;
 }
+
+/****************************************************************************
+ * Name: mempool_reclaim
+ *
+ * Description:
+ *   Return the expansion chunks of the pool whose blocks are all free to
+ *   the allocator.  The free blocks of a chunk are counted on the free
+ *   queue.  The lock is only held for one chunk at a time, so interrupts
+ *   stay disabled for one pass over the free queue, but a full reclaim
+ *   costs the number of chunks times the number of free blocks: call it
+ *   lazily, not on every release.
+ *
+ * Input Parameters:
+ *   pool    - Address of the memory pool to be used.
+ *
+ * Returned Value:
+ *   The number of bytes released.
+ ****************************************************************************/
+
+size_t mempool_reclaim(FAR struct mempool_s *pool)
+{
+  size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
+  FAR sq_entry_t *prev;
+  FAR sq_entry_t *chunk;
+  FAR sq_entry_t *blk;
+  FAR char *base;
+  irqstate_t flags;
+  size_t chunksize;
+  size_t nexpand;
+  size_t index;
+  size_t nfree;
+  size_t size = 0;
+  size_t i;
+
+  if (pool->expandsize < blocksize + sizeof(sq_entry_t))
+    {
+      return 0;
+    }
+
+  nexpand   = (pool->expandsize - sizeof(sq_entry_t)) / blocksize;
+  chunksize = nexpand * blocksize;
+
+  /* Keep the initial allocation, which stays at the head of equeue */
+
+  index = pool->initialsize >= blocksize + sizeof(sq_entry_t) ? 1 : 0;
+
+  for (; ; )
+    {
+      flags = spin_lock_irqsave(&pool->lock);
+
+      /* Look the chunk up again, equeue may have changed while the lock
+       * was dropped.
+       */
+
+      prev  = NULL;
+      chunk = sq_peek(&pool->equeue);
+      for (i = 0; chunk != NULL && i < index; i++)
+        {
+          prev  = chunk;
+          chunk = sq_next(chunk);
+        }
+
+      if (chunk == NULL)
+        {
+          spin_unlock_irqrestore(&pool->lock, flags);
+          break;
+        }
+
+      base  = (FAR char *)chunk - chunksize;
+      nfree = 0;
+
+      sq_for_every(&pool->queue, blk)
+        {
+          if ((FAR char *)blk >= base && (FAR char *)blk < (FAR char *)chunk)
+            {
+              nfree++;
+            }
+        }
+
+      if (nfree < nexpand)
+        {
+          spin_unlock_irqrestore(&pool->lock, flags);
+          index++;
+          continue;
+        }
+
+      /* Every block of the chunk is free: take them off the free queue
+       * and the chunk off equeue.  The next chunk takes its index.
+       */
+
+      mempool_remove_range(&pool->queue, base, (FAR char *)chunk);
+      if (prev == NULL)
+        {
+          sq_remfirst(&pool->equeue);
+        }
+      else
+        {
+          sq_remafter(prev, &pool->equeue);
+        }
+
+      spin_unlock_irqrestore(&pool->lock, flags);
+
+      base = kasan_unpoison(base, chunksize + sizeof(sq_entry_t));
+      pool->free(pool, base);
+      size += chunksize + sizeof(sq_entry_t);
+    }
+
+  return size;
+}
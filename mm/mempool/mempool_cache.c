@@ -0,0 +1,306 @@
+/****************************************************************************
+ * mm/mempool/mempool_cache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/sched.h>
+#include <nuttx/wqueue.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if defined(CONFIG_MM_MEMPOOL_CACHE_RECLAIM_DELAY) && \
+    CONFIG_MM_MEMPOOL_CACHE_RECLAIM_DELAY > 0
+#  define MEMPOOL_CACHE_RECLAIM
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static FAR void *mempool_cache_alloc_callback(FAR struct mempool_s *pool,
+                                              size_t size)
+{
+  return kmm_memalign(MEMPOOL_ALIGN, size);
+}
+
+static void mempool_cache_free_callback(FAR struct mempool_s *pool,
+                                        FAR void *addr)
+{
+  kmm_free(addr);
+}
+
+static void mempool_cache_check(FAR struct mempool_s *pool, FAR void *blk)
+{
+}
+
+/****************************************************************************
+ * Name: mempool_cache_reclaim_worker
+ *
+ * Description:
+ *   Return the idle expansion chunks of the pool some time after objects
+ *   were released to it.  The magazines are left alone, so a burst of
+ *   frees does not undo them.
+ *
+ ****************************************************************************/
+
+#ifdef MEMPOOL_CACHE_RECLAIM
+static void mempool_cache_reclaim_worker(FAR void *arg)
+{
+  FAR struct mempool_cache_s *cache = arg;
+
+  mempool_reclaim(&cache->pool);
+}
+#endif
+
+/****************************************************************************
+ * Name: mempool_cache_drain
+ *
+ * Description:
+ *   Return the objects of all magazines to the pool.
+ *
+ ****************************************************************************/
+
+static void mempool_cache_drain(FAR struct mempool_cache_s *cache)
+{
+  FAR struct mempool_magazine_s *mag;
+  irqstate_t flags;
+  int i;
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      mag = &cache->mag[i];
+      flags = spin_lock_irqsave(&mag->lock);
+      while (mag->count > 0)
+        {
+          mempool_release(&cache->pool, mag->objs[--mag->count]);
+        }
+
+      spin_unlock_irqrestore(&mag->lock, flags);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_cache_init
+ *
+ * Description:
+ *   Initialize an object cache.  Every CPU keeps up to
+ *   CONFIG_MM_MEMPOOL_CACHE_MAGAZINE freed objects in a magazine and
+ *   allocates from it first, so that the pool lock is only taken when the
+ *   magazine is empty or full.
+ *
+ * Input Parameters:
+ *   cache   - Address of the object cache to be used.
+ *   name    - The name of the object cache.
+ *   size    - The size of an object.
+ *   nexpand - The number of objects the pool is expanded by at a time.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+int mempool_cache_init(FAR struct mempool_cache_s *cache,
+                       FAR const char *name, size_t size, size_t nexpand)
+{
+  FAR struct mempool_s *pool = &cache->pool;
+  int i;
+
+  DEBUGASSERT(size > 0 && nexpand > 0);
+
+  pool->blocksize     = ALIGN_UP(size, MEMPOOL_ALIGN);
+  pool->initialsize   = 0;
+  pool->interruptsize = 0;
+  pool->expandsize    = nexpand * MEMPOOL_REALBLOCKSIZE(pool) +
+                        sizeof(sq_entry_t);
+  pool->wait          = false;
+  pool->check         = mempool_cache_check;
+  if (pool->alloc == NULL)
+    {
+      pool->alloc = mempool_cache_alloc_callback;
+      pool->free  = mempool_cache_free_callback;
+    }
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      spin_initialize(&cache->mag[i].lock, SP_UNLOCKED);
+      cache->mag[i].count = 0;
+    }
+
+#ifdef MEMPOOL_CACHE_RECLAIM
+  memset(&cache->work, 0, sizeof(cache->work));
+#endif
+
+  return mempool_init(pool, name);
+}
+
+/****************************************************************************
+ * Name: mempool_cache_alloc
+ *
+ * Description:
+ *   Allocate an object from the cache.  The constructor only runs on
+ *   objects taken from the pool, so objects must be freed in a state the
+ *   constructor would produce.
+ *
+ * Input Parameters:
+ *   cache - Address of the object cache to be used.
+ *
+ * Returned Value:
+ *   The pointer to the allocated object on success; NULL on any failure.
+ *
+ ****************************************************************************/
+
+FAR void *mempool_cache_alloc(FAR struct mempool_cache_s *cache)
+{
+  FAR struct mempool_magazine_s *mag = &cache->mag[this_cpu()];
+  FAR void *obj = NULL;
+  irqstate_t flags;
+
+  /* The task may migrate before the lock is taken, which only costs
+   * locality: the magazine is still protected by its own lock.
+   */
+
+  flags = spin_lock_irqsave(&mag->lock);
+  if (mag->count > 0)
+    {
+      obj = mag->objs[--mag->count];
+    }
+
+  spin_unlock_irqrestore(&mag->lock, flags);
+
+  if (obj == NULL)
+    {
+      obj = mempool_allocate(&cache->pool);
+      if (obj != NULL && cache->ctor != NULL)
+        {
+          cache->ctor(obj, cache->arg);
+        }
+    }
+
+  return obj;
+}
+
+/****************************************************************************
+ * Name: mempool_cache_free
+ *
+ * Description:
+ *   Free an object to the cache.
+ *
+ * Input Parameters:
+ *   cache - Address of the object cache to be used.
+ *   obj   - The pointer of the object.
+ *
+ ****************************************************************************/
+
+void mempool_cache_free(FAR struct mempool_cache_s *cache, FAR void *obj)
+{
+  FAR struct mempool_magazine_s *mag = &cache->mag[this_cpu()];
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&mag->lock);
+  if (mag->count < CONFIG_MM_MEMPOOL_CACHE_MAGAZINE)
+    {
+      mag->objs[mag->count++] = obj;
+      obj = NULL;
+    }
+
+  spin_unlock_irqrestore(&mag->lock, flags);
+
+  if (obj != NULL)
+    {
+      mempool_release(&cache->pool, obj);
+
+#ifdef MEMPOOL_CACHE_RECLAIM
+      /* The magazine overflowed, the load is going down: give the idle
+       * chunks back once it has settled.
+       */
+
+      if (work_available(&cache->work))
+        {
+          work_queue(LPWORK, &cache->work, mempool_cache_reclaim_worker,
+                     cache,
+                     MSEC2TICK(CONFIG_MM_MEMPOOL_CACHE_RECLAIM_DELAY));
+        }
+#endif
+    }
+}
+
+/****************************************************************************
+ * Name: mempool_cache_reclaim
+ *
+ * Description:
+ *   Return the objects of all magazines to the pool, then the memory of
+ *   the pool to the allocator if no object is in use.
+ *
+ * Input Parameters:
+ *   cache - Address of the object cache to be used.
+ *
+ * Returned Value:
+ *   The number of bytes released.
+ *
+ ****************************************************************************/
+
+size_t mempool_cache_reclaim(FAR struct mempool_cache_s *cache)
+{
+  mempool_cache_drain(cache);
+  return mempool_reclaim(&cache->pool);
+}
+
+/****************************************************************************
+ * Name: mempool_cache_deinit
+ *
+ * Description:
+ *   Deallocate an object cache.
+ *
+ * Input Parameters:
+ *   cache - Address of the object cache to be used.
+ *
+ * Returned Value:
+ *   Zero on success; -EBUSY if objects are still in use.
+ *
+ ****************************************************************************/
+
+int mempool_cache_deinit(FAR struct mempool_cache_s *cache)
+{
+#ifdef MEMPOOL_CACHE_RECLAIM
+  work_cancel_sync(LPWORK, &cache->work);
+#endif
+
+  mempool_cache_drain(cache);
+  return mempool_deinit(&cache->pool);
+}
@@ -30,6 +30,7 @@
 #include <debug.h>
 
 #include <nuttx/mm/gran.h>
+#include <nuttx/nuttx.h>
 
 #include "mm_gran/mm_gran.h"
 #include "mm_gran/mm_grantable.h"
@@ -81,4 +82,43 @@ FAR void *gran_alloc(GRAN_HANDLE handle, size_t size)
   return (FAR void *)retp;
 }
 
+FAR void *gran_alloc_align(GRAN_HANDLE handle, size_t size, size_t align)
+{
+  FAR gran_t *gran = (FAR gran_t *)handle;
+  uintptr_t start;
+  uintptr_t aligned;
+  uintptr_t end;
+  size_t gransize;
+
+  DEBUGASSERT(gran && (align & (align - 1)) == 0);
+  gransize = (size_t)1 << gran->log2gran;
+  if (align <= gransize)
+    {
+      return gran_alloc(handle, size);
+    }
+
+  /* Over-allocate by the alignment, then trim the head and the tail */
+
+  size  = NGRANULE(gran, size) << gran->log2gran;
+  start = (uintptr_t)gran_alloc(handle, size + align - gransize);
+  if (start == 0)
+    {
+      return NULL;
+    }
+
+  end     = start + size + align - gransize;
+  aligned = ALIGN_UP(start, align);
+  if (aligned > start)
+    {
+      gran_free(handle, (FAR void *)start, aligned - start);
+    }
+
+  if (aligned + size < end)
+    {
+      gran_free(handle, (FAR void *)(aligned + size), end - aligned - size);
+    }
+
+  return (FAR void *)aligned;
+}
+
 #endif /* CONFIG_GRAN */
@@ -28,6 +28,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdint.h>
 #include <strings.h>
 #include <debug.h>
 
@@ -94,6 +95,8 @@ uint32_t lsb_mask(uint32_t n)
 
 static void cell_set(gran_t *gran, uint32_t cell, uint32_t mask, bool val)
 {
+  uint32_t *gats = GATS(gran);
+
   if (val)
     {
       gran->gat[cell] |= mask;
@@ -102,6 +105,17 @@ static void cell_set(gran_t *gran, uint32_t cell, uint32_t mask, bool val)
     {
       gran->gat[cell] &= ~mask;
     }
+
+  /* keep the summary of full cells in sync */
+
+  if (gran->gat[cell] == GATCFULL)
+    {
+      gats[cell >> 5] |= BIT(cell & 31);
+    }
+  else
+    {
+      gats[cell >> 5] &= ~BIT(cell & 31);
+    }
 }
 
 /* set or clear a range of GAT bits */
@@ -237,28 +251,115 @@ failure:
   return false;
 }
 
-/* returns granule number of free range or negative error */
+/* returns granule number of free range or negative error
+ *
+ * The GAT is scanned a cell at a time.  Cells that are fully used are
+ * skipped with the summary bitmap, free runs spanning cells are tracked
+ * from the leading and trailing free bits of each cell, and runs inside a
+ * cell are found by folding the free bits with shifts.  The lowest fitting
+ * position is returned, as with a granule by granule search.
+ */
 
 int gran_search(const gran_t *gran, size_t size)
 {
-  int ret = -EINVAL;
-
-  if (gran == NULL || gran->ngranules < size)
+  const uint32_t *gats;
+  uint32_t ncells;
+  uint32_t c;        /* cell index */
+  uint32_t v;        /* cell value */
+  uint32_t m;        /* free bits starting a fitting run */
+  uint32_t k;        /* run length covered by m */
+  uint32_t s;        /* summary bits of cells not fully used */
+  size_t   base;     /* granule number of cell bit 0 */
+  size_t   start;    /* start of the current free run */
+  size_t   posi = SIZE_MAX;
+
+  if (gran == NULL || size == 0 || gran->ngranules < size)
     {
-      return ret;
+      return -EINVAL;
     }
 
-  ret = -ENOMEM;
-  for (size_t i = 0; i <= gran->ngranules - size; i++)
+  gats   = GATS(gran);
+  ncells = SIZEOF_GAT(gran->ngranules);
+  start  = 0;
+
+  for (c = 0; c < ncells; c++)
     {
-      if (gran_match(gran, i, size, 0, &i))
+      /* skip the fully used cells */
+
+      s = ~gats[c >> 5] >> (c & 31);
+      if (s == 0)
+        {
+          c    |= 31;
+          start = (size_t)(c + 1) * 32;
+          continue;
+        }
+      else if ((s & 1) == 0)
+        {
+          c    += ffs(s) - 1;
+          start = (size_t)c * 32;
+          if (c >= ncells)
+            {
+              break;
+            }
+        }
+
+      v    = gran->gat[c];
+      base = (size_t)c * 32;
+
+      /* the free run continuing from the previous cells */
+
+      if (v == 0)
         {
-          ret = i;
+          if (base + 32 - start >= size)
+            {
+              posi = start;
+              break;
+            }
+
+          continue;
+        }
+
+      if (base + ffs(v) - 1 - start >= size)
+        {
+          posi = start;
           break;
         }
+
+      /* free runs within the cell */
+
+      if (size < 32)
+        {
+          m = ~v;
+          for (k = 1; k * 2 <= size; k *= 2)
+            {
+              m &= m >> k;
+            }
+
+          if (k < size)
+            {
+              m &= m >> (size - k);
+            }
+
+          if (m != 0)
+            {
+              posi = base + ffs(m) - 1;
+              break;
+            }
+        }
+
+      /* the free run continuing into the next cells */
+
+      start = base + fls(v);
     }
 
-  return ret;
+  /* the unused bits of the last cell are clear, don't return them */
+
+  if (posi > gran->ngranules - size)
+    {
+      return -ENOMEM;
+    }
+
+  return posi;
 }
 
 /* set a range of granules */
@@ -59,6 +59,10 @@
 
 #define GATC_BITS(g)        (sizeof(g->gat[0]) << 3)
 
+/* Summary of the GAT, one bit per GAT cell that is fully used */
+
+#define GATS(g)             (&(g)->gat[SIZEOF_GAT((g)->ngranules)])
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
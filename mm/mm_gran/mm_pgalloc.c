@@ -150,6 +150,34 @@ uintptr_t mm_pgalloc(unsigned int npages)
   return (uintptr_t)gran_alloc(g_pgalloc, (size_t)npages << MM_PGSHIFT);
 }
 
+/****************************************************************************
+ * Name: mm_pgalloc_large
+ *
+ * Description:
+ *   Allocate physically contiguous page memory from the page memory pool.
+ *   If the allocation spans at least one large page, it is aligned to
+ *   MM_LGPGSIZE.  The pages may be freed one at a time with mm_pgfree().
+ *
+ * Input Parameters:
+ *   npages - The number of pages to allocate, each of size CONFIG_MM_PGSIZE.
+ *
+ * Returned Value:
+ *   On success, a non-zero, physical address of the allocated page memory
+ *   is returned.  Zero is returned if there is no such contiguous memory.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_PGALLOC_LARGEPAGE
+uintptr_t mm_pgalloc_large(unsigned int npages)
+{
+  size_t size = (size_t)npages << MM_PGSHIFT;
+
+  return (uintptr_t)gran_alloc_align(g_pgalloc, size,
+                                     size < MM_LGPGSIZE ? MM_PGSIZE :
+                                     MM_LGPGSIZE);
+}
+#endif
+
 /****************************************************************************
  * Name: mm_pgfree
  *
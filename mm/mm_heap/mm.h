@@ -112,7 +112,19 @@
 
 #define MM_MIN_CHUNK     (1 << MM_MIN_SHIFT)
 #define MM_MAX_CHUNK     (1 << MM_MAX_SHIFT)
-#define MM_NNODES        (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
+
+/* Each power of two of the chunk size is split into MM_NSUBBINS free
+ * lists of equal width; chunks of MM_MAX_CHUNK or more share the last one.
+ */
+
+#define MM_SUBBIN_SHIFT  CONFIG_MM_HEAP_SUBBIN_SHIFT
+#define MM_NSUBBINS      (1 << MM_SUBBIN_SHIFT)
+#define MM_NNODES        ((MM_MAX_SHIFT - MM_MIN_SHIFT) * MM_NSUBBINS + 1)
+
+/* One bit per free list, set while the list is not empty */
+
+#define MM_MAP_BITS      (8 * sizeof(unsigned long))
+#define MM_NMAPS         ((MM_NNODES + MM_MAP_BITS - 1) / MM_MAP_BITS)
 
 #if CONFIG_MM_DEFAULT_ALIGNMENT == 0
 #  define MM_ALIGN       (2 * sizeof(uintptr_t))
@@ -252,6 +264,7 @@ struct mm_heap_s
    */
 
   struct mm_freenode_s mm_nodelist[MM_NNODES];
+  unsigned long mm_nodemap[MM_NMAPS];
 
   /* Free delay list, as sometimes we can't do free immdiately. */
 
@@ -307,14 +320,22 @@ void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay);
 
 static inline_function int mm_size2ndx(size_t size)
 {
+  int ndx;
+
   DEBUGASSERT(size >= MM_MIN_CHUNK);
   if (size >= MM_MAX_CHUNK)
     {
       return MM_NNODES - 1;
     }
 
-  size >>= MM_MIN_SHIFT;
-  return flsl(size) - 1;
+  /* The power of two selects the group of lists, the next MM_SUBBIN_SHIFT
+   * bits below the leading one select the list within the group.
+   */
+
+  ndx = flsl(size >> MM_MIN_SHIFT) - 1;
+  return (ndx << MM_SUBBIN_SHIFT) +
+         ((size >> (MM_MIN_SHIFT + ndx - MM_SUBBIN_SHIFT)) &
+          (MM_NSUBBINS - 1));
 }
 
 static inline_function void mm_addfreechunk(FAR struct mm_heap_s *heap,
@@ -351,6 +372,35 @@ static inline_function void mm_addfreechunk(FAR struct mm_heap_s *heap,
 
       next->blink = node;
     }
+
+  heap->mm_nodemap[ndx / MM_MAP_BITS] |= 1ul << (ndx % MM_MAP_BITS);
+}
+
+static inline_function void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                                            FAR struct mm_freenode_s *node)
+{
+  int ndx = mm_size2ndx(MM_SIZEOF_NODE(node));
+
+  /* Remove the node.  There must be a predecessor, but there may not be a
+   * successor node.
+   */
+
+  DEBUGASSERT(node->blink);
+  node->blink->flink = node->flink;
+  if (node->flink)
+    {
+      node->flink->blink = node->blink;
+    }
+
+  /* The list is empty if the node was between its head and the head of
+   * the next list.
+   */
+
+  if (node->blink == &heap->mm_nodelist[ndx] &&
+      (node->flink == NULL || node->flink->size == 0))
+    {
+      heap->mm_nodemap[ndx / MM_MAP_BITS] &= ~(1ul << (ndx % MM_MAP_BITS));
+    }
 }
 
 #endif /* __MM_MM_HEAP_MM_H */
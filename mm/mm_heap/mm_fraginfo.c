@@ -0,0 +1,210 @@
+/****************************************************************************
+ * mm/mm_heap/mm_fraginfo.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <string.h>
+#include <strings.h>
+
+#include <nuttx/mm/mm.h>
+
+#include "mm_heap/mm.h"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct mm_fraginfo_priv_s
+{
+  FAR struct mm_heap_s *heap;
+  FAR struct mm_fraginfo_s *info;
+  int region;
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int fraginfo_class(size_t size)
+{
+  int class = flsl(size) - 1;
+
+  return class < MM_FRAG_NCLASSES ? class : MM_FRAG_NCLASSES - 1;
+}
+
+#if CONFIG_MM_BACKTRACE > 0
+/****************************************************************************
+ * Name: fraginfo_site
+ *
+ * Description:
+ *   Account an allocated block to its allocation site.  The sites are kept
+ *   in an open addressing hash table provided by the caller.
+ *
+ ****************************************************************************/
+
+static void fraginfo_site(FAR struct mm_fraginfo_s *info,
+                          FAR struct mm_allocnode_s *node, size_t nodesize,
+                          bool pinning)
+{
+  FAR struct mm_fragsite_s *entry;
+  FAR void *site = node->backtrace[0];
+  size_t index;
+  size_t i;
+
+  if (info->nsites == 0)
+    {
+      return;
+    }
+
+  index = ((uintptr_t)site >> 2) % info->nsites;
+  for (i = 0; i < info->nsites; i++)
+    {
+      entry = &info->sites[index];
+      if (entry->nblocks == 0)
+        {
+          entry->site   = site;
+          entry->seqmin = node->seqno;
+        }
+      else if (entry->site != site)
+        {
+          if (++index == info->nsites)
+            {
+              index = 0;
+            }
+
+          continue;
+        }
+
+      entry->nblocks++;
+      entry->size += nodesize;
+      if (pinning)
+        {
+          entry->npinning++;
+        }
+
+      if (node->seqno < entry->seqmin)
+        {
+          entry->seqmin = node->seqno;
+        }
+
+      return;
+    }
+
+  info->nlost++;
+}
+#endif
+
+static void fraginfo_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
+{
+  FAR struct mm_fraginfo_priv_s *priv = arg;
+  FAR struct mm_fraginfo_s *info = priv->info;
+  size_t nodesize = MM_SIZEOF_NODE(node);
+  int class;
+
+  /* The node at the end of a region closes the region */
+
+  if (node == priv->heap->mm_heapend[priv->region])
+    {
+      info->nregions = ++priv->region;
+      return;
+    }
+
+  class = fraginfo_class(nodesize);
+  if (MM_NODE_IS_ALLOC(node))
+    {
+      info->nused[class]++;
+      info->used[class] += nodesize;
+
+#if CONFIG_MM_BACKTRACE > 0
+      if (node->pid != PID_MM_MEMPOOL)
+        {
+          FAR struct mm_allocnode_s *next = (FAR struct mm_allocnode_s *)
+                                            ((FAR char *)node + nodesize);
+
+          fraginfo_site(info, node, nodesize,
+                        MM_PREVNODE_IS_FREE(node) || MM_NODE_IS_FREE(next));
+        }
+#endif
+    }
+  else
+    {
+      info->nfree[class]++;
+      info->free[class] += nodesize;
+      if (nodesize > info->mxfree[priv->region])
+        {
+          info->mxfree[priv->region] = nodesize;
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_fraginfo
+ *
+ * Description:
+ *   Report how the free memory of the heap is fragmented: the free and
+ *   allocated blocks of each size class and the largest free block of each
+ *   region.  With CONFIG_MM_BACKTRACE > 0 the allocated blocks are also
+ *   grouped by allocation site into info->sites, counting the blocks next
+ *   to a free block: these keep the free block from growing.
+ *
+ * Input Parameters:
+ *   heap - The heap to be reported
+ *   info - The report.  info->sites and info->nsites are set by the
+ *          caller, all other fields are set here.
+ *
+ ****************************************************************************/
+
+void mm_fraginfo(FAR struct mm_heap_s *heap, FAR struct mm_fraginfo_s *info)
+{
+  struct mm_fraginfo_priv_s priv;
+
+  DEBUGASSERT(info != NULL);
+
+  memset(info->nfree, 0, sizeof(info->nfree));
+  memset(info->free, 0, sizeof(info->free));
+  memset(info->nused, 0, sizeof(info->nused));
+  memset(info->used, 0, sizeof(info->used));
+  memset(info->mxfree, 0, sizeof(info->mxfree));
+  info->nregions = 0;
+#if CONFIG_MM_BACKTRACE > 0
+  if (info->nsites > 0)
+    {
+      memset(info->sites, 0, info->nsites * sizeof(struct mm_fragsite_s));
+    }
+
+  info->nlost = 0;
+#endif
+
+  priv.heap   = heap;
+  priv.info   = info;
+  priv.region = 0;
+  mm_foreach(heap, fraginfo_handler, &priv);
+}
@@ -29,8 +29,10 @@
 #include <assert.h>
 #include <debug.h>
 #include <string.h>
+#include <strings.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/nuttx.h>
 #include <nuttx/mm/mm.h>
 #include <nuttx/mm/kasan.h>
 #include <nuttx/sched.h>
@@ -109,6 +111,39 @@ static bool free_delaylist(FAR struct mm_heap_s *heap, bool force)
   return ret;
 }
 
+/****************************************************************************
+ * Name: mm_nextndx
+ *
+ * Description:
+ *  Return the index of the first non-empty free list at or after ndx, or
+ *  MM_NNODES if there is none.
+ *
+ ****************************************************************************/
+
+static inline_function int mm_nextndx(FAR struct mm_heap_s *heap, int ndx)
+{
+  unsigned long map;
+  int i = ndx / MM_MAP_BITS;
+
+  if (ndx >= MM_NNODES)
+    {
+      return MM_NNODES;
+    }
+
+  map = heap->mm_nodemap[i] & (~0ul << (ndx % MM_MAP_BITS));
+  while (map == 0)
+    {
+      if (++i >= MM_NMAPS)
+        {
+          return MM_NNODES;
+        }
+
+      map = heap->mm_nodemap[i];
+    }
+
+  return i * MM_MAP_BITS + ffsl(map) - 1;
+}
+
 #if CONFIG_MM_BACKTRACE >= 0
 void mm_dump_handler(FAR struct tcb_s *tcb, FAR void *arg)
 {
@@ -190,6 +225,20 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
     }
 #endif
 
+#if CONFIG_MM_HEAP_CACHELINE_SIZE > 0
+  /* Give small allocations whole cache lines, so that objects used by
+   * different CPUs do not share a line.  The chunk mm_memalign() takes
+   * from mm_malloc() is larger than two lines, so this does not recurse.
+   */
+
+  if (CONFIG_MM_HEAP_CACHELINE_SIZE > MM_ALIGN &&
+      size <= 2 * CONFIG_MM_HEAP_CACHELINE_SIZE)
+    {
+      return mm_memalign(heap, CONFIG_MM_HEAP_CACHELINE_SIZE,
+                         ALIGN_UP(size, CONFIG_MM_HEAP_CACHELINE_SIZE));
+    }
+#endif
+
   /* Adjust the size to account for (1) the size of the allocated node and
    * (2) to make sure that it is aligned with MM_ALIGN and its size is at
    * least MM_MIN_CHUNK.
@@ -218,12 +267,13 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
   ndx = mm_size2ndx(alignsize);
 
-  /* Search for a large enough chunk in the list of nodes. This list is
-   * ordered by size, but will have occasional zero sized nodes as we visit
-   * other mm_nodelist[] entries.
+  /* Search for a large enough chunk in the list of the request size.  This
+   * list is ordered by size and ends at the zero sized head of the next
+   * list.
    */
 
-  for (node = heap->mm_nodelist[ndx].flink; node; node = node->flink)
+  for (node = heap->mm_nodelist[ndx].flink; node && node->size;
+       node = node->flink)
     {
       DEBUGASSERT(node->blink->flink == node);
       nodesize = MM_SIZEOF_NODE(node);
@@ -233,9 +283,22 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
         }
     }
 
-  /* If we found a node with non-zero size, then this is one to use. Since
-   * the list is ordered, we know that it must be the best fitting chunk
-   * available.
+  /* Otherwise every chunk in the next non-empty list is large enough, and
+   * the first one is the smallest.
+   */
+
+  if (node == NULL || node->size == 0)
+    {
+      ndx  = mm_nextndx(heap, ndx + 1);
+      node = ndx < MM_NNODES ? heap->mm_nodelist[ndx].flink : NULL;
+      if (node)
+        {
+          nodesize = MM_SIZEOF_NODE(node);
+        }
+    }
+
+  /* If we found a node, then this is one to use.  Since the lists are
+   * ordered, we know that it must be the best fitting chunk available.
    */
 
   if (node)
@@ -249,11 +312,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
        */
 
       DEBUGASSERT(node->blink);
-      node->blink->flink = node->flink;
-      if (node->flink)
-        {
-          node->flink->blink = node->blink;
-        }
+      mm_delfreechunk(heap, node);
 
       /* Get a pointer to the next node in physical memory */
 
@@ -154,6 +154,7 @@ static int shm_reserve(key_t key, int shmflg)
  *   shmid - The index of the region of interest in the shared memory region
  *     table.
  *   size - The new size of the region.
+ *   shmflg - SHM_HUGETLB to try physically contiguous large pages first.
  *
  * Returned Value:
  *   Zero is returned on success; -ENOMEM is returned on failure.
@@ -161,7 +162,7 @@ static int shm_reserve(key_t key, int shmflg)
  *
  ****************************************************************************/
 
-static int shm_extend(int shmid, size_t size)
+static int shm_extend(int shmid, size_t size, int shmflg)
 {
   FAR struct shm_region_s *region = &g_shminfo.si_region[shmid];
   unsigned int pgalloc;
@@ -175,6 +176,32 @@ static int shm_extend(int shmid, size_t size)
 
   pgalloc = MM_NPAGES(region->sr_ds.shm_segsz);
 
+#ifdef CONFIG_MM_PGALLOC_LARGEPAGE
+  /* Try to allocate all missing pages in one contiguous run; on failure,
+   * fall back to separate pages below.
+   */
+
+  if ((shmflg & SHM_HUGETLB) != 0 && pgalloc < pgneeded &&
+      pgneeded <= CONFIG_ARCH_SHM_NPAGES)
+    {
+      uintptr_t paddr = mm_pgalloc_large(pgneeded - pgalloc);
+
+      if (paddr != 0)
+        {
+          memset((FAR void *)paddr, 0,
+                 (size_t)(pgneeded - pgalloc) << MM_PGSHIFT);
+          for (; pgalloc < pgneeded; pgalloc++, paddr += MM_PGSIZE)
+            {
+              region->sr_pages[pgalloc] = paddr;
+            }
+        }
+      else
+        {
+          shminfo("No large pages, falling back to pages\n");
+        }
+    }
+#endif
+
   /* Loop until all pages have been allocated (or something bad happens) */
 
   while (pgalloc < pgneeded && pgalloc < CONFIG_ARCH_SHM_NPAGES)
@@ -261,7 +288,7 @@ static int shm_create(key_t key, size_t size, int shmflg)
    * size of zero).
    */
 
-  ret = shm_extend(shmid, size);
+  ret = shm_extend(shmid, size, shmflg);
   if (ret < 0)
     {
       /* Free any partial allocations and unreserve the region */
@@ -318,7 +345,9 @@ static int shm_create(key_t key, size_t size, int shmflg)
  *   size    - The shared memory region that is created will be at least
  *             this size in bytes.
  *   shmflgs - See IPC_* definitions in sys/ipc.h.  Only the values
- *             IPC_PRIVATE or IPC_CREAT are supported.
+ *             IPC_PRIVATE or IPC_CREAT are supported.  SHM_HUGETLB asks
+ *             for physically contiguous large pages if
+ *             CONFIG_MM_PGALLOC_LARGEPAGE is enabled.
  *
  * Returned Value:
  *   Upon successful completion, shmget() will return a non-negative
@@ -443,7 +472,7 @@ int shmget(key_t key, size_t size, int shmflg)
             {
               /* Extend the region */
 
-              ret = shm_extend(shmid, size);
+              ret = shm_extend(shmid, size, shmflg);
               if (ret < 0)
                 {
                   shmerr("ERROR: shm_create failed: %d\n", ret);
@@ -34,6 +34,7 @@
 #include <sched.h>
 #include <stdio.h>
 #include <string.h>
+#include <strings.h>
 #include <sys/param.h>
 
 #include <nuttx/arch.h>
@@ -149,6 +150,18 @@ struct mm_memdump_priv_s
 #endif
 };
 
+struct mm_fraginfo_priv_s
+{
+  FAR struct mm_fraginfo_s *info;
+  int current;                            /* The region being walked */
+  bool prevfree;                          /* The previous block is free */
+#if CONFIG_MM_BACKTRACE > 0
+  FAR struct memdump_backtrace_s *buf;    /* The previous allocated block */
+  size_t size;
+  bool pinning;
+#endif
+};
+
 #ifdef CONFIG_MM_HEAP_MEMPOOL
 static inline_function
 void memdump_info_pool(FAR struct mm_memdump_priv_s *priv,
@@ -459,6 +472,140 @@ static void mallinfo_task_handler(FAR void *ptr, size_t size, int used,
     }
 }
 
+static int fraginfo_class(size_t size)
+{
+  int class = flsl(size) - 1;
+
+  return class < MM_FRAG_NCLASSES ? class : MM_FRAG_NCLASSES - 1;
+}
+
+#if CONFIG_MM_BACKTRACE > 0
+/****************************************************************************
+ * Name: fraginfo_site
+ *
+ * Description:
+ *   Account an allocated block to its allocation site.  The sites are kept
+ *   in an open addressing hash table provided by the caller.
+ *
+ ****************************************************************************/
+
+static void fraginfo_site(FAR struct mm_fraginfo_s *info,
+                          FAR struct memdump_backtrace_s *buf, size_t size,
+                          bool pinning)
+{
+  FAR struct mm_fragsite_s *entry;
+  FAR void *site = buf->backtrace[0];
+  size_t index;
+  size_t i;
+
+  if (info->nsites == 0)
+    {
+      return;
+    }
+
+  index = ((uintptr_t)site >> 2) % info->nsites;
+  for (i = 0; i < info->nsites; i++)
+    {
+      entry = &info->sites[index];
+      if (entry->nblocks == 0)
+        {
+          entry->site   = site;
+          entry->seqmin = buf->seqno;
+        }
+      else if (entry->site != site)
+        {
+          if (++index == info->nsites)
+            {
+              index = 0;
+            }
+
+          continue;
+        }
+
+      entry->nblocks++;
+      entry->size += size;
+      if (pinning)
+        {
+          entry->npinning++;
+        }
+
+      if (buf->seqno < entry->seqmin)
+        {
+          entry->seqmin = buf->seqno;
+        }
+
+      return;
+    }
+
+  info->nlost++;
+}
+
+/****************************************************************************
+ * Name: fraginfo_flush
+ *
+ * Description:
+ *   Account the previous allocated block, now that it is known whether the
+ *   block after it is free.
+ *
+ ****************************************************************************/
+
+static void fraginfo_flush(FAR struct mm_fraginfo_priv_s *priv,
+                           bool nextfree)
+{
+  if (priv->buf != NULL)
+    {
+      fraginfo_site(priv->info, priv->buf, priv->size,
+                    priv->pinning || nextfree);
+      priv->buf = NULL;
+    }
+}
+#else
+#  define fraginfo_flush(priv, nextfree)
+#endif
+
+/****************************************************************************
+ * Name: fraginfo_handler
+ ****************************************************************************/
+
+static void fraginfo_handler(FAR void *ptr, size_t size, int used,
+                             FAR void *user)
+{
+  FAR struct mm_fraginfo_priv_s *priv = user;
+  FAR struct mm_fraginfo_s *info = priv->info;
+  int class = fraginfo_class(size);
+
+  fraginfo_flush(priv, !used);
+
+  if (used)
+    {
+#if CONFIG_MM_BACKTRACE > 0
+      FAR struct memdump_backtrace_s *buf =
+        ptr + size - sizeof(struct memdump_backtrace_s);
+
+      if (buf->pid != PID_MM_MEMPOOL)
+        {
+          priv->buf     = buf;
+          priv->size    = size;
+          priv->pinning = priv->prevfree;
+        }
+#endif
+
+      info->nused[class]++;
+      info->used[class] += size;
+    }
+  else
+    {
+      info->nfree[class]++;
+      info->free[class] += size;
+      if (size > info->mxfree[priv->current])
+        {
+          info->mxfree[priv->current] = size;
+        }
+    }
+
+  priv->prevfree = !used;
+}
+
 /****************************************************************************
  * Name: mm_lock
  *
@@ -1157,6 +1304,66 @@ struct mallinfo_task mm_mallinfo_task(FAR struct mm_heap_s *heap,
   return info;
 }
 
+/****************************************************************************
+ * Name: mm_fraginfo
+ *
+ * Description:
+ *   Report how the free memory of the heap is fragmented: the free and
+ *   allocated blocks of each size class and the largest free block of each
+ *   region.  With CONFIG_MM_BACKTRACE > 0 the allocated blocks are also
+ *   grouped by allocation site into info->sites, counting the blocks next
+ *   to a free block: these keep the free block from growing.
+ *
+ ****************************************************************************/
+
+void mm_fraginfo(FAR struct mm_heap_s *heap, FAR struct mm_fraginfo_s *info)
+{
+  struct mm_fraginfo_priv_s priv;
+#if CONFIG_MM_REGIONS > 1
+  int region;
+#else
+#  define region 0
+#endif
+
+  memset(info->nfree, 0, sizeof(info->nfree));
+  memset(info->free, 0, sizeof(info->free));
+  memset(info->nused, 0, sizeof(info->nused));
+  memset(info->used, 0, sizeof(info->used));
+  memset(info->mxfree, 0, sizeof(info->mxfree));
+  info->nregions = 0;
+#if CONFIG_MM_BACKTRACE > 0
+  if (info->nsites > 0)
+    {
+      memset(info->sites, 0, info->nsites * sizeof(struct mm_fragsite_s));
+    }
+
+  info->nlost = 0;
+  priv.buf    = NULL;
+#endif
+
+  priv.info = info;
+
+  /* Visit each region */
+
+#if CONFIG_MM_REGIONS > 1
+  for (region = 0; region < heap->mm_nregions; region++)
+#endif
+    {
+      priv.current  = region;
+      priv.prevfree = false;
+
+      /* Retake the mutex for each region to reduce latencies */
+
+      DEBUGVERIFY(mm_lock(heap));
+      tlsf_walk_pool(heap->mm_heapstart[region], fraginfo_handler, &priv);
+      fraginfo_flush(&priv, false);
+      mm_unlock(heap);
+
+      info->nregions = region + 1;
+    }
+#undef region
+}
+
 /****************************************************************************
  * Name: mm_memdump
  *
@@ -0,0 +1,618 @@
+/****************************************************************************
+ * mm/umm_heap/umm_arena.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/atomic.h>
+#include <nuttx/irq.h>
+#include <nuttx/mm/mm.h>
+#include <nuttx/mutex.h>
+#include <nuttx/sched.h>
+#include <nuttx/tls.h>
+
+#include "umm_heap/umm_heap.h"
+
+#ifdef CONFIG_MM_UMM_ARENA
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_UMM_ARENA_TASK
+#  define ARENA_OWNER() _SCHED_GETPID()
+#else
+#  define ARENA_OWNER() _SCHED_GETTID()
+#endif
+
+/* Block count of an arena returned to the user heap.  Allocations that
+ * raced with the release see a count at or above it and keep off the heap.
+ */
+
+#define ARENA_DEAD    (~0ul >> 1)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct umm_arena_s
+{
+  FAR struct mm_heap_s *heap;  /* Heap in the arena, NULL if unused */
+  uintptr_t    start;          /* Memory of the arena, from the user heap */
+  uintptr_t    end;
+  pid_t        owner;          /* Thread or task using the arena, 0 if none */
+  atomic_ulong nblocks;        /* Number of blocks in use */
+  atomic_ulong remote;         /* Blocks freed by other threads */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct umm_arena_s g_umm_arenas[CONFIG_MM_UMM_NARENAS];
+
+/* Marks a thread or task that found no arena, so that it does not look
+ * for one again on every allocation.
+ */
+
+static struct umm_arena_s g_umm_noarena;
+
+/* Protects creating, adopting and releasing arenas */
+
+static mutex_t g_umm_arenalock = NXMUTEX_INITIALIZER;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: umm_arena_usable
+ *
+ * Description:
+ *   Arenas are used from application threads only.  Interrupt handlers and
+ *   context switches free to the owning arena's queue.  Kernel threads,
+ *   such as the work queue threads, live as long as the system and would
+ *   hold an arena forever.
+ *
+ ****************************************************************************/
+
+static bool umm_arena_usable(void)
+{
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+  return !up_interrupt_context() && _SCHED_GETTID() >= 0 &&
+         (nxsched_self()->flags & TCB_FLAG_TTYPE_MASK) !=
+         TCB_FLAG_TTYPE_KERNEL;
+#else
+  return true;
+#endif
+}
+
+/****************************************************************************
+ * Name: umm_arena_slot
+ *
+ * Description:
+ *   Return where the arena of the calling thread or task is kept.
+ *
+ ****************************************************************************/
+
+static FAR void **umm_arena_slot(void)
+{
+#ifdef CONFIG_MM_UMM_ARENA_TASK
+  FAR struct task_info_s *info = task_get_info();
+
+  return info != NULL ? &info->ta_arena : NULL;
+#else
+  return &tls_get_info()->tl_arena;
+#endif
+}
+
+/****************************************************************************
+ * Name: umm_arena_owned
+ *
+ * Description:
+ *   Return true if the arena belongs to the calling thread or task.
+ *
+ ****************************************************************************/
+
+static bool umm_arena_owned(FAR struct umm_arena_s *arena)
+{
+  FAR void **slot;
+
+  return umm_arena_usable() && (slot = umm_arena_slot()) != NULL &&
+         *slot == arena;
+}
+
+/****************************************************************************
+ * Name: umm_arena_orphaned
+ *
+ * Description:
+ *   Return true if the owner of the arena exited without releasing it,
+ *   for example because it was killed.  The caller holds g_umm_arenalock.
+ *
+ ****************************************************************************/
+
+static bool umm_arena_orphaned(FAR struct umm_arena_s *arena)
+{
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  bool orphaned;
+
+  /* The ID of the owner may have been reused by a thread that does not
+   * use the arena: check that the thread with that ID still has it.
+   */
+
+  flags = enter_critical_section();
+  tcb   = nxsched_get_tcb(arena->owner);
+#  ifdef CONFIG_MM_UMM_ARENA_TASK
+  orphaned = tcb == NULL || tcb->group == NULL ||
+             tcb->group->tg_info->ta_arena != arena;
+#  else
+  orphaned = tcb == NULL || tcb->stack_alloc_ptr == NULL ||
+             ((FAR struct tls_info_s *)tcb->stack_alloc_ptr)->tl_arena !=
+             arena;
+#  endif
+  leave_critical_section(flags);
+
+  return orphaned;
+#else
+  /* Other task groups cannot be inspected from here.  An arena whose
+   * owner ID was reused is adopted by umm_arena_create() when the new
+   * thread or task allocates, or collected once it exits.
+   */
+
+  return kill(arena->owner, 0) < 0 && errno == ESRCH;
+#endif
+}
+
+/****************************************************************************
+ * Name: umm_arena_find
+ ****************************************************************************/
+
+static FAR struct umm_arena_s *umm_arena_find(FAR void *mem)
+{
+  uintptr_t addr = (uintptr_t)mem;
+  int i;
+
+  /* A block in use keeps its arena alive, so no lock is needed */
+
+  for (i = 0; i < CONFIG_MM_UMM_NARENAS; i++)
+    {
+      FAR struct umm_arena_s *arena = &g_umm_arenas[i];
+
+      if (addr >= arena->start && addr < arena->end)
+        {
+          return arena;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: umm_arena_drain
+ *
+ * Description:
+ *   Free the blocks queued by other threads.
+ *
+ ****************************************************************************/
+
+static void umm_arena_drain(FAR struct umm_arena_s *arena)
+{
+  FAR void *mem = (FAR void *)atomic_exchange(&arena->remote, 0);
+
+  while (mem != NULL)
+    {
+      FAR void *next = *(FAR void **)mem;
+
+      mm_free(arena->heap, mem);
+      atomic_fetch_sub(&arena->nblocks, 1);
+      mem = next;
+    }
+}
+
+/****************************************************************************
+ * Name: umm_arena_collect
+ *
+ * Description:
+ *   Return an arena without owner to the user heap if no block in it is in
+ *   use.  The caller holds g_umm_arenalock.
+ *
+ ****************************************************************************/
+
+static void umm_arena_collect(FAR struct umm_arena_s *arena)
+{
+  FAR void *mem = (FAR void *)arena->start;
+  unsigned long nblocks = 0;
+
+  /* With CONFIG_MM_UMM_ARENA_TASK, other threads of the task may still be
+   * allocating from the arena.  They count the block before entering the
+   * heap, so the arena is only released if the count can be marked dead
+   * while it is zero.
+   */
+
+  umm_arena_drain(arena);
+  if (atomic_compare_exchange_strong(&arena->nblocks, &nblocks,
+                                     ARENA_DEAD))
+    {
+      arena->end   = 0;
+      arena->start = 0;
+      mm_uninitialize(arena->heap);
+      arena->heap  = NULL;
+      mm_free(USR_HEAP, mem);
+    }
+}
+
+/****************************************************************************
+ * Name: umm_arena_create
+ *
+ * Description:
+ *   Find an arena for the calling thread or task: adopt one whose owner
+ *   has exited or else carve a new one from the user heap.  The caller
+ *   holds g_umm_arenalock.
+ *
+ ****************************************************************************/
+
+static FAR struct umm_arena_s *umm_arena_create(void)
+{
+  FAR struct umm_arena_s *unused = NULL;
+  FAR void *mem;
+  int i;
+
+  for (i = 0; i < CONFIG_MM_UMM_NARENAS; i++)
+    {
+      FAR struct umm_arena_s *arena = &g_umm_arenas[i];
+
+      /* The caller has no arena yet, so an arena with its ID belongs to
+       * an exited thread or task whose ID was reused, or with
+       * CONFIG_MM_UMM_ARENA_TASK, to another thread of the same task.
+       * Either way it is the caller's arena.
+       */
+
+      if (arena->heap != NULL && arena->owner == ARENA_OWNER())
+        {
+          return arena;
+        }
+
+      /* The owner may have been killed without releasing its arena */
+
+      if (arena->heap != NULL && arena->owner != 0 &&
+          umm_arena_orphaned(arena))
+        {
+          arena->owner = 0;
+          umm_arena_collect(arena);
+        }
+
+      if (arena->heap != NULL && arena->owner == 0)
+        {
+          arena->owner = ARENA_OWNER();
+          return arena;
+        }
+      else if (arena->heap == NULL && unused == NULL)
+        {
+          unused = arena;
+        }
+    }
+
+  if (unused == NULL)
+    {
+      return &g_umm_noarena;
+    }
+
+  mem = mm_malloc(USR_HEAP, CONFIG_MM_UMM_ARENA_SIZE);
+  if (mem == NULL)
+    {
+      return &g_umm_noarena;
+    }
+
+  unused->heap    = mm_initialize("arena", mem, CONFIG_MM_UMM_ARENA_SIZE);
+  unused->owner   = ARENA_OWNER();
+  atomic_store(&unused->nblocks, 0);
+  atomic_store(&unused->remote, 0);
+
+  /* umm_arena_find() runs without the lock: never expose a range that
+   * starts at zero.
+   */
+
+  unused->start   = (uintptr_t)mem;
+  unused->end     = (uintptr_t)mem + CONFIG_MM_UMM_ARENA_SIZE;
+  return unused;
+}
+
+/****************************************************************************
+ * Name: umm_arena_get
+ *
+ * Description:
+ *   Return the arena of the calling thread or task, NULL if there is none.
+ *
+ ****************************************************************************/
+
+static FAR struct umm_arena_s *umm_arena_get(void)
+{
+  FAR struct umm_arena_s *arena;
+  FAR void **slot;
+
+  if (!umm_arena_usable() || (slot = umm_arena_slot()) == NULL)
+    {
+      return NULL;
+    }
+
+  arena = *slot;
+  if (arena == NULL)
+    {
+      /* The idle thread is a kernel thread and never gets here, so it
+       * never waits for the lock.
+       */
+
+      if (nxmutex_lock(&g_umm_arenalock) < 0)
+        {
+          return NULL;
+        }
+
+      /* Publish the arena before the lock is released, so that
+       * umm_arena_orphaned() never sees an owner without it.
+       */
+
+      arena = umm_arena_create();
+      *slot = arena;
+      nxmutex_unlock(&g_umm_arenalock);
+    }
+
+  return arena != &g_umm_noarena ? arena : NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+FAR void *umm_arena_memalign(size_t alignment, size_t size)
+{
+  FAR struct umm_arena_s *arena = umm_arena_get();
+  FAR void *mem;
+
+  /* Large blocks would use up the arena, leave them to the user heap */
+
+  if (arena == NULL || size >= CONFIG_MM_UMM_ARENA_SIZE / 2)
+    {
+      return NULL;
+    }
+
+  /* Count the block first: an arena with a block in flight is not
+   * released.  The count of a released arena stays dead until the arena
+   * is created again.
+   */
+
+  if (atomic_fetch_add(&arena->nblocks, 1) >= ARENA_DEAD)
+    {
+      return NULL;
+    }
+
+  if (atomic_load(&arena->remote) != 0)
+    {
+      umm_arena_drain(arena);
+    }
+
+  mem = alignment > 0 ? mm_memalign(arena->heap, alignment, size) :
+                        mm_malloc(arena->heap, size);
+  if (mem == NULL)
+    {
+      atomic_fetch_sub(&arena->nblocks, 1);
+    }
+
+  return mem;
+}
+
+bool umm_arena_free(FAR void *mem)
+{
+  FAR struct umm_arena_s *arena = umm_arena_find(mem);
+  unsigned long head;
+
+  if (arena == NULL)
+    {
+      return false;
+    }
+
+  if (umm_arena_owned(arena))
+    {
+      mm_free(arena->heap, mem);
+      atomic_fetch_sub(&arena->nblocks, 1);
+      return true;
+    }
+
+  /* Queue the block to the owner of the arena */
+
+  head = atomic_load(&arena->remote);
+  do
+    {
+      *(FAR unsigned long *)mem = head;
+    }
+  while (!atomic_compare_exchange_weak(&arena->remote, &head,
+                                       (unsigned long)mem));
+
+  /* Nobody else will free the blocks of an arena without owner */
+
+  if (arena->owner == 0 && umm_arena_usable() &&
+      nxmutex_trylock(&g_umm_arenalock) >= 0)
+    {
+      if (arena->owner == 0 && arena->heap != NULL)
+        {
+          umm_arena_collect(arena);
+        }
+
+      nxmutex_unlock(&g_umm_arenalock);
+    }
+
+  return true;
+}
+
+bool umm_arena_realloc(FAR void *oldmem, size_t size, FAR void **newmem)
+{
+  FAR struct umm_arena_s *arena = umm_arena_find(oldmem);
+  size_t oldsize;
+
+  if (arena == NULL)
+    {
+      return false;
+    }
+
+  if (size == 0)
+    {
+      umm_arena_free(oldmem);
+      *newmem = NULL;
+      return true;
+    }
+
+  if (umm_arena_owned(arena))
+    {
+      *newmem = mm_realloc(arena->heap, oldmem, size);
+      if (*newmem != NULL)
+        {
+          return true;
+        }
+    }
+
+  /* Move the block to the caller's own arena or to the user heap */
+
+  *newmem = malloc(size);
+  if (*newmem != NULL)
+    {
+      oldsize = mm_malloc_size(arena->heap, oldmem);
+      memcpy(*newmem, oldmem, oldsize < size ? oldsize : size);
+      umm_arena_free(oldmem);
+    }
+
+  return true;
+}
+
+FAR struct mm_heap_s *umm_arena_heapof(FAR void *mem)
+{
+  FAR struct umm_arena_s *arena = umm_arena_find(mem);
+
+  return arena != NULL ? arena->heap : USR_HEAP;
+}
+
+void umm_arena_mallinfo(FAR struct mallinfo *info)
+{
+  struct mallinfo arenainfo;
+  int i;
+
+  if (nxmutex_lock(&g_umm_arenalock) < 0)
+    {
+      return;
+    }
+
+  for (i = 0; i < CONFIG_MM_UMM_NARENAS; i++)
+    {
+      FAR struct umm_arena_s *arena = &g_umm_arenas[i];
+
+      if (arena->heap == NULL)
+        {
+          continue;
+        }
+
+      /* The user heap counts the arena as one block in use: replace it by
+       * the blocks of the arena and report its free memory as free.
+       */
+
+      arenainfo       = mm_mallinfo(arena->heap);
+      info->aordblks += arenainfo.aordblks - 1;
+      info->ordblks  += arenainfo.ordblks;
+      info->uordblks -= arenainfo.fordblks;
+      info->fordblks += arenainfo.fordblks;
+      if (arenainfo.mxordblk > info->mxordblk)
+        {
+          info->mxordblk = arenainfo.mxordblk;
+        }
+    }
+
+  nxmutex_unlock(&g_umm_arenalock);
+}
+
+void umm_arena_mallinfo_task(FAR const struct malltask *task,
+                             FAR struct mallinfo_task *info)
+{
+  struct mallinfo_task arenainfo;
+  int i;
+
+  if (nxmutex_lock(&g_umm_arenalock) < 0)
+    {
+      return;
+    }
+
+  for (i = 0; i < CONFIG_MM_UMM_NARENAS; i++)
+    {
+      FAR struct umm_arena_s *arena = &g_umm_arenas[i];
+
+      if (arena->heap != NULL)
+        {
+          arenainfo       = mm_mallinfo_task(arena->heap, task);
+          info->aordblks += arenainfo.aordblks;
+          info->uordblks += arenainfo.uordblks;
+        }
+    }
+
+  nxmutex_unlock(&g_umm_arenalock);
+}
+
+/****************************************************************************
+ * Name: umm_arena_release
+ *
+ * Description:
+ *   Called when a thread (or, with CONFIG_MM_UMM_ARENA_TASK, a task) exits.
+ *   Give up its arena, which returns to the user heap once no block in it
+ *   is in use.  Later allocations of the caller use the user heap.
+ *
+ ****************************************************************************/
+
+void umm_arena_release(void)
+{
+  FAR struct umm_arena_s *arena;
+  FAR void **slot = umm_arena_slot();
+
+  if (slot == NULL)
+    {
+      return;
+    }
+
+  arena = *slot;
+  *slot = &g_umm_noarena;
+  if (arena == NULL || arena == &g_umm_noarena)
+    {
+      return;
+    }
+
+  nxmutex_lock(&g_umm_arenalock);
+  arena->owner = 0;
+  umm_arena_collect(arena);
+  nxmutex_unlock(&g_umm_arenalock);
+}
+
+#endif /* CONFIG_MM_UMM_ARENA */
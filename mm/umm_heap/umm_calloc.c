@@ -28,6 +28,7 @@
 
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <nuttx/mm/mm.h>
 
@@ -71,9 +72,23 @@ FAR void *calloc(size_t n, size_t elem_size)
 
   return mem;
 #else
+  FAR void *mem;
+
+#ifdef CONFIG_MM_UMM_ARENA
+  if (elem_size == 0 || n <= (SIZE_MAX / elem_size))
+    {
+      mem = umm_arena_memalign(0, n * elem_size);
+      if (mem != NULL)
+        {
+          memset(mem, 0, n * elem_size);
+          return mem;
+        }
+    }
+#endif
+
   /* Use mm_calloc() because it implements the clear */
 
-  FAR void *mem = mm_calloc(USR_HEAP, n, elem_size);
+  mem = mm_calloc(USR_HEAP, n, elem_size);
 
   if (mem == NULL)
     {
@@ -48,5 +48,12 @@
 #undef free /* See mm/README.txt */
 void free(FAR void *mem)
 {
+#ifdef CONFIG_MM_UMM_ARENA
+  if (mem != NULL && umm_arena_free(mem))
+    {
+      return;
+    }
+#endif
+
   mm_free(USR_HEAP, mem);
 }
@@ -44,4 +44,67 @@
 void umm_try_initialize(void);
 #endif
 
+#ifdef CONFIG_MM_UMM_ARENA
+
+/****************************************************************************
+ * Name: umm_arena_memalign
+ *
+ * Description:
+ *   Allocate memory from the arena of the calling thread, creating the
+ *   arena on first use.  An alignment of zero means that of malloc().
+ *   NULL is returned if there is no arena or the memory does not fit in
+ *   it; the caller then falls back to the user heap.
+ *
+ ****************************************************************************/
+
+FAR void *umm_arena_memalign(size_t alignment, size_t size);
+
+/****************************************************************************
+ * Name: umm_arena_free
+ *
+ * Description:
+ *   Free memory that belongs to an arena.  A block of another thread's
+ *   arena is queued to that arena.  false is returned if the memory does
+ *   not belong to any arena.
+ *
+ ****************************************************************************/
+
+bool umm_arena_free(FAR void *mem);
+
+/****************************************************************************
+ * Name: umm_arena_realloc
+ *
+ * Description:
+ *   Reallocate memory that belongs to an arena, moving it if it does not
+ *   grow in place.  false is returned if oldmem does not belong to any
+ *   arena.
+ *
+ ****************************************************************************/
+
+bool umm_arena_realloc(FAR void *oldmem, size_t size, FAR void **newmem);
+
+/****************************************************************************
+ * Name: umm_arena_heapof
+ *
+ * Description:
+ *   Return the heap that mem was allocated from.
+ *
+ ****************************************************************************/
+
+FAR struct mm_heap_s *umm_arena_heapof(FAR void *mem);
+
+/****************************************************************************
+ * Name: umm_arena_mallinfo and umm_arena_mallinfo_task
+ *
+ * Description:
+ *   Add the arenas to the information of the user heap.
+ *
+ ****************************************************************************/
+
+void umm_arena_mallinfo(FAR struct mallinfo *info);
+void umm_arena_mallinfo_task(FAR const struct malltask *task,
+                             FAR struct mallinfo_task *info);
+
+#endif /* CONFIG_MM_UMM_ARENA */
+
 #endif /* __MM_UMM_HEAP_UMM_HEAP_H */
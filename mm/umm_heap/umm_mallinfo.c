@@ -47,7 +47,14 @@
 
 struct mallinfo mallinfo(void)
 {
+#ifdef CONFIG_MM_UMM_ARENA
+  struct mallinfo info = mm_mallinfo(USR_HEAP);
+
+  umm_arena_mallinfo(&info);
+  return info;
+#else
   return mm_mallinfo(USR_HEAP);
+#endif
 }
 
 /****************************************************************************
@@ -61,5 +68,12 @@ struct mallinfo mallinfo(void)
 
 struct mallinfo_task mallinfo_task(FAR const struct malltask *task)
 {
+#ifdef CONFIG_MM_UMM_ARENA
+  struct mallinfo_task info = mm_mallinfo_task(USR_HEAP, task);
+
+  umm_arena_mallinfo_task(task, &info);
+  return info;
+#else
   return mm_mallinfo_task(USR_HEAP, task);
+#endif
 }
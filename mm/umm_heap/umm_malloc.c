@@ -61,6 +61,14 @@ FAR void *malloc(size_t size)
 #else
   FAR void *ret;
 
+#ifdef CONFIG_MM_UMM_ARENA
+  ret = umm_arena_memalign(0, size);
+  if (ret != NULL)
+    {
+      return ret;
+    }
+#endif
+
   /* Use mm_malloc() because it implements the clear */
 
   ret = mm_malloc(USR_HEAP, size);
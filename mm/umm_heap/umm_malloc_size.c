@@ -39,5 +39,9 @@
 #undef malloc_size /* See mm/README.txt */
 size_t malloc_size(FAR void *mem)
 {
+#ifdef CONFIG_MM_UMM_ARENA
+  return mm_malloc_size(umm_arena_heapof(mem), mem);
+#else
   return mm_malloc_size(USR_HEAP, mem);
+#endif
 }
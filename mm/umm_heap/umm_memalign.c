@@ -90,6 +90,14 @@ FAR void *memalign(size_t alignment, size_t size)
 #else
   FAR void *ret;
 
+#ifdef CONFIG_MM_UMM_ARENA
+  ret = umm_arena_memalign(alignment, size);
+  if (ret != NULL)
+    {
+      return ret;
+    }
+#endif
+
   ret = mm_memalign(USR_HEAP, alignment, size);
   if (ret == NULL)
     {
@@ -92,6 +92,18 @@ FAR void *realloc(FAR void *oldmem, size_t size)
 #else
   FAR void *ret;
 
+#ifdef CONFIG_MM_UMM_ARENA
+  if (oldmem != NULL && umm_arena_realloc(oldmem, size, &ret))
+    {
+      if (ret == NULL && size > 0)
+        {
+          set_errno(ENOMEM);
+        }
+
+      return ret;
+    }
+#endif
+
   ret = mm_realloc(USR_HEAP, oldmem, size);
   if (ret == NULL)
     {
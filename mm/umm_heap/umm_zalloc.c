@@ -67,6 +67,15 @@ FAR void *zalloc(size_t size)
 #else
   FAR void *ret;
 
+#ifdef CONFIG_MM_UMM_ARENA
+  ret = umm_arena_memalign(0, size);
+  if (ret != NULL)
+    {
+      memset(ret, 0, size);
+      return ret;
+    }
+#endif
+
   /* Use mm_zalloc() because it implements the clear */
 
   ret = mm_zalloc(USR_HEAP, size);
@@ -58,6 +58,7 @@
 
 #include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -91,6 +92,12 @@ static dq_queue_t g_free_tcp_connections;
 
 static dq_queue_t g_active_tcp_connections;
 
+#ifdef CONFIG_NET_TCP_CONN_CACHE
+/* The cache of dynamically allocated connections */
+
+static struct mempool_cache_s g_tcp_conn_cache;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -508,8 +515,10 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 #if CONFIG_NET_TCP_ALLOC_CONNS > 0
 static FAR struct tcp_conn_s *tcp_alloc_conn(void)
 {
+#ifndef CONFIG_NET_TCP_CONN_CACHE
   FAR struct tcp_conn_s *conn;
   int i;
+#endif
 
   /* Return the entry from the head of the free list */
 
@@ -523,6 +532,9 @@ static FAR struct tcp_conn_s *tcp_alloc_conn(void)
         }
 #endif
 
+#ifdef CONFIG_NET_TCP_CONN_CACHE
+      return mempool_cache_alloc(&g_tcp_conn_cache);
+#else
       conn = kmm_zalloc(sizeof(struct tcp_conn_s) *
                         CONFIG_NET_TCP_ALLOC_CONNS);
       if (conn == NULL)
@@ -539,6 +551,7 @@ static FAR struct tcp_conn_s *tcp_alloc_conn(void)
           conn[i].tcpstateflags = TCP_CLOSED;
           dq_addlast(&conn[i].sconn.node, &g_free_tcp_connections);
         }
+#endif
     }
 
   return (FAR struct tcp_conn_s *)dq_remfirst(&g_free_tcp_connections);
@@ -661,6 +674,11 @@ void tcp_initialize(void)
       dq_addlast(&g_tcp_connections[i].sconn.node, &g_free_tcp_connections);
     }
 #endif
+
+#ifdef CONFIG_NET_TCP_CONN_CACHE
+  mempool_cache_init(&g_tcp_conn_cache, "tcp_conn",
+                     sizeof(struct tcp_conn_s), CONFIG_NET_TCP_ALLOC_CONNS);
+#endif
 }
 
 /****************************************************************************
@@ -976,17 +994,25 @@ void tcp_free(FAR struct tcp_conn_s *conn)
    * the free connections list. Else free it.
    */
 
-#if CONFIG_NET_TCP_ALLOC_CONNS == 1
-  if (conn < g_tcp_connections || conn >= (g_tcp_connections +
+#if CONFIG_NET_TCP_ALLOC_CONNS == 1 || defined(CONFIG_NET_TCP_CONN_CACHE)
+#  if CONFIG_NET_TCP_PREALLOC_CONNS > 0
+  if (conn >= g_tcp_connections && conn < (g_tcp_connections +
       CONFIG_NET_TCP_PREALLOC_CONNS))
     {
-      kmm_free(conn);
+      dq_addlast(&conn->sconn.node, &g_free_tcp_connections);
     }
   else
-#endif
+#  endif
     {
-      dq_addlast(&conn->sconn.node, &g_free_tcp_connections);
+#  ifdef CONFIG_NET_TCP_CONN_CACHE
+      mempool_cache_free(&g_tcp_conn_cache, conn);
+#  else
+      kmm_free(conn);
+#  endif
     }
+#else
+  dq_addlast(&conn->sconn.node, &g_free_tcp_connections);
+#endif
 
   net_unlock();
 }
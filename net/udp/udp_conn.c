@@ -58,6 +58,7 @@
 
 #include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
 #include <nuttx/mutex.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
@@ -93,6 +94,12 @@ static mutex_t g_free_lock = NXMUTEX_INITIALIZER;
 
 static dq_queue_t g_active_udp_connections;
 
+#ifdef CONFIG_NET_UDP_CONN_CACHE
+/* The cache of dynamically allocated connections */
+
+static struct mempool_cache_s g_udp_conn_cache;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -471,8 +478,10 @@ udp_ipv6_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 #if CONFIG_NET_UDP_ALLOC_CONNS > 0
 static FAR struct udp_conn_s *udp_alloc_conn(void)
 {
+#ifndef CONFIG_NET_UDP_CONN_CACHE
   FAR struct udp_conn_s *conn;
   int i;
+#endif
 
   /* Return the entry from the head of the free list */
 
@@ -486,6 +495,9 @@ static FAR struct udp_conn_s *udp_alloc_conn(void)
         }
 #endif
 
+#ifdef CONFIG_NET_UDP_CONN_CACHE
+      return mempool_cache_alloc(&g_udp_conn_cache);
+#else
       conn = kmm_zalloc(sizeof(struct udp_conn_s) *
                         CONFIG_NET_UDP_ALLOC_CONNS);
       if (conn == NULL)
@@ -502,6 +514,7 @@ static FAR struct udp_conn_s *udp_alloc_conn(void)
           conn[i].lport = 0;
           dq_addlast(&conn[i].sconn.node, &g_free_udp_connections);
         }
+#endif
     }
 
   return (FAR struct udp_conn_s *)dq_remfirst(&g_free_udp_connections);
@@ -604,6 +617,11 @@ void udp_initialize(void)
       dq_addlast(&g_udp_connections[i].sconn.node, &g_free_udp_connections);
     }
 #endif
+
+#ifdef CONFIG_NET_UDP_CONN_CACHE
+  mempool_cache_init(&g_udp_conn_cache, "udp_conn",
+                     sizeof(struct udp_conn_s), CONFIG_NET_UDP_ALLOC_CONNS);
+#endif
 }
 
 /****************************************************************************
@@ -634,8 +652,13 @@ FAR struct udp_conn_s *udp_alloc(uint8_t domain)
 
   if (conn)
     {
-      /* Make sure that the connection is marked as uninitialized */
+      /* Make sure that the connection is marked as uninitialized.  Objects
+       * from the connection cache come back as they were freed.
+       */
 
+#ifdef CONFIG_NET_UDP_CONN_CACHE
+      memset(conn, 0, sizeof(*conn));
+#endif
       conn->sconn.s_ttl = IP_TTL_DEFAULT;
       conn->flags       = 0;
 #if defined(CONFIG_NET_IPv4) || defined(CONFIG_NET_IPv6)
@@ -717,18 +740,27 @@ void udp_free(FAR struct udp_conn_s *conn)
    * the free connections list. Else free it.
    */
 
-#if CONFIG_NET_UDP_ALLOC_CONNS == 1
-  if (conn < g_udp_connections || conn >= (g_udp_connections +
+#if CONFIG_NET_UDP_ALLOC_CONNS == 1 || defined(CONFIG_NET_UDP_CONN_CACHE)
+#  if CONFIG_NET_UDP_PREALLOC_CONNS > 0
+  if (conn >= g_udp_connections && conn < (g_udp_connections +
       CONFIG_NET_UDP_PREALLOC_CONNS))
     {
-      kmm_free(conn);
+      memset(conn, 0, sizeof(*conn));
+      dq_addlast(&conn->sconn.node, &g_free_udp_connections);
     }
   else
-#endif
+#  endif
     {
-      memset(conn, 0, sizeof(*conn));
-      dq_addlast(&conn->sconn.node, &g_free_udp_connections);
+#  ifdef CONFIG_NET_UDP_CONN_CACHE
+      mempool_cache_free(&g_udp_conn_cache, conn);
+#  else
+      kmm_free(conn);
+#  endif
     }
+#else
+  memset(conn, 0, sizeof(*conn));
+  dq_addlast(&conn->sconn.node, &g_free_udp_connections);
+#endif
 
   nxmutex_unlock(&g_free_lock);
 }
@@ -213,6 +213,13 @@ static inline void nx_workqueues(void)
 
 #endif /* CONFIG_SCHED_LPWORK */
 
+#ifdef CONFIG_SCHED_PCPUWORK
+  /* Start the per-CPU worker threads */
+
+  work_start_pcpu();
+
+#endif /* CONFIG_SCHED_PCPUWORK */
+
 #ifdef CONFIG_LIBC_USRWORK
   /* Start the user-space work queue */
 
@@ -133,6 +133,12 @@ void irq_dispatch(int irq, FAR void *context)
   add_irq_randomness(irq);
 #endif
 
+#ifdef CONFIG_SCHED_LATENCY
+  /* Remember the entry time for the IRQ-to-thread latency */
+
+  nxsched_latency_irq();
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER
   /* Notify that we are entering into the interrupt handler */
 
@@ -0,0 +1,291 @@
+/****************************************************************************
+ * sched/mqueue/mq_batch.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <mqueue.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/mqueue.h>
+
+#include "mqueue/mqueue.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_mq_send_batch
+ *
+ * Description:
+ *   Add up to nmsgs messages to the message queue.  See
+ *   include/nuttx/mqueue.h for the full description.
+ *
+ ****************************************************************************/
+
+ssize_t file_mq_send_batch(FAR struct file *mq, FAR const char *msgs,
+                           size_t msglen, size_t nmsgs)
+{
+#ifdef CONFIG_MQ_RING
+  FAR struct mqueue_inode_s *msgq;
+#endif
+  size_t nsent;
+  int ret;
+
+  if (mq == NULL || mq->f_inode == NULL || msgs == NULL)
+    {
+      return -EINVAL;
+    }
+
+  if (nmsgs == 0)
+    {
+      return 0;
+    }
+
+#ifdef CONFIG_MQ_RING
+  msgq = mq->f_inode->i_private;
+  if (msgq->ring != NULL)
+    {
+      if (msglen != msgq->maxmsgsize)
+        {
+          return -EMSGSIZE;
+        }
+
+      return nxmq_ring_send(mq, msgs, nmsgs, NULL, -1);
+    }
+#endif
+
+  /* The first message may block, the others are only sent while the queue
+   * has room.  Each send takes its own critical section after the message
+   * has been allocated.
+   */
+
+  ret = file_mq_send(mq, msgs, msglen, 0);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (nsent = 1; nsent < nmsgs; nsent++)
+    {
+      ret = nxmq_trysend(mq, msgs + nsent * msglen, msglen, 0);
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  return nsent;
+}
+
+/****************************************************************************
+ * Name: nxmq_send_batch
+ ****************************************************************************/
+
+ssize_t nxmq_send_batch(mqd_t mqdes, FAR const char *msgs, size_t msglen,
+                        size_t nmsgs)
+{
+  FAR struct file *filep;
+  ssize_t ret;
+
+  ret = fs_getfilep(mqdes, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = file_mq_send_batch(filep, msgs, msglen, nmsgs);
+  fs_putfilep(filep);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mq_send_batch
+ *
+ * Description:
+ *   Send up to nmsgs messages of msglen bytes each, stored back to back in
+ *   msgs, to the message queue.  The call blocks (unless O_NONBLOCK is set)
+ *   only until the first message is queued.  On a MQ_RING queue the whole
+ *   batch is queued with one pass over the ring and waiting receivers are
+ *   woken once per batch.
+ *
+ * Input Parameters:
+ *   mqdes  - Message queue descriptor
+ *   msgs   - Messages to send
+ *   msglen - The length of each message in bytes
+ *   nmsgs  - The number of messages
+ *
+ * Returned Value:
+ *   The number of messages sent on success.  On failure, -1 (ERROR) is
+ *   returned and the errno is set as for mq_send().
+ *
+ ****************************************************************************/
+
+ssize_t mq_send_batch(mqd_t mqdes, FAR const char *msgs, size_t msglen,
+                      size_t nmsgs)
+{
+  ssize_t ret;
+
+  /* mq_send_batch() is a cancellation point */
+
+  enter_cancellation_point();
+
+  ret = nxmq_send_batch(mqdes, msgs, msglen, nmsgs);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: file_mq_receive_batch
+ *
+ * Description:
+ *   Receive up to nmsgs messages from the message queue.  See
+ *   include/nuttx/mqueue.h for the full description.
+ *
+ ****************************************************************************/
+
+ssize_t file_mq_receive_batch(FAR struct file *mq, FAR char *msgs,
+                              size_t msglen, size_t nmsgs)
+{
+  FAR struct mqueue_inode_s *msgq;
+  size_t nrecv;
+  ssize_t ret;
+
+  if (mq == NULL || mq->f_inode == NULL || msgs == NULL)
+    {
+      return -EINVAL;
+    }
+
+  if (nmsgs == 0)
+    {
+      return 0;
+    }
+
+  msgq = mq->f_inode->i_private;
+  if (msglen < (size_t)msgq->maxmsgsize)
+    {
+      return -EMSGSIZE;
+    }
+
+#ifdef CONFIG_MQ_RING
+  if (msgq->ring != NULL)
+    {
+      return nxmq_ring_receive(mq, msgs, msglen, nmsgs, NULL, -1);
+    }
+#endif
+
+  /* Only the first receive may block.  The length of the individual
+   * messages is not reported; callers of the batch interface on a
+   * prioritized queue are expected to use self-describing messages.
+   */
+
+  ret = file_mq_receive(mq, msgs, msglen, NULL);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (nrecv = 1; nrecv < nmsgs; nrecv++)
+    {
+      ret = nxmq_tryreceive(mq, msgs + nrecv * msglen, msglen, NULL);
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  return nrecv;
+}
+
+/****************************************************************************
+ * Name: nxmq_receive_batch
+ ****************************************************************************/
+
+ssize_t nxmq_receive_batch(mqd_t mqdes, FAR char *msgs, size_t msglen,
+                           size_t nmsgs)
+{
+  FAR struct file *filep;
+  ssize_t ret;
+
+  ret = fs_getfilep(mqdes, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = file_mq_receive_batch(filep, msgs, msglen, nmsgs);
+  fs_putfilep(filep);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mq_receive_batch
+ *
+ * Description:
+ *   Receive up to nmsgs messages into msgs, one message every msglen bytes.
+ *   The call blocks (unless O_NONBLOCK is set) only until the first message
+ *   is available.  Message priorities are not reported.
+ *
+ * Input Parameters:
+ *   mqdes  - Message queue descriptor
+ *   msgs   - Buffer to receive the messages
+ *   msglen - Size of one message buffer in bytes
+ *   nmsgs  - The number of message buffers
+ *
+ * Returned Value:
+ *   The number of messages received on success.  On failure, -1 (ERROR) is
+ *   returned and the errno is set as for mq_receive().
+ *
+ ****************************************************************************/
+
+ssize_t mq_receive_batch(mqd_t mqdes, FAR char *msgs, size_t msglen,
+                         size_t nmsgs)
+{
+  ssize_t ret;
+
+  /* mq_receive_batch() is a cancellation point */
+
+  enter_cancellation_point();
+
+  ret = nxmq_receive_batch(mqdes, msgs, msglen, nmsgs);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
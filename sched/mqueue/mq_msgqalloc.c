@@ -27,9 +27,11 @@
 #include <nuttx/config.h>
 
 #include <mqueue.h>
+#include <stddef.h>
 #include <assert.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/nuttx.h>
 #include <nuttx/sched.h>
 #include <nuttx/mqueue.h>
 
@@ -68,6 +70,12 @@ int nxmq_alloc_msgq(FAR struct mq_attr *attr,
                     FAR struct mqueue_inode_s **pmsgq)
 {
   FAR struct mqueue_inode_s *msgq;
+  size_t size = sizeof(struct mqueue_inode_s);
+#ifdef CONFIG_MQ_RING
+  FAR struct mqueue_ring_s *ring;
+  size_t slotsize = 0;
+  long i;
+#endif
 
   /* Check if the caller is attempting to allocate a message for messages
    * larger than the configured maximum message size.
@@ -79,10 +87,30 @@ int nxmq_alloc_msgq(FAR struct mq_attr *attr,
       return -EINVAL;
     }
 
+#ifdef CONFIG_MQ_RING
+  /* A ring queue needs a power of two number of non-empty slots.  The ring
+   * is allocated together with the message queue.
+   */
+
+  if (attr && (attr->mq_flags & MQ_RING) != 0)
+    {
+      if (attr->mq_maxmsg <= 0 || attr->mq_msgsize <= 0 ||
+          (attr->mq_maxmsg & (attr->mq_maxmsg - 1)) != 0)
+        {
+          return -EINVAL;
+        }
+
+      slotsize = ALIGN_UP(offsetof(struct mqueue_slot_s, data) +
+                          attr->mq_msgsize, sizeof(atomic_uint));
+      size     = ALIGN_UP(size, sizeof(atomic_uint)) +
+                 offsetof(struct mqueue_ring_s, slots) +
+                 attr->mq_maxmsg * slotsize;
+    }
+#endif
+
   /* Allocate memory for the new message queue. */
 
-  msgq = (FAR struct mqueue_inode_s *)
-    kmm_zalloc(sizeof(struct mqueue_inode_s));
+  msgq = (FAR struct mqueue_inode_s *)kmm_zalloc(size);
 
   if (msgq)
     {
@@ -104,6 +132,22 @@ int nxmq_alloc_msgq(FAR struct mq_attr *attr,
       msgq->ntpid = INVALID_PROCESS_ID;
 #endif
 
+#ifdef CONFIG_MQ_RING
+      if (slotsize > 0)
+        {
+          ring = (FAR struct mqueue_ring_s *)
+            ALIGN_UP((uintptr_t)(msgq + 1), sizeof(atomic_uint));
+          ring->slotsize = slotsize;
+
+          for (i = 0; i < attr->mq_maxmsg; i++)
+            {
+              atomic_init(&MQ_RING_SLOT(ring, i)->seq, i);
+            }
+
+          msgq->ring = ring;
+        }
+#endif
+
       dq_init(&msgq->cmn.waitfornotempty);
       dq_init(&msgq->cmn.waitfornotfull);
     }
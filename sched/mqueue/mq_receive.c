@@ -118,6 +118,10 @@ static int nxmq_verify_receive(FAR struct file *mq,
  *   msglen  - Size of the buffer in bytes
  *   prio    - If not NULL, the location to store message priority.
  *   abstime - the absolute time to wait until a timeout is declared.
+ *   ticks   - Ticks to wait from the start time until the semaphore is
+ *             posted.
+ *   nonblock - Fail with EAGAIN instead of waiting, as if O_NONBLOCK was
+ *              set.
  *
  * Returned Value:
  *   On success, the length of the selected message in bytes is returned.
@@ -138,7 +142,7 @@ static
 ssize_t file_mq_timedreceive_internal(FAR struct file *mq, FAR char *msg,
                                       size_t msglen, FAR unsigned int *prio,
                                       FAR const struct timespec *abstime,
-                                      sclock_t ticks)
+                                      sclock_t ticks, bool nonblock)
 {
   FAR struct mqueue_inode_s *msgq;
   FAR struct mqueue_msg_s *mqmsg;
@@ -173,6 +177,31 @@ ssize_t file_mq_timedreceive_internal(FAR struct file *mq, FAR char *msg,
 
   msgq = mq->f_inode->i_private;
 
+#ifdef CONFIG_MQ_RING
+  /* Ring message queues are FIFO and report every message at priority 0 */
+
+  if (msgq->ring != NULL)
+    {
+      if (msglen < (size_t)msgq->maxmsgsize)
+        {
+          return -EMSGSIZE;
+        }
+
+      ret = nxmq_ring_receive(mq, msg, msglen, 1, abstime, ticks);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      if (prio)
+        {
+          *prio = 0;
+        }
+
+      return msgq->maxmsgsize;
+    }
+#endif
+
   /* Furthermore, nxmq_wait_receive() expects to have interrupts disabled
    * because messages can be sent from interrupt level.
    */
@@ -184,7 +213,7 @@ ssize_t file_mq_timedreceive_internal(FAR struct file *mq, FAR char *msg,
   mqmsg = (FAR struct mqueue_msg_s *)list_remove_head(&msgq->msglist);
   if (mqmsg == NULL)
     {
-      if ((mq->f_oflags & O_NONBLOCK) != 0)
+      if (nonblock || (mq->f_oflags & O_NONBLOCK) != 0)
         {
           leave_critical_section(flags);
           return -EAGAIN;
@@ -280,7 +309,8 @@ ssize_t file_mq_timedreceive(FAR struct file *mq, FAR char *msg,
                              size_t msglen, FAR unsigned int *prio,
                              FAR const struct timespec *abstime)
 {
-  return file_mq_timedreceive_internal(mq, msg, msglen, prio, abstime, -1);
+  return file_mq_timedreceive_internal(mq, msg, msglen, prio,
+                                       abstime, -1, false);
 }
 
 /****************************************************************************
@@ -321,7 +351,8 @@ ssize_t file_mq_tickreceive(FAR struct file *mq, FAR char *msg,
                             size_t msglen, FAR unsigned int *prio,
                             sclock_t ticks)
 {
-  return file_mq_timedreceive_internal(mq, msg, msglen, prio, NULL, ticks);
+  return file_mq_timedreceive_internal(mq, msg, msglen, prio,
+                                       NULL, ticks, false);
 }
 
 /****************************************************************************
@@ -377,7 +408,8 @@ ssize_t nxmq_timedreceive(mqd_t mqdes, FAR char *msg, size_t msglen,
       return ret;
     }
 
-  ret = file_mq_timedreceive_internal(filep, msg, msglen, prio, abstime, -1);
+  ret = file_mq_timedreceive_internal(filep, msg, msglen, prio,
+                                      abstime, -1, false);
   fs_putfilep(filep);
   return ret;
 }
@@ -484,7 +516,35 @@ ssize_t mq_timedreceive(mqd_t mqdes, FAR char *msg, size_t msglen,
 ssize_t file_mq_receive(FAR struct file *mq, FAR char *msg, size_t msglen,
                         FAR unsigned int *prio)
 {
-  return file_mq_timedreceive_internal(mq, msg, msglen, prio, NULL, -1);
+  return file_mq_timedreceive_internal(mq, msg, msglen, prio,
+                                       NULL, -1, false);
+}
+
+/****************************************************************************
+ * Name: nxmq_tryreceive
+ *
+ * Description:
+ *   Receive a message like file_mq_receive(), but return -EAGAIN instead
+ *   of waiting if the message queue is empty.  The check and the receive
+ *   are done in one critical section.  MQ_RING queues are not supported.
+ *
+ * Input Parameters:
+ *   mq     - Message Queue Descriptor
+ *   msg    - Buffer to receive the message
+ *   msglen - Size of the buffer in bytes
+ *   prio   - If not NULL, the location to store message priority.
+ *
+ * Returned Value:
+ *   The length of the message on success; a negated errno value on
+ *   failure.
+ *
+ ****************************************************************************/
+
+ssize_t nxmq_tryreceive(FAR struct file *mq, FAR char *msg, size_t msglen,
+                        FAR unsigned int *prio)
+{
+  return file_mq_timedreceive_internal(mq, msg, msglen, prio,
+                                       NULL, -1, true);
 }
 
 /****************************************************************************
@@ -0,0 +1,515 @@
+/****************************************************************************
+ * sched/mqueue/mq_ring.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/atomic.h>
+#include <nuttx/cancelpt.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mqueue.h>
+
+#include "sched/sched.h"
+#include "mqueue/mqueue.h"
+
+#ifdef CONFIG_MQ_RING
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmq_ring_push
+ *
+ * Description:
+ *   Copy one message into the next free slot of the ring.  Multiple
+ *   producers reserve slots by advancing the head with compare-and-swap;
+ *   the slot is published to the consumers by updating its sequence
+ *   number.
+ *
+ * Returned Value:
+ *   true if the message was queued, false if the ring is full.  *wasempty
+ *   tells whether the ring was empty before this message.
+ *
+ ****************************************************************************/
+
+static bool nxmq_ring_push(FAR struct mqueue_inode_s *msgq,
+                           FAR const char *msg, FAR bool *wasempty)
+{
+  FAR struct mqueue_ring_s *ring = msgq->ring;
+  FAR struct mqueue_slot_s *slot;
+  unsigned int mask = msgq->maxmsgs - 1;
+  unsigned int pos;
+  unsigned int seq;
+
+  pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+  for (; ; )
+    {
+      slot = MQ_RING_SLOT(ring, pos & mask);
+      seq  = atomic_load_explicit(&slot->seq, memory_order_acquire);
+
+      if (seq == pos)
+        {
+          if (atomic_compare_exchange_weak_explicit(&ring->head, &pos,
+                                                    pos + 1,
+                                                    memory_order_relaxed,
+                                                    memory_order_relaxed))
+            {
+              break;
+            }
+        }
+      else if ((int)(seq - pos) < 0)
+        {
+          return false;
+        }
+      else
+        {
+          pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        }
+    }
+
+  memcpy(slot->data, msg, msgq->maxmsgsize);
+  *wasempty = atomic_load_explicit(&ring->tail, memory_order_relaxed) == pos;
+  atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+  return true;
+}
+
+/****************************************************************************
+ * Name: nxmq_ring_pop
+ *
+ * Description:
+ *   Copy the oldest message out of the ring and release its slot to the
+ *   producers.
+ *
+ * Returned Value:
+ *   true if a message was received, false if the ring is empty.  *wasfull
+ *   tells whether the ring was full before this message was removed.
+ *
+ ****************************************************************************/
+
+static bool nxmq_ring_pop(FAR struct mqueue_inode_s *msgq, FAR char *msg,
+                          FAR bool *wasfull)
+{
+  FAR struct mqueue_ring_s *ring = msgq->ring;
+  FAR struct mqueue_slot_s *slot;
+  unsigned int mask = msgq->maxmsgs - 1;
+  unsigned int pos;
+  unsigned int seq;
+
+  pos = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+  for (; ; )
+    {
+      slot = MQ_RING_SLOT(ring, pos & mask);
+      seq  = atomic_load_explicit(&slot->seq, memory_order_acquire);
+
+      if (seq == pos + 1)
+        {
+          if (atomic_compare_exchange_weak_explicit(&ring->tail, &pos,
+                                                    pos + 1,
+                                                    memory_order_relaxed,
+                                                    memory_order_relaxed))
+            {
+              break;
+            }
+        }
+      else if ((int)(seq - (pos + 1)) < 0)
+        {
+          return false;
+        }
+      else
+        {
+          pos = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        }
+    }
+
+  memcpy(msg, slot->data, msgq->maxmsgsize);
+  *wasfull = atomic_load_explicit(&ring->head, memory_order_relaxed) - pos >=
+             (unsigned int)msgq->maxmsgs;
+  atomic_store_explicit(&slot->seq, pos + msgq->maxmsgs,
+                        memory_order_release);
+  return true;
+}
+
+/****************************************************************************
+ * Name: nxmq_ring_ready
+ *
+ * Description:
+ *   Return true if the next slot can be written (send) or read (receive).
+ *   Unlike a comparison of head and tail, this does not report a slot that
+ *   has been reserved but not yet published as ready, so a waiter never
+ *   spins on a preempted producer or consumer.
+ *
+ ****************************************************************************/
+
+static bool nxmq_ring_ready(FAR struct mqueue_inode_s *msgq, bool send)
+{
+  FAR struct mqueue_ring_s *ring = msgq->ring;
+  unsigned int mask = msgq->maxmsgs - 1;
+  unsigned int pos;
+
+  if (send)
+    {
+      pos = atomic_load(&ring->head);
+      return atomic_load(&MQ_RING_SLOT(ring, pos & mask)->seq) == pos;
+    }
+  else
+    {
+      pos = atomic_load(&ring->tail);
+      return atomic_load(&MQ_RING_SLOT(ring, pos & mask)->seq) == pos + 1;
+    }
+}
+
+/****************************************************************************
+ * Name: nxmq_ring_timeout
+ *
+ * Description:
+ *   This function is called if the timeout elapses before the ring becomes
+ *   non-full (send) or non-empty (receive).
+ *
+ ****************************************************************************/
+
+static void nxmq_ring_timeout(wdparm_t arg)
+{
+  FAR struct tcb_s *wtcb = (FAR struct tcb_s *)(uintptr_t)arg;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  if (wtcb->task_state == TSTATE_WAIT_MQNOTFULL ||
+      wtcb->task_state == TSTATE_WAIT_MQNOTEMPTY)
+    {
+      nxmq_wait_irq(wtcb, ETIMEDOUT);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: nxmq_ring_wait
+ *
+ * Description:
+ *   Block until the ring is not full (send) or not empty (receive).  The
+ *   waiter count is published before the ring is checked again, pairing
+ *   with the check in nxmq_ring_notify(), so that a wakeup cannot be lost
+ *   between the failed lock-free attempt and the wait.
+ *
+ * Assumptions:
+ *   Executes within a critical section established by the caller.
+ *
+ ****************************************************************************/
+
+static int nxmq_ring_wait(FAR struct mqueue_inode_s *msgq, bool send,
+                          FAR const struct timespec *abstime,
+                          sclock_t ticks)
+{
+  FAR struct tcb_s *rtcb = this_task();
+  FAR int16_t *nwait = send ? &msgq->cmn.nwaitnotfull :
+                              &msgq->cmn.nwaitnotempty;
+
+#ifdef CONFIG_CANCELLATION_POINTS
+  if (check_cancellation_point())
+    {
+      return -ECANCELED;
+    }
+#endif
+
+  if (abstime)
+    {
+      wd_start_realtime(&rtcb->waitdog, abstime,
+                        nxmq_ring_timeout, (wdparm_t)rtcb);
+    }
+  else if (ticks >= 0)
+    {
+      wd_start(&rtcb->waitdog, ticks,
+               nxmq_ring_timeout, (wdparm_t)rtcb);
+    }
+
+  rtcb->errcode = OK;
+
+  for (; ; )
+    {
+      (*nwait)++;
+      SP_DSB();
+
+      if (nxmq_ring_ready(msgq, send))
+        {
+          (*nwait)--;
+          break;
+        }
+
+      rtcb->waitobj = msgq;
+
+      DEBUGASSERT(!is_idle_task(rtcb));
+
+      nxsched_remove_self(rtcb);
+
+      if (send)
+        {
+          rtcb->task_state = TSTATE_WAIT_MQNOTFULL;
+          nxsched_add_prioritized(rtcb, MQ_WNFLIST(msgq->cmn));
+        }
+      else
+        {
+          rtcb->task_state = TSTATE_WAIT_MQNOTEMPTY;
+          nxsched_add_prioritized(rtcb, MQ_WNELIST(msgq->cmn));
+        }
+
+      up_switch_context(this_task(), rtcb);
+
+      /* The waker removed us from the list and decremented the count */
+
+      if (rtcb->errcode != OK)
+        {
+          break;
+        }
+    }
+
+  if (abstime || ticks >= 0)
+    {
+      wd_cancel(&rtcb->waitdog);
+    }
+
+  return -rtcb->errcode;
+}
+
+/****************************************************************************
+ * Name: nxmq_ring_notify
+ *
+ * Description:
+ *   Wake up to n tasks waiting for the ring to become non-empty (after a
+ *   send) or non-full (after a receive) and signal poll waiters on the
+ *   empty/full edge.  The critical section is only entered if there is
+ *   somebody to notify.
+ *
+ ****************************************************************************/
+
+static void nxmq_ring_notify(FAR struct mqueue_inode_s *msgq, bool send,
+                             size_t n, bool edge)
+{
+  irqstate_t flags;
+  bool notify;
+
+  SP_DSB();
+
+  notify = send ? msgq->cmn.nwaitnotempty > 0 : msgq->cmn.nwaitnotfull > 0;
+#if CONFIG_FS_MQUEUE_NPOLLWAITERS > 0
+  notify |= edge;
+#endif
+#ifndef CONFIG_DISABLE_MQUEUE_NOTIFICATION
+  notify |= send && msgq->ntpid != INVALID_PROCESS_ID;
+#endif
+
+  if (!notify)
+    {
+      return;
+    }
+
+  flags = enter_critical_section();
+
+  if (edge)
+    {
+      nxmq_pollnotify(msgq, send ? POLLIN : POLLOUT);
+    }
+
+  if (send)
+    {
+      do
+        {
+          nxmq_notify_send(msgq);
+        }
+      while (--n > 0 && msgq->cmn.nwaitnotempty > 0);
+    }
+  else
+    {
+      do
+        {
+          nxmq_notify_receive(msgq);
+        }
+      while (--n > 0 && msgq->cmn.nwaitnotfull > 0);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmq_ring_send
+ *
+ * Description:
+ *   Send nmsgs messages of maxmsgsize bytes each to a MQ_RING message
+ *   queue.  Blocks (if permitted) only until the first message is queued.
+ *
+ * Input Parameters:
+ *   mq      - Message queue descriptor
+ *   msgs    - Messages to send, stored back to back
+ *   nmsgs   - The number of messages
+ *   abstime - If non-NULL, the absolute time to wait until
+ *   ticks   - If not negative, the relative time to wait
+ *
+ * Returned Value:
+ *   The number of messages sent or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t nxmq_ring_send(FAR struct file *mq, FAR const char *msgs,
+                       size_t nmsgs, FAR const struct timespec *abstime,
+                       sclock_t ticks)
+{
+  FAR struct mqueue_inode_s *msgq = mq->f_inode->i_private;
+  irqstate_t flags;
+  size_t nsent = 0;
+  bool wasempty;
+  bool edge = false;
+  int ret = OK;
+
+  while (nsent < nmsgs)
+    {
+      if (nxmq_ring_push(msgq, msgs + nsent * msgq->maxmsgsize,
+                         &wasempty))
+        {
+          edge |= wasempty;
+          nsent++;
+          continue;
+        }
+
+      /* Never block once some of the messages have been sent */
+
+      if (nsent > 0)
+        {
+          break;
+        }
+
+      if (up_interrupt_context() || (mq->f_oflags & O_NONBLOCK) != 0)
+        {
+          ret = -EAGAIN;
+          break;
+        }
+
+      flags = enter_critical_section();
+      ret = nxmq_ring_wait(msgq, true, abstime, ticks);
+      leave_critical_section(flags);
+
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  if (nsent > 0)
+    {
+      nxmq_ring_notify(msgq, true, nsent, edge);
+      return nsent;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: nxmq_ring_receive
+ *
+ * Description:
+ *   Receive up to nmsgs messages from a MQ_RING message queue into msgs,
+ *   one message every msglen bytes.  Blocks (if permitted) only until the
+ *   first message is available.
+ *
+ * Input Parameters:
+ *   mq      - Message queue descriptor
+ *   msgs    - Buffer to receive the messages
+ *   msglen  - Size of one message buffer (at least maxmsgsize)
+ *   nmsgs   - The number of message buffers
+ *   abstime - If non-NULL, the absolute time to wait until
+ *   ticks   - If not negative, the relative time to wait
+ *
+ * Returned Value:
+ *   The number of messages received or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t nxmq_ring_receive(FAR struct file *mq, FAR char *msgs,
+                          size_t msglen, size_t nmsgs,
+                          FAR const struct timespec *abstime,
+                          sclock_t ticks)
+{
+  FAR struct mqueue_inode_s *msgq = mq->f_inode->i_private;
+  irqstate_t flags;
+  size_t nrecv = 0;
+  bool wasfull;
+  bool edge = false;
+  int ret = OK;
+
+  DEBUGASSERT(msglen >= msgq->maxmsgsize);
+
+  while (nrecv < nmsgs)
+    {
+      if (nxmq_ring_pop(msgq, msgs + nrecv * msglen, &wasfull))
+        {
+          edge |= wasfull;
+          nrecv++;
+          continue;
+        }
+
+      if (nrecv > 0)
+        {
+          break;
+        }
+
+      if (up_interrupt_context() || (mq->f_oflags & O_NONBLOCK) != 0)
+        {
+          ret = -EAGAIN;
+          break;
+        }
+
+      flags = enter_critical_section();
+      ret = nxmq_ring_wait(msgq, false, abstime, ticks);
+      leave_critical_section(flags);
+
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  if (nrecv > 0)
+    {
+      nxmq_ring_notify(msgq, false, nrecv, edge);
+      return nrecv;
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_MQ_RING */
@@ -254,6 +254,8 @@ static void nxmq_add_queue(FAR struct mqueue_inode_s *msgq,
  *   abstime - the absolute time to wait until a timeout is decleared
  *   ticks   - Ticks to wait from the start time until the semaphore is
  *             posted.
+ *   nonblock - Fail with EAGAIN instead of waiting, as if O_NONBLOCK was
+ *              set.
  *
  * Returned Value:
  *   This is an internal OS interface and should not be used by applications.
@@ -275,7 +277,7 @@ static
 int file_mq_timedsend_internal(FAR struct file *mq, FAR const char *msg,
                                size_t msglen, unsigned int prio,
                                FAR const struct timespec *abstime,
-                               sclock_t ticks)
+                               sclock_t ticks, bool nonblock)
 {
   FAR struct mqueue_inode_s *msgq;
   FAR struct mqueue_msg_s *mqmsg;
@@ -306,6 +308,21 @@ int file_mq_timedsend_internal(FAR struct file *mq, FAR const char *msg,
 
   msgq = mq->f_inode->i_private;
 
+#ifdef CONFIG_MQ_RING
+  /* Ring message queues carry fixed size messages and never lock */
+
+  if (msgq->ring != NULL)
+    {
+      if (msglen != msgq->maxmsgsize)
+        {
+          return -EMSGSIZE;
+        }
+
+      ret = nxmq_ring_send(mq, msg, 1, abstime, ticks);
+      return ret < 0 ? ret : OK;
+    }
+#endif
+
   /* Pre-allocate a message structure */
 
   mqmsg = nxmq_alloc_msg(msglen);
@@ -326,7 +343,8 @@ int file_mq_timedsend_internal(FAR struct file *mq, FAR const char *msg,
     {
       /* Verify that the message is full and we can't wait */
 
-      if ((up_interrupt_context() || (mq->f_oflags & O_NONBLOCK) != 0))
+      if (up_interrupt_context() || nonblock ||
+          (mq->f_oflags & O_NONBLOCK) != 0)
         {
           ret = -EAGAIN;
           goto out;
@@ -419,7 +437,8 @@ int file_mq_timedsend(FAR struct file *mq, FAR const char *msg,
                       size_t msglen, unsigned int prio,
                       FAR const struct timespec *abstime)
 {
-  return file_mq_timedsend_internal(mq, msg, msglen, prio, abstime, -1);
+  return file_mq_timedsend_internal(mq, msg, msglen, prio,
+                                    abstime, -1, false);
 }
 
 /****************************************************************************
@@ -468,7 +487,8 @@ int file_mq_timedsend(FAR struct file *mq, FAR const char *msg,
 int file_mq_ticksend(FAR struct file *mq, FAR const char *msg,
                      size_t msglen, unsigned int prio, sclock_t ticks)
 {
-  return file_mq_timedsend_internal(mq, msg, msglen, prio, NULL, ticks);
+  return file_mq_timedsend_internal(mq, msg, msglen, prio,
+                                    NULL, ticks, false);
 }
 
 /****************************************************************************
@@ -525,7 +545,8 @@ int nxmq_timedsend(mqd_t mqdes, FAR const char *msg, size_t msglen,
       return ret;
     }
 
-  ret = file_mq_timedsend_internal(filep, msg, msglen, prio, abstime, -1);
+  ret = file_mq_timedsend_internal(filep, msg, msglen, prio,
+                                   abstime, -1, false);
   fs_putfilep(filep);
   return ret;
 }
@@ -634,7 +655,34 @@ int mq_timedsend(mqd_t mqdes, FAR const char *msg, size_t msglen,
 int file_mq_send(FAR struct file *mq, FAR const char *msg, size_t msglen,
                  unsigned int prio)
 {
-  return file_mq_timedsend_internal(mq, msg, msglen, prio, NULL, -1);
+  return file_mq_timedsend_internal(mq, msg, msglen, prio,
+                                    NULL, -1, false);
+}
+
+/****************************************************************************
+ * Name: nxmq_trysend
+ *
+ * Description:
+ *   Send a message like file_mq_send(), but return -EAGAIN instead of
+ *   waiting if the message queue is full.  The check and the send are
+ *   done in one critical section.  MQ_RING queues are not supported.
+ *
+ * Input Parameters:
+ *   mq     - Message queue descriptor
+ *   msg    - Message to send
+ *   msglen - The length of the message in bytes
+ *   prio   - The priority of the message
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxmq_trysend(FAR struct file *mq, FAR const char *msg, size_t msglen,
+                 unsigned int prio)
+{
+  return file_mq_timedsend_internal(mq, msg, msglen, prio,
+                                    NULL, -1, true);
 }
 
 /****************************************************************************
@@ -677,7 +725,8 @@ int nxmq_send(mqd_t mqdes, FAR const char *msg, size_t msglen,
       return ret;
     }
 
-  ret = file_mq_timedsend_internal(filep, msg, msglen, prio, NULL, -1);
+  ret = file_mq_timedsend_internal(filep, msg, msglen, prio,
+                                   NULL, -1, false);
   fs_putfilep(filep);
   return ret;
 }
@@ -139,6 +139,28 @@ void nxmq_notify_send(FAR struct mqueue_inode_s *msgq);
 
 void nxmq_recover(FAR struct tcb_s *tcb);
 
+/* mq_send.c ****************************************************************/
+
+int nxmq_trysend(FAR struct file *mq, FAR const char *msg, size_t msglen,
+                 unsigned int prio);
+
+/* mq_receive.c *************************************************************/
+
+ssize_t nxmq_tryreceive(FAR struct file *mq, FAR char *msg, size_t msglen,
+                        FAR unsigned int *prio);
+
+/* mq_ring.c ****************************************************************/
+
+#ifdef CONFIG_MQ_RING
+ssize_t nxmq_ring_send(FAR struct file *mq, FAR const char *msgs,
+                       size_t nmsgs, FAR const struct timespec *abstime,
+                       sclock_t ticks);
+ssize_t nxmq_ring_receive(FAR struct file *mq, FAR char *msgs,
+                          size_t msglen, size_t nmsgs,
+                          FAR const struct timespec *abstime,
+                          sclock_t ticks);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
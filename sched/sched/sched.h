@@ -422,6 +422,15 @@ void nxsched_critmon_csection(FAR struct tcb_s *tcb, bool state,
                               FAR void *caller);
 #endif
 
+/* Scheduling latency histograms */
+
+#ifdef CONFIG_SCHED_LATENCY
+void nxsched_latency_irq(void);
+void nxsched_latency_wakeup(FAR struct tcb_s *tcb);
+void nxsched_latency_suspend(FAR struct tcb_s *tcb);
+void nxsched_latency_resume(FAR struct tcb_s *tcb);
+#endif
+
 /* TCB operations */
 
 bool nxsched_verify_tcb(FAR struct tcb_s *tcb);
@@ -0,0 +1,266 @@
+/****************************************************************************
+ * sched/sched/sched_latency.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/sched.h>
+
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Bits of tcb->lat_pending */
+
+#define LATENCY_WAKEUP    (1 << SCHED_LATENCY_WAKEUP)
+#define LATENCY_RUNQUEUE  (1 << SCHED_LATENCY_RUNQUEUE)
+#define LATENCY_IRQ       (1 << SCHED_LATENCY_IRQ)
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+struct sched_latency_s
+g_sched_latency[CONFIG_SMP_NCPUS][SCHED_LATENCY_NTYPES];
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Entry time of the interrupt being dispatched on each CPU */
+
+static clock_t g_latency_irq[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_latency_add
+ *
+ * Description:
+ *   Add one sample (in microseconds) to a histogram.
+ *
+ ****************************************************************************/
+
+static void nxsched_latency_add(FAR struct sched_latency_s *latency,
+                                uint32_t usec)
+{
+  int index = usec != 0 ? fls(usec) : 0;
+
+  if (index >= SCHED_LATENCY_NBUCKETS)
+    {
+      index = SCHED_LATENCY_NBUCKETS - 1;
+    }
+
+  latency->count++;
+  latency->bucket[index]++;
+  if (usec > latency->max)
+    {
+      latency->max = usec;
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_latency_record
+ *
+ * Description:
+ *   Account one sample to the thread and to the histogram of this CPU.
+ *
+ ****************************************************************************/
+
+static void nxsched_latency_record(FAR struct tcb_s *tcb, int type,
+                                   clock_t elapsed)
+{
+  uint64_t usec = (uint64_t)elapsed * USEC_PER_SEC / perf_getfreq();
+
+  if (usec > UINT32_MAX)
+    {
+      usec = UINT32_MAX;
+    }
+
+  nxsched_latency_add(&tcb->latency[type], usec);
+  nxsched_latency_add(&g_sched_latency[this_cpu()][type], usec);
+}
+
+/****************************************************************************
+ * Name: nxsched_latency_clear
+ ****************************************************************************/
+
+static void nxsched_latency_clear(FAR struct tcb_s *tcb, FAR void *arg)
+{
+  memset(tcb->latency, 0, sizeof(tcb->latency));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_latency_irq
+ *
+ * Description:
+ *   Called by irq_dispatch() on interrupt entry.  Threads woken by the
+ *   interrupt handler measure their IRQ-to-thread latency from this time.
+ *
+ ****************************************************************************/
+
+void nxsched_latency_irq(void)
+{
+  g_latency_irq[this_cpu()] = perf_gettime();
+}
+
+/****************************************************************************
+ * Name: nxsched_latency_wakeup
+ *
+ * Description:
+ *   Called when a thread leaves a blocked state and becomes ready to run.
+ *
+ * Assumptions:
+ *   - Called within a critical section.
+ *   - Might be called from an interrupt handler
+ *
+ ****************************************************************************/
+
+void nxsched_latency_wakeup(FAR struct tcb_s *tcb)
+{
+  tcb->lat_start   = perf_gettime();
+  tcb->lat_pending = LATENCY_WAKEUP;
+
+  if (up_interrupt_context())
+    {
+      tcb->lat_irq      = g_latency_irq[this_cpu()];
+      tcb->lat_pending |= LATENCY_IRQ;
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_latency_suspend
+ *
+ * Description:
+ *   Called when a thread stops running.  A thread that is still ready to
+ *   run has been preempted and starts waiting in the ready-to-run list.
+ *
+ * Assumptions:
+ *   - Called within a critical section.
+ *   - Might be called from an interrupt handler
+ *
+ ****************************************************************************/
+
+void nxsched_latency_suspend(FAR struct tcb_s *tcb)
+{
+  if (tcb->task_state >= TSTATE_TASK_PENDING &&
+      tcb->task_state <= TSTATE_TASK_RUNNING)
+    {
+      tcb->lat_start   = perf_gettime();
+      tcb->lat_pending = LATENCY_RUNQUEUE;
+    }
+  else
+    {
+      tcb->lat_pending = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_latency_resume
+ *
+ * Description:
+ *   Called when a thread starts running; completes the pending samples.
+ *
+ * Assumptions:
+ *   - Called within a critical section.
+ *   - Might be called from an interrupt handler
+ *
+ ****************************************************************************/
+
+void nxsched_latency_resume(FAR struct tcb_s *tcb)
+{
+  clock_t current;
+
+  if (tcb->lat_pending == 0)
+    {
+      return;
+    }
+
+  current = perf_gettime();
+
+  if (tcb->lat_pending & LATENCY_WAKEUP)
+    {
+      nxsched_latency_record(tcb, SCHED_LATENCY_WAKEUP,
+                             current - tcb->lat_start);
+    }
+
+  if (tcb->lat_pending & LATENCY_RUNQUEUE)
+    {
+      nxsched_latency_record(tcb, SCHED_LATENCY_RUNQUEUE,
+                             current - tcb->lat_start);
+    }
+
+  if (tcb->lat_pending & LATENCY_IRQ)
+    {
+      nxsched_latency_record(tcb, SCHED_LATENCY_IRQ,
+                             current - tcb->lat_irq);
+    }
+
+  tcb->lat_pending = 0;
+}
+
+/****************************************************************************
+ * Name: nxsched_reset_latency
+ *
+ * Description:
+ *   Clear the scheduling latency histograms of one thread or, if tcb is
+ *   NULL, the histograms of all CPUs and all threads.
+ *
+ ****************************************************************************/
+
+void nxsched_reset_latency(FAR struct tcb_s *tcb)
+{
+  irqstate_t flags;
+
+  if (tcb != NULL)
+    {
+      flags = enter_critical_section();
+      nxsched_latency_clear(tcb, NULL);
+      leave_critical_section(flags);
+      return;
+    }
+
+  flags = enter_critical_section();
+  memset(g_sched_latency, 0, sizeof(g_sched_latency));
+  leave_critical_section(flags);
+
+  nxsched_foreach(nxsched_latency_clear, NULL);
+}
@@ -0,0 +1,501 @@
+/****************************************************************************
+ * sched/sched/sched_profstack.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/wdog.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/fs/procfs.h>
+
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PROFTICK  NSEC2TICK(NSEC_PER_SEC / CONFIG_SCHED_PROFILE_TICKSPERSEC)
+
+#define PROFSTACK_DEPTH     CONFIG_SCHED_PROFILE_STACKS_DEPTH
+#define PROFSTACK_NENTRIES  CONFIG_SCHED_PROFILE_STACKS_NENTRIES
+
+/* Output format, one line per distinct call stack in the collapsed format
+ * of the flame graph tools, outermost frame first:
+ *
+ *   # samples 1234 dropped 0 rate 1000
+ *   init-3;0x4006f2;0x401a80;0x4023c4 87
+ *   Idle_Task-0;0x400e18 1100
+ */
+
+#define PROFSTACK_LINELEN   (CONFIG_TASK_NAME_SIZE + 32 + \
+                             PROFSTACK_DEPTH * (4 + 2 * sizeof(uintptr_t)))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One distinct (thread, call stack) pair */
+
+struct profstack_entry_s
+{
+  pid_t pid;                          /* Thread that was running */
+  uint8_t depth;                      /* Number of frames, 0: unused */
+  uint32_t count;                     /* Number of samples */
+  uintptr_t stack[PROFSTACK_DEPTH];   /* Return addresses, innermost first */
+};
+
+struct profstack_s
+{
+  struct wdog_s timer;                /* Timer for sampling */
+  spinlock_t lock;                    /* Lock for this structure */
+  bool started;                       /* Samples are recorded */
+  uint32_t nsamples;                  /* Number of samples taken */
+  uint32_t ndropped;                  /* Samples that did not fit */
+  struct profstack_entry_s entry[PROFSTACK_NENTRIES];
+};
+
+/* This structure describes one open "file" */
+
+struct profstack_file_s
+{
+  struct procfs_file_s base;          /* Base open file structure */
+  char line[PROFSTACK_LINELEN];       /* Buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+static int profstack_timer_handler_cpu(FAR void *arg);
+#endif
+
+static int     profstack_open(FAR struct file *filep,
+                              FAR const char *relpath,
+                              int oflags, mode_t mode);
+static int     profstack_close(FAR struct file *filep);
+static ssize_t profstack_read(FAR struct file *filep, FAR char *buffer,
+                              size_t buflen);
+static ssize_t profstack_write(FAR struct file *filep,
+                               FAR const char *buffer, size_t buflen);
+static int     profstack_dup(FAR const struct file *oldp,
+                             FAR struct file *newp);
+static int     profstack_stat(FAR const char *relpath,
+                              FAR struct stat *buf);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct profstack_s g_profstack;
+
+#ifdef CONFIG_SMP
+static struct smp_call_data_s g_profstack_call =
+SMP_CALL_INITIALIZER(profstack_timer_handler_cpu, NULL);
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct procfs_operations g_profile_operations =
+{
+  profstack_open,   /* open */
+  profstack_close,  /* close */
+  profstack_read,   /* read */
+  profstack_write,  /* write */
+  NULL,             /* poll */
+  profstack_dup,    /* dup */
+  NULL,             /* opendir */
+  NULL,             /* closedir */
+  NULL,             /* readdir */
+  NULL,             /* rewinddir */
+  profstack_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: profstack_hash
+ ****************************************************************************/
+
+static uint32_t profstack_hash(pid_t pid, FAR void **stack, int depth)
+{
+  uint32_t hash = 2166136261u ^ (uint32_t)pid;
+  int i;
+
+  for (i = 0; i < depth; i++)
+    {
+      hash = (hash ^ (uint32_t)(uintptr_t)stack[i]) * 16777619u;
+    }
+
+  return hash;
+}
+
+/****************************************************************************
+ * Name: profstack_match
+ ****************************************************************************/
+
+static bool profstack_match(FAR struct profstack_entry_s *entry, pid_t pid,
+                            FAR void **stack, int depth)
+{
+  int i;
+
+  if (entry->pid != pid || entry->depth != depth)
+    {
+      return false;
+    }
+
+  for (i = 0; i < depth; i++)
+    {
+      if (entry->stack[i] != (uintptr_t)stack[i])
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: profstack_timer_handler_cpu
+ ****************************************************************************/
+
+static int profstack_timer_handler_cpu(FAR void *arg)
+{
+  nxsched_profile_sample();
+  return OK;
+}
+
+/****************************************************************************
+ * Name: profstack_timer_handler
+ ****************************************************************************/
+
+static void profstack_timer_handler(wdparm_t arg)
+{
+#ifdef CONFIG_SMP
+  cpu_set_t cpus = (1 << CONFIG_SMP_NCPUS) - 1;
+  CPU_CLR(this_cpu(), &cpus);
+  nxsched_smp_call_async(cpus, &g_profstack_call);
+#endif
+
+  profstack_timer_handler_cpu(NULL);
+  wd_start(&g_profstack.timer, PROFTICK, profstack_timer_handler, arg);
+}
+
+/****************************************************************************
+ * Name: profstack_line
+ *
+ * Description:
+ *   Format one call stack into the line buffer.  The backtrace is stored
+ *   innermost frame first, the collapsed format wants it outermost first.
+ *
+ ****************************************************************************/
+
+static size_t profstack_line(FAR struct profstack_file_s *procfile,
+                             FAR struct profstack_entry_s *entry)
+{
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  size_t linesize;
+  int i;
+
+  flags = enter_critical_section();
+  tcb = nxsched_get_tcb(entry->pid);
+  linesize = procfs_snprintf(procfile->line, PROFSTACK_LINELEN, "%s-%d",
+                             tcb != NULL ? get_task_name(tcb) : "<exited>",
+                             (int)entry->pid);
+  leave_critical_section(flags);
+
+  for (i = entry->depth - 1; i >= 0; i--)
+    {
+      linesize += procfs_snprintf(procfile->line + linesize,
+                                  PROFSTACK_LINELEN - linesize,
+                                  ";0x%" PRIxPTR, entry->stack[i]);
+    }
+
+  linesize += procfs_snprintf(procfile->line + linesize,
+                              PROFSTACK_LINELEN - linesize,
+                              " %" PRIu32 "\n", entry->count);
+  return linesize;
+}
+
+/****************************************************************************
+ * Name: profstack_open
+ ****************************************************************************/
+
+static int profstack_open(FAR struct file *filep, FAR const char *relpath,
+                          int oflags, mode_t mode)
+{
+  FAR struct profstack_file_s *procfile;
+
+  procfile = kmm_zalloc(sizeof(struct profstack_file_s));
+  if (procfile == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  filep->f_priv = procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: profstack_close
+ ****************************************************************************/
+
+static int profstack_close(FAR struct file *filep)
+{
+  kmm_free(filep->f_priv);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: profstack_read
+ ****************************************************************************/
+
+static ssize_t profstack_read(FAR struct file *filep, FAR char *buffer,
+                              size_t buflen)
+{
+  FAR struct profstack_s *prof = &g_profstack;
+  FAR struct profstack_file_s *procfile;
+  struct profstack_entry_s entry;
+  irqstate_t flags;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int i;
+
+  offset    = filep->f_pos;
+  procfile  = filep->f_priv;
+
+  linesize  = procfs_snprintf(procfile->line, PROFSTACK_LINELEN,
+                              "# samples %" PRIu32 " dropped %" PRIu32
+                              " rate %d\n", prof->nsamples, prof->ndropped,
+                              CONFIG_SCHED_PROFILE_TICKSPERSEC);
+  copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                            &offset);
+  totalsize = copysize;
+
+  for (i = 0; i < PROFSTACK_NENTRIES && totalsize < buflen; i++)
+    {
+      flags = spin_lock_irqsave(&prof->lock);
+      memcpy(&entry, &prof->entry[i], sizeof(entry));
+      spin_unlock_irqrestore(&prof->lock, flags);
+
+      if (entry.depth == 0)
+        {
+          continue;
+        }
+
+      linesize   = profstack_line(procfile, &entry);
+      copysize   = procfs_memcpy(procfile->line, linesize,
+                                 buffer + totalsize, buflen - totalsize,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: profstack_write
+ *
+ * Description:
+ *   "start" starts sampling, "stop" stops it and "reset" discards all the
+ *   samples taken so far.  Stop the profiler before reading the samples to
+ *   get a consistent snapshot.
+ *
+ ****************************************************************************/
+
+static ssize_t profstack_write(FAR struct file *filep,
+                               FAR const char *buffer, size_t buflen)
+{
+  FAR struct profstack_s *prof = &g_profstack;
+  irqstate_t flags;
+
+  if (buflen >= 5 && strncmp(buffer, "start", 5) == 0)
+    {
+      prof->started = true;
+      wd_start(&prof->timer, PROFTICK, profstack_timer_handler, 0);
+    }
+  else if (buflen >= 4 && strncmp(buffer, "stop", 4) == 0)
+    {
+      wd_cancel(&prof->timer);
+      prof->started = false;
+    }
+  else if (buflen >= 5 && strncmp(buffer, "reset", 5) == 0)
+    {
+      flags = spin_lock_irqsave(&prof->lock);
+      memset(prof->entry, 0, sizeof(prof->entry));
+      prof->nsamples = 0;
+      prof->ndropped = 0;
+      spin_unlock_irqrestore(&prof->lock, flags);
+    }
+  else
+    {
+      return -EINVAL;
+    }
+
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: profstack_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int profstack_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct profstack_file_s *oldattr;
+  FAR struct profstack_file_s *newattr;
+
+  oldattr = oldp->f_priv;
+  newattr = kmm_malloc(sizeof(struct profstack_file_s));
+  if (newattr == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  memcpy(newattr, oldattr, sizeof(struct profstack_file_s));
+  newp->f_priv = newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: profstack_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int profstack_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_profile_sample
+ *
+ * Description:
+ *   Record the call stack of the thread running on this CPU.  The stack is
+ *   taken with up_backtrace() on running_task() directly: this CPU is the
+ *   one running the thread, so the cross CPU path of sched_backtrace() is
+ *   never needed, and in interrupt context this_task() may already be the
+ *   thread that is about to be switched in.
+ *
+ * Assumptions:
+ *   Called from interrupt context.
+ *
+ ****************************************************************************/
+
+void nxsched_profile_sample(void)
+{
+  FAR struct profstack_s *prof = &g_profstack;
+  FAR struct profstack_entry_s *entry;
+  FAR void *stack[PROFSTACK_DEPTH];
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  uint32_t index;
+  int depth;
+  int i;
+
+  if (!prof->started)
+    {
+      return;
+    }
+
+  tcb   = running_task();
+  depth = up_backtrace(tcb, stack, PROFSTACK_DEPTH,
+                       CONFIG_SCHED_PROFILE_STACKS_SKIP);
+  if (depth <= 0)
+    {
+      stack[0] = (FAR void *)up_getusrpc(NULL);
+      depth    = 1;
+    }
+
+  index = profstack_hash(tcb->pid, stack, depth) % PROFSTACK_NENTRIES;
+
+  flags = spin_lock_irqsave(&prof->lock);
+  prof->nsamples++;
+
+  /* Open addressing with linear probing, an entry is never removed except
+   * by a reset of the whole table.
+   */
+
+  for (i = 0; i < PROFSTACK_NENTRIES; i++)
+    {
+      entry = &prof->entry[index];
+      if (entry->depth == 0)
+        {
+          entry->pid   = tcb->pid;
+          entry->depth = depth;
+          entry->count = 1;
+          memcpy(entry->stack, stack, depth * sizeof(uintptr_t));
+          break;
+        }
+      else if (profstack_match(entry, tcb->pid, stack, depth))
+        {
+          entry->count++;
+          break;
+        }
+
+      if (++index >= PROFSTACK_NENTRIES)
+        {
+          index = 0;
+        }
+    }
+
+  if (i >= PROFSTACK_NENTRIES)
+    {
+      prof->ndropped++;
+    }
+
+  spin_unlock_irqrestore(&prof->lock, flags);
+}
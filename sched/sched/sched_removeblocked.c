@@ -79,4 +79,10 @@ void nxsched_remove_blocked(FAR struct tcb_s *btcb)
    */
 
   btcb->task_state = TSTATE_TASK_INVALID;
+
+#ifdef CONFIG_SCHED_LATENCY
+  /* Start measuring the wakeup latency */
+
+  nxsched_latency_wakeup(btcb);
+#endif
 }
@@ -59,6 +59,10 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, bool sync,
    */
 
   flags = enter_critical_section();
+
+  /* Per-CPU work may live on the queue of another CPU */
+
+  wqueue = work_owner(wqueue, work);
   if (work->worker != NULL)
     {
       /* Remove the entry from the work queue and make sure that it is
@@ -0,0 +1,352 @@
+/****************************************************************************
+ * sched/wqueue/kwork_procfs.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/procfs.h>
+
+#include "wqueue/wqueue.h"
+
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Output format:
+ *
+ *   QUEUE           COUNT  MAX(us)       <1       <2 ...   <65536  >=65536
+ *   hpwork            123       87        0       12 ...        0        0
+ *
+ * All times are in microseconds.  Bucket n counts the work that waited
+ * less than 2^n microseconds.
+ */
+
+#define WQUEUE_LINELEN   (32 + 9 * WORK_LATENCY_NBUCKETS)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct wqueue_file_s
+{
+  struct procfs_file_s base;     /* Base open file structure */
+  char line[WQUEUE_LINELEN];     /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     wqueue_open(FAR struct file *filep, FAR const char *relpath,
+                           int oflags, mode_t mode);
+static int     wqueue_close(FAR struct file *filep);
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer,
+                           size_t buflen);
+static int     wqueue_dup(FAR const struct file *oldp,
+                          FAR struct file *newp);
+static int     wqueue_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct procfs_operations g_wqueue_operations =
+{
+  wqueue_open,    /* open */
+  wqueue_close,   /* close */
+  wqueue_read,    /* read */
+  NULL,           /* write */
+  NULL,           /* poll */
+  wqueue_dup,     /* dup */
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+  wqueue_stat     /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wqueue_line
+ *
+ * Description:
+ *   Format the histogram of one work queue into the line buffer.
+ *
+ ****************************************************************************/
+
+static size_t wqueue_line(FAR struct wqueue_file_s *procfile,
+                          FAR const char *name,
+                          FAR struct kwork_wqueue_s *wqueue)
+{
+  struct work_latency_s latency;
+  irqstate_t flags;
+  size_t linesize;
+  int i;
+
+  flags = enter_critical_section();
+  memcpy(&latency, &wqueue->latency, sizeof(latency));
+  leave_critical_section(flags);
+
+  linesize = procfs_snprintf(procfile->line, WQUEUE_LINELEN,
+                             "%-12s%9" PRIu32 "%9" PRIu32,
+                             name, latency.count, latency.max);
+
+  for (i = 0; i < WORK_LATENCY_NBUCKETS; i++)
+    {
+      linesize += procfs_snprintf(procfile->line + linesize,
+                                  WQUEUE_LINELEN - linesize,
+                                  "%9" PRIu32, latency.bucket[i]);
+    }
+
+  linesize += procfs_snprintf(procfile->line + linesize,
+                              WQUEUE_LINELEN - linesize, "\n");
+  return linesize;
+}
+
+/****************************************************************************
+ * Name: wqueue_header
+ ****************************************************************************/
+
+static size_t wqueue_header(FAR struct wqueue_file_s *procfile)
+{
+  size_t linesize;
+  char label[12];
+  int i;
+
+  linesize = procfs_snprintf(procfile->line, WQUEUE_LINELEN,
+                             "%-12s%9s%9s", "QUEUE", "COUNT", "MAX(us)");
+
+  for (i = 0; i < WORK_LATENCY_NBUCKETS - 1; i++)
+    {
+      snprintf(label, sizeof(label), "<%lu", 1ul << i);
+      linesize += procfs_snprintf(procfile->line + linesize,
+                                  WQUEUE_LINELEN - linesize, "%9s", label);
+    }
+
+  snprintf(label, sizeof(label), ">=%lu", 1ul << (i - 1));
+  linesize += procfs_snprintf(procfile->line + linesize,
+                              WQUEUE_LINELEN - linesize, "%9s\n", label);
+  return linesize;
+}
+
+/****************************************************************************
+ * Name: wqueue_open
+ ****************************************************************************/
+
+static int wqueue_open(FAR struct file *filep, FAR const char *relpath,
+                       int oflags, mode_t mode)
+{
+  FAR struct wqueue_file_s *procfile;
+
+  procfile = kmm_zalloc(sizeof(struct wqueue_file_s));
+  if (procfile == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  filep->f_priv = procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_close
+ ****************************************************************************/
+
+static int wqueue_close(FAR struct file *filep)
+{
+  kmm_free(filep->f_priv);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_read
+ ****************************************************************************/
+
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer,
+                           size_t buflen)
+{
+  FAR struct wqueue_file_s *procfile;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+#ifdef CONFIG_SCHED_PCPUWORK
+  char name[16];
+  int cpu;
+#endif
+
+  offset    = filep->f_pos;
+  procfile  = filep->f_priv;
+
+  linesize  = wqueue_header(procfile);
+  copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                            &offset);
+  totalsize = copysize;
+
+#ifdef CONFIG_SCHED_HPWORK
+  if (totalsize < buflen)
+    {
+      linesize   = wqueue_line(procfile, HPWORKNAME,
+                               (FAR struct kwork_wqueue_s *)&g_hpwork);
+      copysize   = procfs_memcpy(procfile->line, linesize,
+                                 buffer + totalsize, buflen - totalsize,
+                                 &offset);
+      totalsize += copysize;
+    }
+#endif
+
+#ifdef CONFIG_SCHED_LPWORK
+  if (totalsize < buflen)
+    {
+      linesize   = wqueue_line(procfile, LPWORKNAME,
+                               (FAR struct kwork_wqueue_s *)&g_lpwork);
+      copysize   = procfs_memcpy(procfile->line, linesize,
+                                 buffer + totalsize, buflen - totalsize,
+                                 &offset);
+      totalsize += copysize;
+    }
+#endif
+
+#ifdef CONFIG_SCHED_PCPUWORK
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS && totalsize < buflen; cpu++)
+    {
+      snprintf(name, sizeof(name), PCPUWORKNAME "%d", cpu);
+      linesize   = wqueue_line(procfile, name,
+                               (FAR struct kwork_wqueue_s *)&g_pcpuwork[cpu]);
+      copysize   = procfs_memcpy(procfile->line, linesize,
+                                 buffer + totalsize, buflen - totalsize,
+                                 &offset);
+      totalsize += copysize;
+    }
+#endif
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: wqueue_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int wqueue_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct wqueue_file_s *oldattr;
+  FAR struct wqueue_file_s *newattr;
+
+  oldattr = oldp->f_priv;
+  newattr = kmm_malloc(sizeof(struct wqueue_file_s));
+  if (newattr == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  memcpy(newattr, oldattr, sizeof(struct wqueue_file_s));
+  newp->f_priv = newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int wqueue_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_latency_record
+ *
+ * Description:
+ *   Account the latency of one work item that is about to be executed.
+ *   Called by the worker thread within a critical section.
+ *
+ ****************************************************************************/
+
+void work_latency_record(FAR struct kwork_wqueue_s *wqueue,
+                         FAR struct work_s *work)
+{
+  FAR struct work_latency_s *latency = &wqueue->latency;
+  struct timespec ts;
+  uint32_t usec;
+  int index;
+
+  perf_convert(perf_gettime() - work->ready, &ts);
+  if (ts.tv_sec >= UINT32_MAX / USEC_PER_SEC)
+    {
+      usec = UINT32_MAX;
+    }
+  else
+    {
+      usec = ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+    }
+
+  index = usec != 0 ? fls(usec) : 0;
+  if (index >= WORK_LATENCY_NBUCKETS)
+    {
+      index = WORK_LATENCY_NBUCKETS - 1;
+    }
+
+  latency->count++;
+  latency->bucket[index]++;
+  if (usec > latency->max)
+    {
+      latency->max = usec;
+    }
+}
+
+#endif /* CONFIG_SCHED_WORKQUEUE_LATENCY */
@@ -44,16 +44,41 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+#  define work_stamp(work) ((work)->ready = perf_gettime())
+#else
+#  define work_stamp(work)
+#endif
+
+#ifdef CONFIG_SCHED_PCPUWORK_STEAL
+#  define work_kick(wqueue) \
+     do \
+       { \
+         if (work_is_pcpu(wqueue)) \
+           { \
+             work_pcpu_kick(wqueue); \
+           } \
+       } \
+     while (0)
+#else
+#  define work_kick(wqueue)
+#endif
+
 #define queue_work(wqueue, work) \
   do \
     { \
       int sem_count; \
+      work_stamp(work); \
       dq_addlast((FAR dq_entry_t *)(work), &(wqueue)->q); \
       nxsem_get_value(&(wqueue)->sem, &sem_count); \
       if (sem_count < 0) /* There are threads waiting for sem. */ \
         { \
           nxsem_post(&(wqueue)->sem); \
         } \
+      else /* All threads are busy, let an idle CPU steal it */ \
+        { \
+          work_kick(wqueue); \
+        } \
     } \
   while (0)
 
@@ -154,7 +179,8 @@ int work_queue_wq(FAR struct kwork_wqueue_s *wqueue,
       work_cancel_wq(wqueue, work);
     }
 
-  if (work_is_canceling(wqueue->worker, wqueue->nthreads, work))
+  if (work_is_canceling(work_owner(wqueue, work)->worker,
+                        wqueue->nthreads, work))
     {
       goto out;
     }
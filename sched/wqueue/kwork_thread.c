@@ -104,10 +104,43 @@ struct lp_wqueue_s g_lpwork =
 
 #endif /* CONFIG_SCHED_LPWORK */
 
+#if defined(CONFIG_SCHED_PCPUWORK)
+/* The state of the kernel mode, per-CPU work queues. */
+
+struct pcpu_wqueue_s g_pcpuwork[CONFIG_SMP_NCPUS];
+
+#endif /* CONFIG_SCHED_PCPUWORK */
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_dequeue
+ *
+ * Description:
+ *   Remove the next ready-to-execute work from the work queue.  An idle
+ *   per-CPU worker falls back to the queues of the other CPUs.  Must be
+ *   called within a critical section.
+ *
+ ****************************************************************************/
+
+static FAR struct work_s *work_dequeue(FAR struct kwork_wqueue_s *wqueue)
+{
+  FAR struct work_s *work;
+
+  work = (FAR struct work_s *)dq_remfirst(&wqueue->q);
+
+#ifdef CONFIG_SCHED_PCPUWORK_STEAL
+  if (work == NULL && work_is_pcpu(wqueue))
+    {
+      work = work_pcpu_steal(wqueue);
+    }
+#endif
+
+  return work;
+}
+
 /****************************************************************************
  * Name: work_thread
  *
@@ -160,13 +193,17 @@ static int work_thread(int argc, FAR char *argv[])
 
       /* Remove the ready-to-execute work from the list */
 
-      while ((work = (FAR struct work_s *)dq_remfirst(&wqueue->q)) != NULL)
+      while ((work = work_dequeue(wqueue)) != NULL)
         {
           if (work->worker == NULL)
             {
               continue;
             }
 
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+          work_latency_record(wqueue, work);
+#endif
+
           /* Extract the work description from the entry (in case the work
            * instance will be re-used after it has been de-queued).
            */
@@ -494,4 +531,146 @@ int work_start_lowpri(void)
 }
 #endif /* CONFIG_SCHED_LPWORK */
 
+/****************************************************************************
+ * Name: work_start_pcpu
+ *
+ * Description:
+ *   Start the per-CPU, kernel-mode worker threads, one bound to each CPU.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Return zero (OK) on success.  A negated errno value is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_PCPUWORK
+int work_start_pcpu(void)
+{
+  FAR struct pcpu_wqueue_s *wqueue;
+  char name[CONFIG_TASK_NAME_SIZE + 1];
+  cpu_set_t cpuset;
+  int ret = OK;
+  int cpu;
+
+  sinfo("Starting per-CPU kernel worker threads\n");
+
+  /* Keep the new workers from running until they are bound to their CPU */
+
+  sched_lock();
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      wqueue = &g_pcpuwork[cpu];
+
+      dq_init(&wqueue->q);
+      nxsem_init(&wqueue->sem, 0, 0);
+      nxsem_init(&wqueue->exsem, 0, 0);
+      wqueue->nthreads = 1;
+
+      snprintf(name, sizeof(name), PCPUWORKNAME "%d", cpu);
+      ret = work_thread_create(name, CONFIG_SCHED_PCPUWORKPRIORITY, NULL,
+                               CONFIG_SCHED_PCPUWORKSTACKSIZE,
+                               (FAR struct kwork_wqueue_s *)wqueue);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      CPU_ZERO(&cpuset);
+      CPU_SET(cpu, &cpuset);
+      ret = nxsched_set_affinity(wqueue->worker[0].pid, sizeof(cpu_set_t),
+                                 &cpuset);
+      if (ret < 0)
+        {
+          serr("ERROR: Failed to bind %s: %d\n", name, ret);
+          break;
+        }
+    }
+
+  sched_unlock();
+  return ret;
+}
+#endif /* CONFIG_SCHED_PCPUWORK */
+
+/****************************************************************************
+ * Name: work_pcpu_steal
+ *
+ * Description:
+ *   Take the first pending work from the queue of another CPU.  Called by
+ *   an idle per-CPU worker within a critical section.
+ *
+ * Input Parameters:
+ *   wqueue - The work queue of the calling worker
+ *
+ * Returned Value:
+ *   The stolen work, or NULL if no other CPU has pending work.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_PCPUWORK_STEAL
+FAR struct work_s *work_pcpu_steal(FAR struct kwork_wqueue_s *wqueue)
+{
+  FAR struct work_s *work;
+  int self = (FAR struct pcpu_wqueue_s *)wqueue - g_pcpuwork;
+  int i;
+
+  /* Start with the next CPU so that the victims are spread out */
+
+  for (i = 1; i < CONFIG_SMP_NCPUS; i++)
+    {
+      FAR struct pcpu_wqueue_s *victim =
+        &g_pcpuwork[(self + i) % CONFIG_SMP_NCPUS];
+
+      work = (FAR struct work_s *)dq_remfirst(&victim->q);
+      if (work != NULL)
+        {
+          /* The work now belongs to this queue so that work_cancel_sync()
+           * waits on the right worker.
+           */
+
+          work->wq = wqueue;
+          return work;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: work_pcpu_kick
+ *
+ * Description:
+ *   Called within a critical section when work has been added to a per-CPU
+ *   queue whose worker is busy.  Wake up the worker of another CPU that is
+ *   idle so that it can steal the work.
+ *
+ * Input Parameters:
+ *   wqueue - The work queue that just received work
+ *
+ ****************************************************************************/
+
+void work_pcpu_kick(FAR struct kwork_wqueue_s *wqueue)
+{
+  int self = (FAR struct pcpu_wqueue_s *)wqueue - g_pcpuwork;
+  int semcount;
+  int i;
+
+  for (i = 1; i < CONFIG_SMP_NCPUS; i++)
+    {
+      FAR struct pcpu_wqueue_s *idle =
+        &g_pcpuwork[(self + i) % CONFIG_SMP_NCPUS];
+
+      nxsem_get_value(&idle->sem, &semcount);
+      if (semcount < 0)
+        {
+          nxsem_post(&idle->sem);
+          break;
+        }
+    }
+}
+#endif /* CONFIG_SCHED_PCPUWORK_STEAL */
+
 #endif /* CONFIG_SCHED_WORKQUEUE */
@@ -34,6 +34,7 @@
 
 #include <nuttx/clock.h>
 #include <nuttx/queue.h>
+#include <nuttx/sched.h>
 #include <nuttx/wqueue.h>
 
 #ifdef CONFIG_SCHED_WORKQUEUE
@@ -46,6 +47,14 @@
 
 #define HPWORKNAME "hpwork"
 #define LPWORKNAME "lpwork"
+#define PCPUWORKNAME "pcpuwork"
+
+/* Number of buckets in the work queue latency histogram.  Bucket n counts
+ * the work that waited less than 2^n microseconds; the last bucket counts
+ * everything else.
+ */
+
+#define WORK_LATENCY_NBUCKETS 18
 
 /****************************************************************************
  * Public Type Definitions
@@ -60,6 +69,17 @@ struct kworker_s
   sem_t             wait;      /* Sync waiting for worker done */
 };
 
+/* This structure holds the latency histogram of one work queue */
+
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+struct work_latency_s
+{
+  uint32_t          count;     /* Number of work items executed */
+  uint32_t          max;       /* Maximum latency in microseconds */
+  uint32_t          bucket[WORK_LATENCY_NBUCKETS];
+};
+#endif
+
 /* This structure defines the state of one kernel-mode work queue */
 
 struct kwork_wqueue_s
@@ -69,6 +89,9 @@ struct kwork_wqueue_s
   sem_t             exsem;     /* Sync waiting for thread exit */
   uint8_t           nthreads;  /* Number of worker threads */
   bool              exit;      /* A flag to request the thread to exit */
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+  struct work_latency_s latency; /* Queue latency histogram */
+#endif
   struct kworker_s  worker[0]; /* Describes a worker thread */
 };
 
@@ -84,6 +107,9 @@ struct hp_wqueue_s
   sem_t             exsem;     /* Sync waiting for thread exit */
   uint8_t           nthreads;  /* Number of worker threads */
   bool              exit;      /* A flag to request the thread to exit */
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+  struct work_latency_s latency; /* Queue latency histogram */
+#endif
 
   /* Describes each thread in the high priority queue's thread pool */
 
@@ -103,6 +129,9 @@ struct lp_wqueue_s
   sem_t             exsem;     /* Sync waiting for thread exit */
   uint8_t           nthreads;  /* Number of worker threads */
   bool              exit;      /* A flag to request the thread to exit */
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+  struct work_latency_s latency; /* Queue latency histogram */
+#endif
 
   /* Describes each thread in the low priority queue's thread pool */
 
@@ -110,6 +139,28 @@ struct lp_wqueue_s
 };
 #endif
 
+/* This structure defines the state of one per-CPU work queue.  This
+ * structure must be cast compatible with kwork_wqueue_s
+ */
+
+#ifdef CONFIG_SCHED_PCPUWORK
+struct pcpu_wqueue_s
+{
+  struct dq_queue_s q;         /* The queue of pending work */
+  sem_t             sem;       /* The counting semaphore of the wqueue */
+  sem_t             exsem;     /* Sync waiting for thread exit */
+  uint8_t           nthreads;  /* Number of worker threads */
+  bool              exit;      /* A flag to request the thread to exit */
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+  struct work_latency_s latency; /* Queue latency histogram */
+#endif
+
+  /* Describes the single thread bound to this CPU */
+
+  struct kworker_s  worker[1];
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -126,12 +177,25 @@ extern struct hp_wqueue_s g_hpwork;
 extern struct lp_wqueue_s g_lpwork;
 #endif
 
+#ifdef CONFIG_SCHED_PCPUWORK
+/* The state of the kernel mode, per-CPU work queues. */
+
+extern struct pcpu_wqueue_s g_pcpuwork[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
 static inline_function FAR struct kwork_wqueue_s *work_qid2wq(int qid)
 {
+#ifdef CONFIG_SCHED_PCPUWORK
+  if (qid == PCPUWORK)
+    {
+      return (FAR struct kwork_wqueue_s *)&g_pcpuwork[this_cpu()];
+    }
+  else
+#endif
 #ifdef CONFIG_SCHED_HPWORK
   if (qid == HPWORK)
     {
@@ -151,6 +215,40 @@ static inline_function FAR struct kwork_wqueue_s *work_qid2wq(int qid)
     }
 }
 
+/****************************************************************************
+ * Name: work_is_pcpu/work_owner
+ *
+ * Description:
+ *   work_is_pcpu() tells whether a work queue is one of the per-CPU queues.
+ *   work_owner() returns the work queue that currently owns the work.
+ *   Per-CPU work may have been queued by another CPU, or taken by the
+ *   worker of another CPU, so the owner is the queue recorded in the work
+ *   structure rather than the queue of the calling CPU.  Must be called
+ *   within a critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_PCPUWORK
+static inline_function bool work_is_pcpu(FAR struct kwork_wqueue_s *wqueue)
+{
+  return (FAR struct pcpu_wqueue_s *)wqueue >= &g_pcpuwork[0] &&
+         (FAR struct pcpu_wqueue_s *)wqueue < &g_pcpuwork[CONFIG_SMP_NCPUS];
+}
+
+static inline_function FAR struct kwork_wqueue_s *
+work_owner(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *work)
+{
+  if (work->wq != NULL && work_is_pcpu(wqueue) && work_is_pcpu(work->wq))
+    {
+      return work->wq;
+    }
+
+  return wqueue;
+}
+#else
+#  define work_owner(wqueue, work) (wqueue)
+#endif
+
 /****************************************************************************
  * Name: work_start_highpri
  *
@@ -189,6 +287,75 @@ int work_start_highpri(void);
 int work_start_lowpri(void);
 #endif
 
+/****************************************************************************
+ * Name: work_start_pcpu
+ *
+ * Description:
+ *   Start the per-CPU, kernel-mode worker threads, one bound to each CPU.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Return zero (OK) on success.  A negated errno value is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_PCPUWORK
+int work_start_pcpu(void);
+#endif
+
+/****************************************************************************
+ * Name: work_pcpu_steal
+ *
+ * Description:
+ *   Take the first pending work from the queue of another CPU.  Called by
+ *   an idle per-CPU worker within a critical section.
+ *
+ * Input Parameters:
+ *   wqueue - The work queue of the calling worker
+ *
+ * Returned Value:
+ *   The stolen work, or NULL if no other CPU has pending work.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_PCPUWORK_STEAL
+FAR struct work_s *work_pcpu_steal(FAR struct kwork_wqueue_s *wqueue);
+#endif
+
+/****************************************************************************
+ * Name: work_pcpu_kick
+ *
+ * Description:
+ *   Called within a critical section when work has been added to a per-CPU
+ *   queue whose worker is busy.  Wake up the worker of another CPU that is
+ *   idle so that it can steal the work.
+ *
+ * Input Parameters:
+ *   wqueue - The work queue that just received work
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_PCPUWORK_STEAL
+void work_pcpu_kick(FAR struct kwork_wqueue_s *wqueue);
+#endif
+
+/****************************************************************************
+ * Name: work_latency_record
+ *
+ * Description:
+ *   Account the latency of one work item that is about to be executed.
+ *   Called by the worker thread within a critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+void work_latency_record(FAR struct kwork_wqueue_s *wqueue,
+                         FAR struct work_s *work);
+#endif
+
 /****************************************************************************
  * Name: work_initialize_notifier
  *
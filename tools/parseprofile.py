@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+# tools/parseprofile.py
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed to the Apache Software Foundation (ASF) under one or more
+# contributor license agreements.  See the NOTICE file distributed with
+# this work for additional information regarding copyright ownership.  The
+# ASF licenses this file to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance with the
+# License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+# License for the specific language governing permissions and limitations
+# under the License.
+#
+import argparse
+import subprocess
+import sys
+
+program_description = """
+This program converts a /proc/profile dump (CONFIG_SCHED_PROFILE_STACKS)
+into collapsed stacks with function names, ready for flamegraph.pl or
+speedscope:
+
+    nsh> echo start > /proc/profile
+    ...
+    nsh> echo stop > /proc/profile
+    nsh> cat /proc/profile > /tmp/profile.txt
+
+    $ ./tools/parseprofile.py -f profile.txt -e nuttx | flamegraph.pl > out.svg
+"""
+
+
+def parse_dump(file, pids):
+    stacks = []
+    for line in file:
+        line = line.strip()
+        if line == "" or line.startswith("#"):
+            continue
+
+        frames, _, count = line.rpartition(" ")
+        frames = frames.split(";")
+        pid = frames[0].rpartition("-")[2]
+        if pids and int(pid) not in pids:
+            continue
+
+        stacks.append((frames[0], frames[1:], int(count)))
+
+    return stacks
+
+
+def addr2line(prefix, elffile, addrs):
+    symbols = {}
+    if elffile is None or addrs == []:
+        return symbols
+
+    # The addresses are return addresses, look up the call instruction
+
+    lookup = ["0x%x" % max(int(addr, 16) - 1, 0) for addr in addrs]
+    cmd = [prefix + "addr2line", "-Cfe", elffile] + lookup
+    output = subprocess.run(cmd, capture_output=True, text=True).stdout
+    lines = output.split("\n")
+    for i in range(len(addrs)):
+        func = lines[2 * i] if 2 * i < len(lines) else "??"
+        symbols[addrs[i]] = addrs[i] if func == "??" else func
+
+    return symbols
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description=program_description, formatter_class=argparse.RawTextHelpFormatter
+    )
+    parser.add_argument("-f", "--file", help="/proc/profile dump", required=True)
+    parser.add_argument("-e", "--elffile", help="elf file to resolve addresses")
+    parser.add_argument("-p", "--prefix", help="addr2line program prefix", default="")
+    parser.add_argument(
+        "--pid", help="only output these threads", type=int, nargs="+", default=[]
+    )
+    parser.add_argument(
+        "--merge", help="merge the stacks of all threads", action="store_true"
+    )
+    parser.add_argument("-o", "--output", help="output file, default output shell")
+    args = parser.parse_args()
+
+    with open(args.file, "r") as file:
+        stacks = parse_dump(file, args.pid)
+
+    addrs = sorted({addr for _, frames, _ in stacks for addr in frames})
+    symbols = addr2line(args.prefix, args.elffile, addrs)
+
+    collapsed = {}
+    for task, frames, count in stacks:
+        names = [symbols.get(addr, addr) for addr in frames]
+        if not args.merge:
+            names.insert(0, task)
+
+        key = ";".join(names)
+        collapsed[key] = collapsed.get(key, 0) + count
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    for key, count in sorted(collapsed.items()):
+        out.write("%s %d\n" % (key, count))
+
+    if args.output:
+        out.close()